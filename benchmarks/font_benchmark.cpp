@@ -0,0 +1,179 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/font.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/label.hpp"
+#include "guise/control/verticalGrid.hpp"
+#include "guise/utility/bitmap.hpp"
+#include "benchmark/benchmark.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Guise;
+
+static std::shared_ptr<Font> getBenchmarkFont()
+{
+    // Override with GUISE_BENCHMARK_FONT=<path or family>.
+    const char * font = std::getenv("GUISE_BENCHMARK_FONT");
+#if defined(GUISE_PLATFORM_WINDOWS)
+    return FontLibrary::get(font ? font : "arial");
+#else
+    return FontLibrary::get(font ? font : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
+#endif
+}
+
+static const std::wstring g_shortText = L"OK";
+static const std::wstring g_longText =
+    L"The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs. "
+    L"Sphinx of black quartz, judge my vow. How vexingly quick daft zebras jump! "
+    L"The five boxing wizards jump quickly. Jackdaws love my big sphinx of quartz.";
+
+static void maxRowScalar(benchmark::State & state)
+{
+    std::vector<uint8_t> source(static_cast<size_t>(state.range(0)), 128);
+    std::vector<uint8_t> destination(source.size(), 64);
+    for (auto _ : state)
+    {
+        Bitmap::maxRowScalar(destination.data(), source.data(), source.size());
+        benchmark::DoNotOptimize(destination.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(maxRowScalar)->Arg(16)->Arg(256)->Arg(4096);
+
+static void maxRow(benchmark::State & state)
+{
+    std::vector<uint8_t> source(static_cast<size_t>(state.range(0)), 128);
+    std::vector<uint8_t> destination(source.size(), 64);
+    for (auto _ : state)
+    {
+        Bitmap::maxRow(destination.data(), source.data(), source.size());
+        benchmark::DoNotOptimize(destination.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(maxRow)->Arg(16)->Arg(256)->Arg(4096);
+
+static void expandAlphaToRgbaScalar(benchmark::State & state)
+{
+    std::vector<uint8_t> source(static_cast<size_t>(state.range(0)), 128);
+    std::vector<uint8_t> destination(source.size() * 4);
+    for (auto _ : state)
+    {
+        Bitmap::expandAlphaToRgbaScalar(destination.data(), source.data(), source.size());
+        benchmark::DoNotOptimize(destination.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(expandAlphaToRgbaScalar)->Arg(256)->Arg(65536);
+
+static void expandAlphaToRgba(benchmark::State & state)
+{
+    std::vector<uint8_t> source(static_cast<size_t>(state.range(0)), 128);
+    std::vector<uint8_t> destination(source.size() * 4);
+    for (auto _ : state)
+    {
+        Bitmap::expandAlphaToRgba(destination.data(), source.data(), source.size());
+        benchmark::DoNotOptimize(destination.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(expandAlphaToRgba)->Arg(256)->Arg(65536);
+
+static void sequenceBitmap(benchmark::State & state, const std::wstring & text, const bool scratch)
+{
+    auto font = getBenchmarkFont();
+    if (!font->isValid())
+    {
+        state.SkipWithError("Failed to load benchmark font.");
+        return;
+    }
+
+    FontSequence sequence(font);
+    if (!sequence.createSequence(text, 13, GUISE_DEFAULT_DPI))
+    {
+        state.SkipWithError("Failed to create font sequence.");
+        return;
+    }
+
+    Vector2<size_t> size;
+    std::unique_ptr<uint8_t[]> buffer;
+    for (auto _ : state)
+    {
+        if (scratch)
+        {
+            benchmark::DoNotOptimize(sequence.createBitmapRgba(size));
+        }
+        else
+        {
+            sequence.createBitmapRgba(buffer, size);
+            benchmark::DoNotOptimize(buffer.get());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+BENCHMARK_CAPTURE(sequenceBitmap, shortLabelAllocated, g_shortText, false);
+BENCHMARK_CAPTURE(sequenceBitmap, shortLabelScratch, g_shortText, true);
+BENCHMARK_CAPTURE(sequenceBitmap, paragraphAllocated, g_longText, false);
+BENCHMARK_CAPTURE(sequenceBitmap, paragraphScratch, g_longText, true);
+
+// Update canvas with range(0) labels changing text, prepared by a pool of range(1) workers.
+static void labelUpdate(benchmark::State & state)
+{
+    const size_t labelCount = static_cast<size_t>(state.range(0));
+    ThreadPool pool(static_cast<size_t>(state.range(1)));
+
+    auto canvas = Canvas::create({ 800, 600 });
+    canvas->setThreadPool(&pool);
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto grid = VerticalGrid::create();
+    plane->add(grid);
+
+    std::vector<std::shared_ptr<Label> > labels;
+    for (size_t i = 0; i < labelCount; i++)
+    {
+        labels.push_back(Label::create());
+        grid->add(labels.back());
+    }
+
+    // Unique texts miss the text run cache, every update shapes and rasterizes all labels.
+    size_t frame = 0;
+    for (auto _ : state)
+    {
+        frame++;
+        for (size_t i = 0; i < labelCount; i++)
+        {
+            labels[i]->setText(L"Label " + std::to_wstring(i) + L" of frame " + std::to_wstring(frame));
+        }
+        canvas->update();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(labelCount));
+}
+BENCHMARK(labelUpdate)->Args({ 256, 0 })->Args({ 256, 3 })->Args({ 256, 15 })->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/signal.hpp"
+#include "benchmark/benchmark.h"
+
+using namespace Guise;
+
+// Emit cost by connection count, callbacks without dependencies.
+static void signalEmit(benchmark::State & state)
+{
+    Signal<int> signal;
+    int sum = 0;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        signal.connect([&sum](int value) { sum += value; });
+    }
+
+    for (auto _ : state)
+    {
+        signal(1);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(signalEmit)->Arg(1)->Arg(8)->Arg(64)->Arg(512);
+
+// Emit cost by connection count, each callback locks one dependency.
+static void signalEmitDependencies(benchmark::State & state)
+{
+    Signal<int> signal;
+    auto dependency = std::make_shared<int>(0);
+    int sum = 0;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        signal.connect({ dependency }, [&sum](int value) { sum += value; });
+    }
+
+    for (auto _ : state)
+    {
+        signal(1);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(signalEmitDependencies)->Arg(1)->Arg(8)->Arg(64)->Arg(512);
+
+// Connect and disconnect through a connection handle.
+static void signalConnectDisconnect(benchmark::State & state)
+{
+    Signal<int> signal;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        signal.connect([](int) {});
+    }
+
+    for (auto _ : state)
+    {
+        auto connection = signal.connect([](int) {});
+        connection.disconnect();
+    }
+}
+BENCHMARK(signalConnectDisconnect)->Arg(1)->Arg(512);
+
+BENCHMARK_MAIN();
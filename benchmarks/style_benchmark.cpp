@@ -0,0 +1,321 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/animation.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/button.hpp"
+#include "guise/control/checkbox.hpp"
+#include "guise/control/verticalGrid.hpp"
+#include "guise/plane.hpp"
+#include "benchmark/benchmark.h"
+#include <cmath>
+#include <vector>
+
+using namespace Guise;
+
+static void sheetCreateDefault(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Style::Sheet::createDefault());
+    }
+}
+BENCHMARK(sheetCreateDefault);
+
+static void sheetLoadBinary(benchmark::State & state)
+{
+    auto data = Style::Sheet::createDefault()->saveBinary();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Style::Sheet::loadBinary(data.data(), data.size()));
+    }
+}
+BENCHMARK(sheetLoadBinary);
+
+static void canvasCreate(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Canvas::create({ 800, 600 }));
+    }
+}
+BENCHMARK(canvasCreate);
+
+static void selectorGetProperty(benchmark::State & state)
+{
+    auto sheet = Style::Sheet::createDefault();
+    for (auto _ : state)
+    {
+        Style::PaintRectStyle style;
+        style.updateEmptyProperties(sheet->getSelector("button"));
+        benchmark::DoNotOptimize(style.getBackgroundColor());
+    }
+}
+BENCHMARK(selectorGetProperty);
+
+static void styleGetters(benchmark::State & state)
+{
+    Style::PaintRectStyle parent;
+    Style::PaintRectStyle hover(nullptr, &parent);
+    parent.setBackgroundColor({ 0.5f, 0.5f, 0.5f, 1.0f });
+    parent.setBorderWidth(1.0f);
+    for (auto _ : state)
+    {
+        // Same getters as OpenGLRenderer::drawRect.
+        benchmark::DoNotOptimize(hover.getBackgroundColor());
+        benchmark::DoNotOptimize(hover.getBorderStyle());
+        benchmark::DoNotOptimize(hover.getBorderWidth());
+        benchmark::DoNotOptimize(hover.getBorderColor());
+    }
+}
+BENCHMARK(styleGetters);
+
+// Control construction rate: create controls and attach them to a canvas,
+// which resolves their style sheet selectors.
+static void controlConstruction(benchmark::State & state)
+{
+    auto canvas = Canvas::create({ 800, 600 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    for (auto _ : state)
+    {
+        auto grid = VerticalGrid::create();
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            grid->add(Button::create());
+            grid->add(Checkbox::create());
+        }
+        plane->add(grid);
+        plane->remove(grid);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(controlConstruction)->Arg(64)->Arg(1024);
+
+// Allocation cost of controls, without attaching them to a canvas.
+static void controlCreate(benchmark::State & state)
+{
+    std::vector<std::shared_ptr<Button> > buttons;
+    buttons.reserve(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            buttons.push_back(Button::create());
+        }
+        buttons.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(controlCreate)->Arg(64)->Arg(10000);
+
+// Animator update rate: advance background color transitions of many controls in one pass.
+static void animatorUpdate(benchmark::State & state)
+{
+    std::vector<std::shared_ptr<Button> > buttons;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        buttons.push_back(Button::create());
+    }
+
+    Animator animator;
+    double time = 0.0;
+    for (auto _ : state)
+    {
+        if (!animator.isActive())
+        {
+            for (auto & button : buttons)
+            {
+                animator.animate(*button, static_cast<Style::PaintRectStyle &>(*button), Style::PropertyId::BackgroundColor,
+                                 Vector4f{ 1.0f, 1.0f, 1.0f, 1.0f }, 1.0);
+            }
+        }
+        time += 0.01;
+        animator.update(time);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+BENCHMARK(animatorUpdate)->Arg(256)->Arg(2500);
+
+// Child traversal: visit the childs of a grid, as rendering and resizing do every frame.
+static void childForEach(benchmark::State & state)
+{
+    auto grid = VerticalGrid::create();
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        grid->add(Button::create());
+    }
+
+    for (auto _ : state)
+    {
+        float width = 0.0f;
+        grid->forEachChild([&width](std::shared_ptr<Control> child, size_t)
+        {
+            width += child->getBounds().size.x;
+            return true;
+        });
+        benchmark::DoNotOptimize(width);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(childForEach)->Arg(64)->Arg(1024);
+
+static void childVisit(benchmark::State & state)
+{
+    auto grid = VerticalGrid::create();
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        grid->add(Button::create());
+    }
+
+    for (auto _ : state)
+    {
+        float width = 0.0f;
+        grid->visitChilds([&width](Control & child, size_t)
+        {
+            width += child.getBounds().size.x;
+        });
+        benchmark::DoNotOptimize(width);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(childVisit)->Arg(64)->Arg(1024);
+
+// Hit testing of a canvas with a grid of buttons, at points spread over the canvas.
+static void canvasHitTest(benchmark::State & state)
+{
+    auto canvas = Canvas::create({ 1000, 1000 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    const int64_t columns = static_cast<int64_t>(std::sqrt(static_cast<double>(state.range(0))));
+    const float cellSize = 1000.0f / static_cast<float>(columns);
+    std::vector<std::shared_ptr<Button> > buttons;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        auto button = Button::create();
+        plane->add(button);
+        const Vector2f position(static_cast<float>(i % columns) * cellSize, static_cast<float>(i / columns) * cellSize);
+        button->setBounds({ position, { cellSize - 1.0f, cellSize - 1.0f } });
+        buttons.push_back(button);
+    }
+
+    size_t hits = 0;
+    float position = 0.0f;
+    for (auto _ : state)
+    {
+        position = std::fmod(position + 37.3f, 1000.0f);
+        hits += canvas->queryControlHit({ position, 1000.0f - position }) != nullptr;
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(canvasHitTest)->Arg(256)->Arg(10000);
+
+// Renderer discarding all draw calls, measuring traversal only.
+class NullRenderer : public Renderer
+{
+
+public:
+
+    float getScale() const { return 1.0f; }
+    void setLevel(const size_t) { }
+    void drawRect(const Bounds2f &, const Style::PaintRectStyle &) { }
+    void drawQuad(const Bounds2f &, const Vector4f &) { }
+    void drawQuad(const Bounds2f &, const Style::LinearGradient &) { }
+    void drawQuad(const Bounds2f &, const std::shared_ptr<Texture> &, const Vector4f &) { }
+    void drawDistanceFieldQuad(const Bounds2f &, const std::shared_ptr<Texture> &, const Vector4f &) { }
+    void drawBorder(const Bounds2f &, const float, const Vector4f &) { }
+    void drawLine(const Vector2f &, const Vector2f &, const float, const Vector4f &) { }
+    void pushMask(const Bounds2i32 &) { }
+    void popMask() { }
+    std::shared_ptr<Texture> createTexture() { return nullptr; }
+    const Vector4f & getClearColor() { return m_clearColor; }
+    void setClearColor(const Vector4f & color) { m_clearColor = color; }
+    void setViewportSize(const Vector2ui32 &, const Vector2ui32 &) { }
+    void setScale(const float) { }
+    void clearColor() { }
+    void clearDepth() { }
+    void present() { }
+
+private:
+
+    Vector4f m_clearColor;
+
+};
+
+// Render a column of buttons, mostly below the bottom of the canvas.
+static void canvasRenderColumn(benchmark::State & state)
+{
+    auto canvas = Canvas::create({ 800, 600 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    std::vector<std::shared_ptr<Button> > buttons;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        auto button = Button::create();
+        plane->add(button);
+        button->setBounds({ { 0.0f, static_cast<float>(i) * 20.0f }, { 100.0f, 19.0f } });
+        buttons.push_back(button);
+    }
+
+    NullRenderer renderer;
+    for (auto _ : state)
+    {
+        canvas->render(renderer);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(canvasRenderColumn)->Arg(256)->Arg(10000);
+
+// Style memory: bytes of a button and of the style blocks allocated per button attached to a canvas.
+static void styleMemory(benchmark::State & state)
+{
+    auto canvas = Canvas::create({ 800, 600 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    const size_t blockBytes = Style::getBlockStatistics().bytes;
+    size_t attachedBlockBytes = 0;
+    for (auto _ : state)
+    {
+        auto grid = VerticalGrid::create();
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            grid->add(Button::create());
+        }
+        plane->add(grid);
+        attachedBlockBytes = Style::getBlockStatistics().bytes - blockBytes;
+        plane->remove(grid);
+    }
+    state.counters["controlBytes"] = static_cast<double>(sizeof(Button));
+    state.counters["blockBytesPerControl"] = static_cast<double>(attachedBlockBytes) / static_cast<double>(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(styleMemory)->Arg(1024);
+
+BENCHMARK_MAIN();
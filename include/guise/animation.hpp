@@ -0,0 +1,210 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_ANIMATION_HPP
+#define GUISE_ANIMATION_HPP
+
+#include "guise/build.hpp"
+#include "guise/style.hpp"
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace Guise
+{
+
+    class Control;
+
+    /**
+    * Frame clock class.
+    * Sampled once per frame, so everything updated during a frame observes the same time.
+    */
+    class GUISE_API FrameClock
+    {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        FrameClock();
+
+        /** Sample the clock, called at the start of every frame. */
+        void tick();
+
+        /** Advance to a time in seconds since the clock was created, for deterministic updates. */
+        void tick(const double time);
+
+        /** Get the time of the current frame, in seconds since the clock was created. */
+        double getTime() const;
+
+        /** Get the time in seconds between the current and previous frame. */
+        double getDeltaTime() const;
+
+        uint64_t getFrame() const;
+
+    private:
+
+        Clock::time_point   m_startTime;
+        double              m_time;
+        double              m_deltaTime;
+        uint64_t            m_frame;
+
+    };
+
+
+    /**
+    * Easing functions of tweens.
+    */
+    enum class Easing : uint8_t
+    {
+        Linear,
+        EaseIn,
+        EaseOut,
+        EaseInOut
+    };
+
+
+    /**
+    * Animator class.
+    * Interpolates float values, such as components of style properties, towards target values over time.
+    * Tweens are stored as structure of arrays and updated in a single pass without virtual calls,
+    * each control with changed values is redrawn, or resized if a layout property changed, once per update.
+    */
+    class GUISE_API Animator
+    {
+
+    public:
+
+        Animator();
+
+        /**
+        * Animate a property of a style owned by control, from its current value to target.
+        * Supported properties are listed by the getAnimatedValues functions of the styles.
+        *
+        * @return false if the property cannot be animated or target has an incompatible data type.
+        */
+        template<typename T>
+        bool animate(Control & control, T & style, const Style::PropertyId id, const Style::Property & target,
+                     const double duration, const Easing easing = Easing::EaseInOut);
+
+        /**
+        * Animate value, owned by control, from its current value to target.
+        * A running tween of the same value is replaced.
+        *
+        * @param layout Resize control when the value changes, otherwise it is only redrawn.
+        */
+        void animate(Control & control, float & value, const float target, const double duration,
+                     const Easing easing = Easing::EaseInOut, const bool layout = false);
+
+        /**
+        * Animate a component of a property of style, prepared by getAnimatedValues.
+        * The component is looked up in the current block of style on every update, tweens never point into a replaced block.
+        * Style may share its block again when its last tween ends, see Style::BlockStyle::releaseAnimatedValues.
+        */
+        void animateComponent(Control & control, Style::BlockStyle & style, const Style::PropertyId id, const size_t component,
+                              const float target, const double duration, const Easing easing = Easing::EaseInOut, const bool layout = false);
+
+        /** Stop all tweens of control, leaving the values as they are. */
+        void cancel(const Control * control);
+
+        /** Stop all tweens. */
+        void cancelAll();
+
+        /**
+        * Advance all tweens to time, in seconds of the frame clock.
+        * Finished tweens are set to their target values and removed.
+        *
+        * @return true if any tween is still running.
+        */
+        bool update(const double time);
+
+        /** Get the target of the tween animating value, or value itself if it is not animated. */
+        float getTarget(const float & value) const;
+
+        /** Get the target of the tween animating a component of a property of style, or value if it is not animated. */
+        float getTarget(const Style::BlockStyle & style, const Style::PropertyId id, const size_t component, const float value) const;
+
+        bool isActive() const;
+
+        size_t getTweenCount() const;
+
+    private:
+
+        Animator(const Animator &) = delete;
+        Animator & operator = (const Animator &) = delete;
+
+        // Tweens of style properties are identified by style and component, other tweens by the address of their value.
+        struct TweenKey
+        {
+            bool operator == (const TweenKey & key) const;
+
+            const void *    owner;
+            size_t          component;
+        };
+
+        struct TweenKeyHash
+        {
+            size_t operator()(const TweenKey & key) const;
+        };
+
+        static bool isLayoutProperty(const Style::PropertyId id);
+        static size_t getPropertyComponents(const Style::Property & property, float values[4]);
+        static TweenKey getTweenKey(const Style::BlockStyle * style, const Style::PropertyId id, const size_t component);
+
+        void addTween(Control & control, const TweenKey & key, float * value, Style::BlockStyle * style, const Style::PropertyId id,
+                      const size_t component, const float from, const float target, const double duration, const Easing easing, const bool layout);
+
+        float * getValue(const size_t index) const;
+
+        void removeTween(const size_t index);
+
+        double                                      m_time;
+
+        // Tweens, stored as structure of arrays.
+        std::vector<TweenKey>                       m_keys;
+        std::vector<float *>                        m_values;       ///< Animated value, nullptr for style tweens.
+        std::vector<float>                          m_from;
+        std::vector<float>                          m_to;
+        std::vector<double>                         m_startTimes;
+        std::vector<float>                          m_durations;
+        std::vector<Easing>                         m_easings;
+        std::vector<Control *>                      m_controls;
+        std::vector<Style::BlockStyle *>            m_styles;
+        std::vector<Style::PropertyId>              m_properties;
+        std::vector<uint8_t>                        m_components;
+        std::vector<bool>                           m_layouts;
+
+        std::unordered_map<TweenKey, size_t, TweenKeyHash> m_indices;
+        std::unordered_map<Style::BlockStyle *, size_t>    m_styleTweenCounts;
+        std::vector<std::pair<Control *, bool> >    m_changedControls;
+        std::vector<Style::BlockStyle *>            m_changedStyles;
+
+    };
+
+}
+
+#include "guise/animation.inl"
+
+#endif
@@ -0,0 +1,51 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+namespace Guise
+{
+
+    template<typename T>
+    bool Animator::animate(Control & control, T & style, const Style::PropertyId id, const Style::Property & target,
+                           const double duration, const Easing easing)
+    {
+        float targetValues[4];
+        const size_t targetCount = getPropertyComponents(target, targetValues);
+
+        float * values[4] = { nullptr, nullptr, nullptr, nullptr };
+        const size_t count = style.getAnimatedValues(id, values);
+        if (!count || count != targetCount)
+        {
+            return false;
+        }
+
+        const bool layout = isLayoutProperty(id);
+        for (size_t i = 0; i < count; i++)
+        {
+            animateComponent(control, style, id, i, targetValues[i], duration, easing, layout);
+        }
+        return true;
+    }
+
+}
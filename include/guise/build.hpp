@@ -119,6 +119,11 @@
 
 #define GUISE_DEFAULT_DPI 96
 
+// SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define GUISE_SSE2
+#endif
+
 #include <stdint.h>
 #include <stddef.h>
 #include <cstring>
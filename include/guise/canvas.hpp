@@ -27,20 +27,27 @@
 #define GUISE_CANVAS_HPP
 
 #include "guise/build.hpp"
+#include "guise/animation.hpp"
 #include "guise/signal.hpp"
 #include "guise/control.hpp"
 #include "guise/plane.hpp"
 #include "guise/renderer.hpp"
 #include "guise/style.hpp"
 #include "guise/input.hpp"
+#include "guise/utility/taskQueue.hpp"
+#include "guise/utility/threadPool.hpp"
 #include <memory>
 #include <mutex>
 #include <vector>
-#include <set>
 
 
 namespace Guise
 {
+
+    namespace Style
+    {
+        class SheetWatcher;
+    }
     
     class GUISE_API CanvasStyle  /// REMOVE ????
     {
@@ -71,21 +78,73 @@ namespace Guise
 
     public:
 
+        /** Number of drawn and culled controls of the last render. */
+        struct RenderStatistics
+        {
+            size_t drawnControls;
+            size_t culledControls;  ///< Controls of subtrees skipped for being outside of the canvas.
+        };
+
         static std::shared_ptr<Canvas> create(const Vector2ui32 & size, std::shared_ptr<Style::Sheet> * styleSheet = nullptr);
         
         ~Canvas();
 
         bool add(const std::shared_ptr<Plane> & plane, const size_t index = std::numeric_limits<size_t>::max());
 
+        /**
+        * Execute queued tasks, dispatch input and update controls.
+        * Updated controls are prepared in parallel by the thread pool, see Control::onPrepareUpdate,
+        * then updated one by one on the calling thread, in the order their updates were requested.
+        */
         void update();
 
+        /**
+        * Render all planes, subtrees of controls outside of the rendered bounds are culled.
+        * If the back buffer of render holds a previous frame, see Renderer::getBufferAge,
+        * only the damaged bounds since that frame are cleared and redrawn, scissored by the renderer.
+        */
         void render(Renderer & render);
 
+        const RenderStatistics & getRenderStatistics() const;
+
         const Input & getInput() const;
         Input & getInput();
 
         std::shared_ptr<Style::Sheet> getStyleSheet() const;
 
+        /**
+        * Replace the style sheet, restyling only controls using selectors which differ from the current sheet.
+        * Passing nullptr restores the default sheet.
+        */
+        void setStyleSheet(const std::shared_ptr<Style::Sheet> & styleSheet);
+
+        /**
+        * Load the style sheet from file and reload it whenever the file changes.
+        * The file is parsed in the background and merged over the default sheet, the result is applied by update().
+        * Passing an empty filename stops watching.
+        */
+        void watchStyleSheet(const std::string & filename);
+
+        Animator & getAnimator();
+
+        /**
+        * Get the task queue of the canvas, executed at the start of every update.
+        * Other threads push tasks or queue signal connections to it, see Signal::connectQueued.
+        * Controls resized by the tasks of an update are resized once.
+        */
+        const std::shared_ptr<TaskQueue> & getTaskQueue() const;
+
+        /**
+        * Set the pool preparing updated controls in parallel, ThreadPool::getDefault by default.
+        * Passing nullptr prepares all controls on the thread calling update.
+        */
+        void setThreadPool(ThreadPool * threadPool);
+
+        ThreadPool * getThreadPool() const;
+
+        /** Get the frame clock, sampled at the start of every update. */
+        const FrameClock & getFrameClock() const;
+
         const Vector2ui32 & getSize() const;
 
         void resize(const Vector2ui32 & size);
@@ -107,15 +166,61 @@ namespace Guise
         void reportControlChange(Control * control);
         void reportControlRemove(Control * control);
 
+        /** Report that control has been enabled, disabled or had its input enabled or disabled. */
+        void reportControlInputChange(Control * control);
+
+        /**
+        * Add bounds to the damaged region, which is cleared by render.
+        * Controls report their bounds whenever they move, resize, update or redraw.
+        */
+        void reportDamage(const Bounds2f & bounds);
+        void reportControlDamage(Control * control);
+
+        /** Check if anything has been damaged since the last call to render. */
+        bool isDamaged() const;
+
+        /**
+        * Check if a frame has to be rendered, because of damage or running animations.
+        * Render loops should skip render while this returns false.
+        */
+        bool needsRender() const;
+
+        /** Redraw control once the frame clock reaches time, e.g. for blinking cursors. */
+        void scheduleRedraw(Control * control, const double time);
+
+        /** Get the union of all damaged bounds since the last call to render, redrawn by the next render. */
+        const Bounds2f & getDamageBounds() const;
+
         void updateControl(Control * control);
 
         void resizeControl(Control * control);
 
+        /**
+        * Defer resizes of controls until the outermost batch ends, then resize each control once.
+        * Prefer StyleBatch, which ends the batch when it goes out of scope.
+        */
+        void beginStyleBatch();
+        void endStyleBatch();
+
+        /**
+        * Get the enabled, input enabled control inside the canvas at point.
+        * Controls of higher levels are hit first, then the most recently added control of a level.
+        */
+        Control * queryControlHit(const Vector2f & point) const;
+
     private:
 
+        static const size_t ParallelUpdateMinimum = 16;  ///< Fewer updated controls are prepared without waking workers.
+        static const size_t ParallelUpdateGrainSize = 4;
+        static const size_t MaxFrameDamage = 3;          ///< Older back buffers are redrawn completely.
+
         Canvas(const Vector2ui32 & size, std::shared_ptr<Style::Sheet> * styleSheet);
 
-        Control * queryControlHit(const Vector2f & point) const;
+        void removeSelectControl(Control * control);
+
+        void removeUpdateControl(Control * control);
+
+        void releaseControlReferences(Control * control);
 
         uint32_t                                    m_dpi;
         float                                       m_scale;
@@ -125,12 +230,63 @@ namespace Guise
         Control *                                   m_selectedControl;
         Vector2ui32                                 m_size;
         std::shared_ptr<Style::Sheet>               m_styleSheet;
+        std::shared_ptr<Style::SheetWatcher>        m_styleSheetWatcher;
         Control *                                   m_activeControl;
         Control *                                   m_hoveredControl;
 
-        std::map<Control *, size_t>                 m_selectControls;
-        std::map<size_t, std::vector<Control *> >   m_selectControlLevels; 
-        std::set<Control * >                        m_updateControls;
+        // Selectable controls, stored as structure of arrays and indexed by Control::m_selectIndex.
+        std::vector<Control *>                      m_selectControls;
+        std::vector<float>                          m_selectMinX;
+        std::vector<float>                          m_selectMinY;
+        std::vector<float>                          m_selectMaxX;
+        std::vector<float>                          m_selectMaxY;
+        std::vector<size_t>                         m_selectLevels;
+        std::vector<uint64_t>                       m_selectOrders;
+        std::vector<uint8_t>                        m_selectFlags;
+        uint64_t                                    m_selectOrder;
+        std::vector<Control *>                      m_updateControls;   ///< Pending updates in request order, nullptr if removed.
+        std::vector<Control *>                      m_updatingControls; ///< Updates of the running update, nullptr if done or removed.
+        ThreadPool *                                m_threadPool;
+        bool                                        m_damaged;
+        Bounds2f                                    m_damageBounds;
+        FrameClock                                  m_frameClock;
+        Animator                                    m_animator;
+        std::vector<std::pair<double, Control *> >  m_scheduledRedraws;
+        size_t                                      m_styleBatchDepth;
+        std::vector<Control *>                      m_batchedResizes;   ///< In order of the first request, nullptr if removed.
+        std::shared_ptr<TaskQueue>                  m_taskQueue;
+        Bounds2f                                    m_renderBounds;
+        std::vector<Bounds2f>                       m_frameDamage;  ///< Damaged bounds of the last rendered frames, latest first.
+        RenderStatistics                            m_renderStatistics;
+
+        friend class Control;
+
+    };
+
+
+    /**
+    * Scoped style batch.
+    * Controls of the canvas are resized once when the batch is destroyed,
+    * instead of once per layout property set within the scope.
+    */
+    class GUISE_API StyleBatch
+    {
+
+    public:
+
+        explicit StyleBatch(Canvas & canvas);
+
+        /** Batch the canvas of control, does nothing if control is not attached to a canvas. */
+        explicit StyleBatch(Control & control);
+
+        ~StyleBatch();
+
+    private:
+
+        StyleBatch(const StyleBatch &) = delete;
+        StyleBatch & operator = (const StyleBatch &) = delete;
+
+        Canvas * m_canvas;
 
     };
 
@@ -30,54 +30,133 @@
 #include "guise/renderer.hpp"
 #include "guise/appWindow.hpp"
 #include "guise/utility/semaphore.hpp"
+#include "guise/utility/taskQueue.hpp"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <set>
 #include <chrono>
+#include <mutex>
+#include <vector>
 
 namespace Guise
 {
 
     /**
     * Context class.
-    *
-    *
+    * Creates app windows and drives their update and render loops.
     */
     class GUISE_API Context
     {
 
     public:
-        
+
+        /**
+        * Threads driving the loops of app windows.
+        */
+        enum class Threading
+        {
+            ThreadPerWindow,    ///< Every app window is updated and rendered by a thread of its own.
+            SingleThread        ///< All app windows are updated and rendered by one loop thread, waiting for events of all of them.
+        };
+
+        /** Stop the loops of all app windows and join their threads. */
         ~Context();
               
-        static std::shared_ptr<Context> create();
+        static std::shared_ptr<Context> create(const Threading threading = Threading::ThreadPerWindow);
         
+        /**
+        * Create an app window, driven by the threads of this context.
+        * May be called by any thread, including threads of this context, e.g. from a signal of another app window.
+        * The loop thread of a single threaded context creates the window right away, other threads wait for their window
+        * without blocking the context.
+        *
+        * @return The created app window, nullptr if the context is stopped.
+        */
         std::shared_ptr<AppWindow> addAppWindow(const std::wstring & title = L"", const Vector2ui32 & size = { 0, 0 });
 
+        /** Set the minimum time between updates of app windows without a frame time of their own. */
         void setMaxFrameTime(const std::chrono::duration<double> & frameTime);
 
+        /**
+        * Set the minimum time between updates of app window, overriding the max frame time of the context.
+        * Passing zero restores the max frame time of the context.
+        */
+        void setMaxFrameTime(const std::shared_ptr<AppWindow> & appWindow, const std::chrono::duration<double> & frameTime);
+
         std::chrono::duration<double> getMaxFrameTime() const;
 
+        Threading getThreading() const;
+
+        /**
+        * Let renderers of app windows added from now on share textures, such as text runs,
+        * with the renderer of the first sharing app window. Textures are then uploaded once for all windows,
+        * by the thread of the window rendering them first. Enabled by default.
+        */
+        void setResourceSharing(const bool share);
+
+        bool isResourceSharing() const;
+
+        /**
+        * Stop updating app windows and join the threads of this context, app windows cannot be added afterwards.
+        * Must not be called by a thread of this context, e.g. from a signal of an app window.
+        */
+        void stop();
+
         static bool setDpiAware();
 
     private:
 
-        Context();
+        using FrameClock = std::chrono::steady_clock;
+
+        Context(const Threading threading);
 
         Context(const Context &) = delete;
 
         struct AppWindowData
         {
+            AppWindowData();
+
             std::thread m_thread;
             std::shared_ptr<AppWindow> appWindow;
+            std::shared_ptr<Renderer> renderer;
+            std::atomic<std::chrono::duration<double>> maxFrameTime; ///< Zero for the max frame time of the context.
+            FrameClock::time_point nextFrame; ///< Used by the loop thread only.
         };
 
-        std::set<std::shared_ptr<AppWindowData> >   m_appWindows;
-        std::shared_ptr<Renderer>                   m_renderer;
-        std::atomic<std::chrono::duration<double>>  m_maxFrameTime;
+        void createAppWindow(AppWindowData & appWindowData, const std::wstring & title, const Vector2ui32 & size);
+        void createLoopWindow(const std::shared_ptr<AppWindowData> & appWindowData, const std::wstring & title, const Vector2ui32 & size);
+        void updateAppWindow(AppWindowData & appWindowData);
+        std::chrono::duration<double> getFrameTime(const AppWindowData & appWindowData) const;
+
+        void runLoop();
+        void waitForEvents(const FrameClock::time_point & deadline);
+
+        /** Interrupt waitForEvents of the loop thread, safe to call from any thread. */
+        void wakeLoop();
+
+        const Threading                                     m_threading;
+        std::mutex                                          m_mutex;
+        std::atomic<bool>                                   m_running;
+        std::set<std::shared_ptr<AppWindowData> >           m_appWindows;
+        std::shared_ptr<Renderer>                           m_renderer;
+        std::atomic<std::chrono::duration<double>>          m_maxFrameTime;
+        std::atomic<bool>                                   m_resourceSharing;
+        std::mutex                                          m_shareMutex;
+        std::shared_ptr<Renderer>                           m_shareRenderer; ///< Renderer shared with by new renderers.
+
+        // Single threaded loop.
+        std::thread                                         m_loopThread;
+        TaskQueue                                           m_loopTasks;
+        std::vector<std::shared_ptr<AppWindowData> >        m_loopWindows; ///< Used by the loop thread only.
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        HANDLE                                              m_wakeEvent;
+    #elif defined(GUISE_PLATFORM_LINUX)
+        int                                                 m_wakeFd;      ///< Event file descriptor, polled by the loop thread.
+    #endif
+
     };
 
 }
 
-#endif
\ No newline at end of file
+#endif
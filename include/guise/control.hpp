@@ -31,11 +31,13 @@
 #include "guise/renderer.hpp"
 #include "guise/input.hpp"
 #include "guise/math/bounds.hpp"
+#include "guise/utility/controlPool.hpp"
+#include <functional>
 #include <memory>
 #include <vector>
 #include <list>
 #include <limits>
-#include <mutex>
+#include <type_traits>
 
 namespace Guise
 {
@@ -103,7 +105,11 @@ namespace Guise
         virtual void hide(const bool occupySpace = false);
         virtual bool isVisible() const;
 
-        virtual bool intersects(const Vector2f & point) const;
+        /**
+        * Check if point is within getSelectBounds of this enabled, input enabled control.
+        * Same test as Canvas::queryControlHit, which reads the select bounds mirrored by the canvas instead of calling this.
+        */
+        bool intersects(const Vector2f & point) const;
 
         virtual size_t getLevel() const;
         virtual void setLevel(const size_t level);
@@ -120,6 +126,22 @@ namespace Guise
         virtual void forEachChild(size_t position, size_t count, std::function<bool(std::shared_ptr<Control>, size_t)> callback);
         virtual void forEachChild(size_t position, size_t count, std::function<bool(std::shared_ptr<const Control>, size_t)> callback) const;
 
+        /**
+        * Visit childs by reference, without reference counting or indirect calls per child.
+        * Visitor is called as visitor(child, index) and stops the visit by returning false, if it returns bool.
+        * Childs must not be added or removed while visiting.
+        */
+        template<typename F>
+        void visitChilds(F && visitor);
+        template<typename F>
+        void visitChilds(F && visitor) const;
+
+        /** Visit count childs, starting at position. Indices passed to visitor are the indices of the childs. */
+        template<typename F>
+        void visitChilds(const size_t position, const size_t count, F && visitor);
+        template<typename F>
+        void visitChilds(const size_t position, const size_t count, F && visitor) const;
+
         virtual bool add(const std::shared_ptr<Control> & control, const size_t index = std::numeric_limits<size_t>::max());
         virtual bool remove(Control & control);
         virtual bool remove(const std::shared_ptr<Control> & control);
@@ -136,10 +158,24 @@ namespace Guise
 
         const Bounds2f & setBounds(const Bounds2f & bounds);
 
+        /**
+        * Get the union of the bounds of this control and all of its descendants.
+        * Cached, calculated again after bounds in the subtree change or childs are added or removed.
+        */
+        const Bounds2f & getSubtreeBounds();
+
+        /** Get the number of controls in the subtree, including this control. */
+        size_t getSubtreeSize();
+
         float getScale() const;
 
         void resize();
 
+        /**
+        * Report the bounds of this control as damaged, requesting it to be rendered again without updating the layout.
+        */
+        void redraw();
+
         bool isChildBoundsAware() const;
         void setChildBoundsAware(const bool aware);
 
@@ -147,6 +183,16 @@ namespace Guise
 
     protected:
 
+        /** Contiguous array of childs. */
+        struct ChildArray
+        {
+            const std::shared_ptr<Control> *    childs;
+            size_t                              count;
+        };
+
+        /** Get the childs visited by visitChilds, empty for controls without childs. */
+        virtual ChildArray getChildArray() const;
+
         virtual void onAddChild(Control & control, const size_t index);
 
         virtual void onCanvasChange(Canvas * canvas);
@@ -161,6 +207,20 @@ namespace Guise
 
         virtual void onResize();
 
+        /**
+        * Called when the style sheet of the canvas is replaced.
+        * Controls using any of the changed selectors should reset and reapply their sheet properties.
+        */
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
+        /**
+        * Called by update of the canvas before onUpdate, possibly in parallel with other updated controls
+        * on threads of the thread pool. Perform expensive work here, e.g. shaping text,
+        * modifying this control only. Resizing, updating or adding controls is done in onUpdate.
+        */
+        virtual void onPrepareUpdate();
+
+        /** Called by update of the canvas on the updating thread, after update() was called. */
         virtual void onUpdate();
 
         Bounds2f scale(const Bounds2f & bounds) const;
@@ -172,13 +232,25 @@ namespace Guise
 
     private:
 
+        static const size_t InvalidSelectIndex = std::numeric_limits<size_t>::max();
+        static const size_t InvalidUpdateIndex = std::numeric_limits<size_t>::max();
+        static const size_t InvalidResizeIndex = std::numeric_limits<size_t>::max();
+
         virtual void setCanvas(Canvas * canvas);
 
+        /** Invalidate the cached subtree bounds of this control and its ancestors. */
+        void invalidateSubtree();
+
         Bounds2f                m_availableBounds;
         Bounds2f                m_bounds;
+        Bounds2f                m_subtreeBounds;
+        size_t                  m_subtreeSize;
         Canvas *                m_canvas;
         uint8_t                 m_flags;
         size_t                  m_level;
+        size_t                  m_selectIndex;  ///< Index in the selectable controls of the canvas.
+        size_t                  m_updateIndex;  ///< Index in the pending or updating controls of the canvas.
+        size_t                  m_resizeIndex;  ///< Index in the batched resizes of the canvas.
         std::weak_ptr<Control>  m_parent;
 
         friend class Canvas;
@@ -186,6 +258,11 @@ namespace Guise
 
     };
 
+    /**
+    * Control container base class.
+    * Childs are not synchronized, they are added, removed and visited by the thread updating the canvas.
+    * Other threads modify controls through tasks, see Canvas::getTaskQueue.
+    */
     class GUISE_API ControlContainer : public Control
     {
 
@@ -233,12 +310,13 @@ namespace Guise
     
     protected:
 
+        ChildArray getChildArray() const;
+
         virtual void setCanvas(Canvas * canvas);
 
     private:
 
         std::shared_ptr<Control>    m_child;
-        mutable std::mutex          m_mutex;
 
     };
 
@@ -271,12 +349,13 @@ namespace Guise
 
     protected:
 
+        ChildArray getChildArray() const;
+
         virtual void setCanvas(Canvas * canvas);
 
     private:
 
         std::vector<std::shared_ptr<Control> >  m_childs;
-        mutable std::mutex                      m_mutex;
 
     };
 
@@ -286,4 +365,6 @@ namespace Guise
 
 }
 
+#include "guise/control.inl"
+
 #endif
\ No newline at end of file
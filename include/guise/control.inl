@@ -0,0 +1,97 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include <algorithm>
+
+namespace Guise
+{
+
+    template<typename F>
+    inline void Control::visitChilds(F && visitor)
+    {
+        visitChilds(0, std::numeric_limits<size_t>::max(), std::forward<F>(visitor));
+    }
+
+    template<typename F>
+    inline void Control::visitChilds(F && visitor) const
+    {
+        visitChilds(0, std::numeric_limits<size_t>::max(), std::forward<F>(visitor));
+    }
+
+    template<typename F>
+    inline void Control::visitChilds(const size_t position, const size_t count, F && visitor)
+    {
+        const ChildArray childArray = getChildArray();
+        if (position >= childArray.count)
+        {
+            return;
+        }
+
+        const size_t end = position + std::min(count, childArray.count - position);
+        for (size_t i = position; i < end; i++)
+        {
+            Control & child = *childArray.childs[i];
+            if constexpr (std::is_same<decltype(visitor(child, i)), bool>::value)
+            {
+                if (!visitor(child, i))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                visitor(child, i);
+            }
+        }
+    }
+
+    template<typename F>
+    inline void Control::visitChilds(const size_t position, const size_t count, F && visitor) const
+    {
+        const ChildArray childArray = getChildArray();
+        if (position >= childArray.count)
+        {
+            return;
+        }
+
+        const size_t end = position + std::min(count, childArray.count - position);
+        for (size_t i = position; i < end; i++)
+        {
+            const Control & child = *childArray.childs[i];
+            if constexpr (std::is_same<decltype(visitor(child, i)), bool>::value)
+            {
+                if (!visitor(child, i))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                visitor(child, i);
+            }
+        }
+    }
+
+}
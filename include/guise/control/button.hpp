@@ -77,6 +77,8 @@ namespace Guise
 
         virtual void onResize();
 
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
         bool                            m_pressed;
         Style::ParentPaintRectStyle     m_styleActive;
         Style::ParentPaintRectStyle     m_styleDisabled;
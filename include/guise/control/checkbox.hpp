@@ -78,6 +78,8 @@ namespace Guise
 
         virtual void onResize();
 
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
         bool                    m_checked;
         Style::PaintRectStyle   m_styleChecked;
         Style::PaintRectStyle   m_styleCheckedHover;
@@ -28,6 +28,7 @@
 
 #include "guise/control.hpp"
 #include "guise/font.hpp"
+#include "guise/signal.hpp"
 
 namespace Guise
 {
@@ -50,6 +51,22 @@ namespace Guise
 
         void setText(const std::wstring & text); 
 
+        bool getDistanceField() const;
+
+        /**
+        * Render text from a distance field, rasterized once per font and shared by all sizes.
+        * Font size and dpi changes only rescale the label. Not combined with word wrapping.
+        */
+        void setDistanceField(const bool distanceField);
+
+        bool getWordWrap() const;
+
+        /**
+        * Wrap text to the width given to the label by its parent.
+        * Wrapped labels re-layout incrementally on width changes, without re-shaping the text.
+        */
+        void setWordWrap(const bool wordWrap);
+
         Signal<const std::wstring &> onChange;
 
     protected:
@@ -63,20 +80,40 @@ namespace Guise
 
         virtual void onCanvasChange(Canvas * canvas);
 
+        /**
+        * Shape and rasterize changed text, possibly in parallel with other labels.
+        * Replaced text runs and textures are kept until onUpdate, textures are deleted by the thread of the renderer.
+        */
+        virtual void onPrepareUpdate();
+
         virtual void onRender(RendererInterface & rendererInterface);
 
         virtual void onResize();
 
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
         virtual void onUpdate();
 
+        int32_t getWrapWidth() const;
+
+        void updateLayoutBitmap();
+
+        bool                        m_changedLayout;
         bool                        m_changedText;
+        bool                        m_distanceField;
         int32_t                     m_dpi;
+        ScopedConnection            m_dpiConnection;
         std::shared_ptr<Font>       m_font;
-        FontSequence                m_fontSequence;
-        std::unique_ptr<uint8_t[]>  m_loadData;      
+        TextLayout                  m_layout;
+        const uint8_t *             m_layoutData; ///< Owned by m_layout.
+        Vector2<size_t>             m_layoutSize;
+        std::shared_ptr<Texture>    m_layoutTexture;
+        bool                        m_preparedText;
+        std::shared_ptr<Texture>    m_releasedLayoutTexture;    ///< Replaced by onPrepareUpdate, released by onUpdate.
+        std::shared_ptr<TextRun>    m_releasedTextRun;          ///< Replaced by onPrepareUpdate, released by onUpdate.
         std::wstring                m_text;
-        std::shared_ptr<Texture>    m_texture;
-        Vector2<size_t>             m_textureSize;
+        std::shared_ptr<TextRun>    m_textRun;
+        bool                        m_wordWrap;
 
     };
 
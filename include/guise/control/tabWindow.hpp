@@ -63,6 +63,8 @@ namespace Guise
 
         virtual void onResize();
 
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
         Style::ParentPaintRectStyle m_styleTab;
         Bounds2f                    m_bodyBounds;
         Bounds2f                    m_tabBounds;
@@ -74,6 +74,8 @@ namespace Guise
 
         virtual void onResize();
 
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
         virtual void onUpdate();
 
         void calcTextBounds();
@@ -95,9 +97,10 @@ namespace Guise
         size_t                                  m_cursorIndex;
         size_t                                  m_cursorSelectIndex;
         uint32_t                                m_dpi;
+        ScopedConnection                        m_dpiConnection;
         std::shared_ptr<Font>                   m_font;
         FontSequence                            m_fontSequence;
-        std::unique_ptr<uint8_t[]>              m_loadData;
+        const uint8_t *                         m_loadData; ///< Owned by m_fontSequence.
         bool                                    m_mousePressed;
         Bounds2f                                m_textBounds;
         std::wstring                            m_text;
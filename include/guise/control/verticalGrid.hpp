@@ -61,6 +61,8 @@ namespace Guise
 
         virtual void onResize();
 
+        virtual void onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed);
+
         void resizeChilds();
     
         Style::ParentRectStyle  m_slotStyle;
@@ -46,6 +46,7 @@ namespace Guise
                     { "overflow",                       { Property::Overflow::Hidden } },
                     { "padding",                        { 3.0f } },
                     { "size",               { Size      { Size::FitContentAndParent, Size::FitContentAndParent } } },
+                    { "transition-duration",            { 0.1f } }
                 }
             );
 
@@ -80,7 +81,8 @@ namespace Guise
             static const Selector checkbox = Selector(
                 {
                     { "background-color",   { Vector4f  { 1.0f, 0.0f, 0.0f, 1.0f } } },
-                    { "size",               { Vector2f  { 16.0f, 16.0f } } }
+                    { "size",               { Vector2f  { 16.0f, 16.0f } } },
+                    { "transition-duration",            { 0.1f } }
                 }
             );
             static const Selector checkboxChecked = Selector(
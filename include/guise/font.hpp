@@ -28,7 +28,9 @@
 
 #include "guise/build.hpp"
 #include "guise/math/bounds.hpp"
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -36,6 +38,9 @@ namespace Guise
 {
 
     class FontSequence;
+    class TextLayout;
+    class RendererInterface;
+    class Texture;
 
     class GUISE_API Font
     {
@@ -86,11 +91,35 @@ namespace Guise
 
         bool createSequence(const std::wstring & text, const uint32_t height, const uint32_t dpi);
 
+        /**
+        * Create sequence of signed distance field glyphs.
+        * Glyphs are rasterized once per font at a fixed reference size and serve all sizes and dpis;
+        * positions and bitmaps of the sequence are in reference size pixels.
+        * Draw the bitmap with RendererInterface::drawDistanceFieldQuad, scaled by getDistanceFieldScale.
+        */
+        bool createDistanceFieldSequence(const std::wstring & text);
+
+        /**
+        * Get scale from distance field sequence pixels to pixels of given font height and dpi.
+        */
+        static float getDistanceFieldScale(const uint32_t height, const uint32_t dpi);
+
         bool createBitmapaAlpha(std::unique_ptr<uint8_t[]> & buffer, Vector2<size_t> & dimensions,
                                 const size_t from = 0, const size_t to = std::numeric_limits<size_t>::max());
         bool createBitmapRgba(std::unique_ptr<uint8_t[]> & buffer, Vector2<size_t> & dimensions,
                               const size_t from = 0, const size_t to = std::numeric_limits<size_t>::max());
 
+        /**
+        * Create bitmap into the scratch buffer of this sequence, avoiding an allocation per call.
+        *
+        * @return Pointer to bitmap data, valid until the next bitmap creation of this sequence.
+        *         nullptr if sequence is empty.
+        */
+        const uint8_t * createBitmapaAlpha(Vector2<size_t> & dimensions,
+                                           const size_t from = 0, const size_t to = std::numeric_limits<size_t>::max());
+        const uint8_t * createBitmapRgba(Vector2<size_t> & dimensions,
+                                         const size_t from = 0, const size_t to = std::numeric_limits<size_t>::max());
+
         bool findIndex(const int32_t width, const size_t from, size_t & to) const;
 
         size_t getBaseline() const;
@@ -99,18 +128,124 @@ namespace Guise
 
         size_t getCount() const;
 
+        /**
+        * Find the caret index closest to a horizontal point, in sequence pen coordinates.
+        *
+        * @return Index in range [0, getCount()].
+        */
         size_t intersect(const Vector2f & point) const;
 
+        /**
+        * Get recommended distance between baselines of consecutive lines, in pixels.
+        */
+        int32_t getLineHeight() const;
+
 
     private:
 
-       
+        friend class TextLayout;
 
         struct Impl;
         std::shared_ptr<Impl>   m_impl;
 
     };
 
+    /**
+    * Paragraph layout of a font sequence, wrapping words to a given width.
+    * The text is shaped once; changing the width only re-lays out lines that no longer fit.
+    */
+    class GUISE_API TextLayout
+    {
+
+    public:
+
+        struct Line
+        {
+            size_t  from;       ///< First character of line.
+            size_t  to;         ///< One past last character of line, including trailing spaces.
+            int32_t width;      ///< Width of line, excluding trailing spaces.
+            int32_t minWidth;   ///< Line is kept as is for layout widths in range [minWidth, breakWidth).
+            int32_t breakWidth;
+        };
+
+        TextLayout();
+        TextLayout(std::shared_ptr<Font> & font);
+
+        /**
+        * Shape text and lay it out for given width.
+        * A width of std::numeric_limits<int32_t>::max() disables wrapping, new lines are always respected.
+        */
+        bool create(const std::wstring & text, const uint32_t height, const uint32_t dpi, const int32_t width);
+
+        /**
+        * Re-layout for a new width.
+        *
+        * @return true if any line changed.
+        */
+        bool setWidth(const int32_t width);
+
+        int32_t getWidth() const;
+
+        const FontSequence & getSequence() const;
+
+        const std::vector<Line> & getLines() const;
+
+        int32_t getLineHeight() const;
+
+        /**
+        * Get size of laid out text, widest line times number of lines.
+        */
+        Vector2<size_t> getSize() const;
+
+        /**
+        * Find the line containing character index, O(log n).
+        */
+        size_t findLine(const size_t index) const;
+
+        /**
+        * Find caret index closest to point, relative to top left corner of layout. O(log n).
+        */
+        size_t intersect(const Vector2f & point) const;
+
+        /**
+        * Get caret position of character index, top left corner of the caret, relative to top left corner of layout. O(log n).
+        */
+        Vector2f indexToPosition(const size_t index) const;
+
+        /**
+        * Create bitmap of all lines into the scratch buffer of this layout.
+        * The bitmap is stored bottom-up, as for FontSequence.
+        *
+        * @return Pointer to bitmap data, valid until the next bitmap creation. nullptr if layout is empty.
+        */
+        const uint8_t * createBitmapRgba(Vector2<size_t> & dimensions);
+
+    private:
+
+        struct Paragraph
+        {
+            size_t from;
+            size_t to;
+            size_t lineCount;
+        };
+
+        int32_t measure(const size_t from, const size_t to) const;
+
+        size_t nextBreak(const size_t from, const size_t to) const;
+
+        void layoutParagraph(const size_t from, const size_t to, std::vector<Line> & lines) const;
+
+        FontSequence            m_sequence;
+        std::wstring            m_text;
+        int32_t                 m_width;
+        std::vector<Paragraph>  m_paragraphs;
+        std::vector<Line>       m_lines;
+        std::vector<Line>       m_lineBuffer;
+        std::vector<uint8_t>    m_alphaBuffer;
+        std::vector<uint8_t>    m_rgbaBuffer;
+
+    };
+
     class GUISE_API FontLibrary
     {
 
@@ -120,6 +255,89 @@ namespace Guise
 
     };
 
+    /**
+    * Shaped and rasterized text, shared by every control displaying
+    * the same text with the same font, size and dpi.
+    * Text runs are immutable and obtained via TextRunCache.
+    */
+    class GUISE_API TextRun
+    {
+
+    public:
+
+        bool isValid() const;
+
+        /**
+        * Check if run holds a distance field bitmap, drawn via RendererInterface::drawDistanceFieldQuad.
+        */
+        bool isDistanceField() const;
+
+        const FontSequence & getSequence() const;
+
+        const Vector2<size_t> & getSize() const;
+
+        /**
+        * Get texture of text run, uploaded once per resource group of renderers, see RendererInterface::getResourceGroup.
+        *
+        * @return Texture of text run, nullptr if run is invalid.
+        */
+        std::shared_ptr<Texture> getTexture(RendererInterface & rendererInterface);
+
+    private:
+
+        TextRun(const std::shared_ptr<Font> & font, const std::wstring & text, const uint32_t height, const uint32_t dpi);
+        TextRun(const std::shared_ptr<Font> & font, const std::wstring & text);
+        TextRun(const TextRun &) = delete;
+
+        friend class TextRunCache;
+
+        bool                                                            m_isValid;
+        bool                                                            m_isDistanceField;
+        FontSequence                                                    m_sequence;
+        const uint8_t *                                                 m_bitmap;
+        Vector2<size_t>                                                 m_size;
+        std::mutex                                                      m_mutex;
+        std::map<uint64_t, std::shared_ptr<Texture> >                   m_textures; ///< Textures by resource group.
+
+    };
+
+    /**
+    * Reference counted cache of text runs, keyed by font, size, dpi and text.
+    * Runs are released as soon as the last control holding them is done with them.
+    */
+    class GUISE_API TextRunCache
+    {
+
+    public:
+
+        struct Statistics
+        {
+            size_t hits;
+            size_t misses;
+            size_t runs;
+        };
+
+        static std::shared_ptr<TextRun> get(const std::shared_ptr<Font> & font, const std::wstring & text, const uint32_t height, const uint32_t dpi);
+
+        /**
+        * Get distance field text run, shared by all sizes and dpis.
+        * Scale the run by FontSequence::getDistanceFieldScale when drawing.
+        */
+        static std::shared_ptr<TextRun> getDistanceField(const std::shared_ptr<Font> & font, const std::wstring & text);
+
+        static Statistics getStatistics();
+
+        static void resetStatistics();
+
+        /**
+        * Remove entries of released text runs.
+        *
+        * @return Number of removed entries.
+        */
+        static size_t purge();
+
+    };
+
 }
 
 
@@ -0,0 +1,120 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_FONT_INDEX_HPP
+#define GUISE_FONT_INDEX_HPP
+
+#include "guise/build.hpp"
+#include <string>
+#include <vector>
+
+namespace Guise
+{
+
+    /**
+    * Index of installed fonts, mapping family and style names to font files.
+    * Directories are scanned once, reading only the name table of each font,
+    * and the result is cached on disk. The cache is reused as long as the
+    * modification times of all scanned directories are unchanged.
+    */
+    class GUISE_API FontIndex
+    {
+
+    public:
+
+        struct Entry
+        {
+            std::string family;
+            std::string style;
+            std::string path;
+            std::string familyKey;  ///< Lowercase family, entries are sorted and looked up by key.
+            std::string styleKey;   ///< Lowercase style.
+        };
+
+        FontIndex(const std::vector<std::string> & directories, const std::string & cachePath);
+
+        /**
+        * Load index from cache file, or scan directories if the cache is missing or outdated.
+        * The cache file is rewritten after a scan.
+        */
+        void load();
+
+        /**
+        * Check if the last load was served by the cache file.
+        */
+        bool isCached() const;
+
+        const std::vector<Entry> & getEntries() const;
+
+        /**
+        * Find path of font, by family name, optionally followed by style, e.g. "DejaVu Sans Bold".
+        * Common Windows family names are mapped to metric compatible free fonts.
+        * Names are case insensitive.
+        *
+        * @return Path to font file, empty if not found.
+        */
+        std::string find(const std::string & font) const;
+
+        std::string find(const std::string & family, const std::string & style) const;
+
+        /**
+        * Get index of standard system font directories, loaded on first use.
+        */
+        static const FontIndex & getSystem();
+
+        /**
+        * Read family and style of font file, from the name table of the first face.
+        */
+        static bool readNames(const std::string & path, std::string & family, std::string & style);
+
+    private:
+
+        struct Directory
+        {
+            std::string path;
+            int64_t     modified;
+        };
+
+        bool readCache();
+
+        void scan();
+
+        void writeCache() const;
+
+        void sortEntries();
+
+        std::string findEntry(const std::string & family, const std::string & style) const;
+
+        std::vector<std::string>    m_rootDirectories;
+        std::string                 m_cachePath;
+        bool                        m_isCached;
+        std::vector<Directory>      m_directories;
+        std::vector<Entry>          m_entries;  ///< Sorted by lower case family and style.
+
+    };
+
+}
+
+#endif
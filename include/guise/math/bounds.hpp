@@ -129,6 +129,7 @@ namespace Guise
         Bounds<2, T> & cutTop(const T value);
 
         Bounds<2, T> & innerJoin(const Bounds<2, T> & right);
+        Bounds<2, T> & outerJoin(const Bounds<2, T> & right);
 
         Bounds<2, T> & operator = (const Bounds<2, T> & bounds);
 
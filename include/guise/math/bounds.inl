@@ -292,6 +292,16 @@ namespace Guise
         return *this;
     }
 
+    template <typename T>
+    inline Bounds<2, T> & Bounds<2, T>::outerJoin(const Bounds<2, T> & right)
+    {
+        size = Vector<2, T>::max(position + size, right.position + right.size);
+        position = Vector<2, T>::min(position, right.position);
+        size = size - position;
+
+        return *this;
+    }
+
     template <typename T>
     inline Bounds<2, T>::Bounds(const Bounds<2, T> & bounds) :
         position(bounds.position),
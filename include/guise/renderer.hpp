@@ -48,6 +48,8 @@ namespace Guise
 
     public:
 
+        RendererInterface();
+
         virtual float getScale() const = 0;
 
         virtual void setLevel(const size_t level) = 0;
@@ -55,8 +57,15 @@ namespace Guise
         virtual void drawRect(const Bounds2f & bounds, const Style::PaintRectStyle & style) = 0;
 
         virtual void drawQuad(const Bounds2f & bounds, const Vector4f & color) = 0;      
+        virtual void drawQuad(const Bounds2f & bounds, const Style::LinearGradient & gradient) = 0;
         virtual void drawQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color) = 0;
 
+        /**
+        * Draw texture holding a signed distance field in its alpha channel, see FontSequence::createDistanceFieldSequence.
+        * Edges stay sharp at any scale of the quad.
+        */
+        virtual void drawDistanceFieldQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color) = 0;
+
         virtual void drawBorder(const Bounds2f & bounds, const float width, const Vector4f & color) = 0;
 
         virtual void drawLine(const Vector2f & point1, const Vector2f & point2, const float width, const Vector4f & color) = 0;
@@ -66,7 +75,19 @@ namespace Guise
 
         virtual std::shared_ptr<Texture> createTexture() = 0;
 
+        /**
+        * Get the identifier of the group of renderers sharing textures with this renderer, unique to the renderer by default.
+        * Textures created by any renderer of a group can be drawn by all of them, caches key textures by group.
+        * Identifiers are never reused, so textures cached for destroyed renderers are never returned to new renderers.
+        */
+        virtual uint64_t getResourceGroup() const;
+
         //virtual void drawQuadRounded(const Vector2f & position, const Vector2f & size) = 0;
+
+    private:
+
+        uint64_t m_resourceGroup;
+
     };
 
     /**
@@ -79,7 +100,14 @@ namespace Guise
 
     public:
 
-        static std::shared_ptr<Renderer> createDefault(const std::shared_ptr<AppWindow> & appWindow);
+        /**
+        * Create the default renderer of app window.
+        *
+        * @param shareRenderer Renderer to share textures with, see getResourceGroup. Ignored if nullptr
+        *                      or if sharing with it is unsupported.
+        */
+        static std::shared_ptr<Renderer> createDefault(const std::shared_ptr<AppWindow> & appWindow,
+                                                       const std::shared_ptr<Renderer> & shareRenderer = nullptr);
     #if defined(GUISE_PLATFORM_WINDOWS)
         static std::shared_ptr<Renderer> createDefault(HDC deviceContextHandle);
     #endif
@@ -100,6 +128,22 @@ namespace Guise
 
         virtual void present() = 0;
 
+        /**
+        * Get the number of frames since the back buffer was last drawn, 1 if it holds the previous frame.
+        * 0 if its contents are undefined, which makes Canvas::render redraw everything. Returns 0 by default.
+        */
+        virtual uint32_t getBufferAge();
+
+        /** Restrict clears and draws to bounds, in unscaled canvas coordinates, until resetScissor. Ignored by default. */
+        virtual void setScissor(const Bounds2f & bounds);
+        virtual void resetScissor();
+
+        /**
+        * Make the rendering context of this renderer current on the calling thread.
+        * Required before updating or rendering if several renderers render on the same thread.
+        */
+        virtual void makeCurrent();
+
     };
 
 }
@@ -51,7 +51,41 @@ namespace Guise
         // Texture, OpenGL 1.3
         extern PFNGLACTIVETEXTUREPROC glActiveTexture;
 
+        // Shaders, OpenGL 2.0
+        extern PFNGLATTACHSHADERPROC glAttachShader;
+        extern PFNGLCOMPILESHADERPROC glCompileShader;
+        extern PFNGLCREATEPROGRAMPROC glCreateProgram;
+        extern PFNGLCREATESHADERPROC glCreateShader;
+        extern PFNGLDELETEPROGRAMPROC glDeleteProgram;
+        extern PFNGLDELETESHADERPROC glDeleteShader;
+        extern PFNGLGETPROGRAMIVPROC glGetProgramiv;
+        extern PFNGLGETSHADERIVPROC glGetShaderiv;
+        extern PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
+        extern PFNGLLINKPROGRAMPROC glLinkProgram;
+        extern PFNGLSHADERSOURCEPROC glShaderSource;
+        extern PFNGLUNIFORM1IPROC glUniform1i;
+        extern PFNGLUSEPROGRAMPROC glUseProgram;
+
+        // Sync objects, OpenGL 3.2 or ARB_sync
+        extern PFNGLFENCESYNCPROC glFenceSync;
+        extern PFNGLDELETESYNCPROC glDeleteSync;
+        extern PFNGLWAITSYNCPROC glWaitSync;
+
         GUISE_API bool loadExtensions();
+
+        /**
+        * Load optional shader extensions.
+        *
+        * @return false if shaders are not supported by the current context.
+        */
+        GUISE_API bool loadShaderExtensions();
+
+        /**
+        * Load optional sync object extensions.
+        *
+        * @return false if sync objects are not supported by the current context.
+        */
+        GUISE_API bool loadSyncExtensions();
     }
 
 }
@@ -34,6 +34,7 @@
 #include "guise/renderer.hpp"
 #include <memory>
 #include <stack>
+#include <vector>
 
 namespace Guise
 {
@@ -60,8 +61,11 @@ namespace Guise
         void drawRect(const Bounds2f & bounds, const Style::PaintRectStyle & style);
 
         void drawQuad(const Bounds2f & bounds, const Vector4f & color);
+        void drawQuad(const Bounds2f & bounds, const Style::LinearGradient & gradient);
         void drawQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color);
 
+        void drawDistanceFieldQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color);
+
         void drawBorder(const Bounds2f & bounds, const float width, const Vector4f & color);
 
         void drawLine(const Vector2f & point1, const Vector2f & point2, const float width, const Vector4f & color);
@@ -71,12 +75,23 @@ namespace Guise
 
         std::shared_ptr<Texture> createTexture();
 
+        uint64_t getResourceGroup() const;
+
         // Renderer functions.
-        static std::shared_ptr<OpenGLRenderer> create(const std::shared_ptr<AppWindow> & appWindow);
+        /**
+        * Create renderer of app window.
+        * Passing shareRenderer creates the OpenGL context sharing objects with the context of shareRenderer,
+        * all renderers of a resource group draw the same textures, e.g. text runs are uploaded once per group.
+        * Textures are uploaded by the thread rendering them first and may be drawn by any renderer of the group.
+        */
+        static std::shared_ptr<OpenGLRenderer> create(const std::shared_ptr<AppWindow> & appWindow,
+                                                      const std::shared_ptr<OpenGLRenderer> & shareRenderer = nullptr);
     #if defined(GUISE_PLATFORM_WINDOWS)
-        static std::shared_ptr<OpenGLRenderer> create(::HDC deviceContextHandle);
+        static std::shared_ptr<OpenGLRenderer> create(::HDC deviceContextHandle,
+                                                      const std::shared_ptr<OpenGLRenderer> & shareRenderer = nullptr);
     #elif defined(GUISE_PLATFORM_LINUX)
-        static std::shared_ptr<OpenGLRenderer> create(::Display * display, ::Window window, int screen);
+        static std::shared_ptr<OpenGLRenderer> create(::Display * display, ::Window window, int screen,
+                                                      const std::shared_ptr<OpenGLRenderer> & shareRenderer = nullptr);
     #endif
 
         const Vector4f & getClearColor();
@@ -93,32 +108,76 @@ namespace Guise
 
         void present();
 
+        /** Queried with GLX_EXT_buffer_age on Linux, 0 if unsupported. */
+        uint32_t getBufferAge();
+
+        void setScissor(const Bounds2f & bounds);
+        void resetScissor();
+
+        void makeCurrent();
+
     private:
 
-        
+        /**
+        * Group of contexts sharing objects.
+        * Every context of a group shares with the first context, which is never destroyed before the group.
+        */
+        struct ResourceGroup
+        {
+            uint64_t        id;
+        #if defined(GUISE_PLATFORM_WINDOWS)
+            ::HGLRC         context;
+        #elif defined(GUISE_PLATFORM_LINUX)
+            ::GLXContext    context;
+        #endif
+        };
+
     #if defined(GUISE_PLATFORM_WINDOWS)
-        OpenGLRenderer(HDC deviceContextHandle);
+        OpenGLRenderer(HDC deviceContextHandle, const std::shared_ptr<OpenGLRenderer> & shareRenderer);
 
         // Windows members.
         ::HDC           m_deviceContextHandle;  ///< Device context handle from the render output.
         ::HGLRC         m_context;              ///< The OpenGL context.
     #elif defined(GUISE_PLATFORM_LINUX)
-        OpenGLRenderer(::Display * display, ::Window window, int screen);
+        OpenGLRenderer(::Display * display, ::Window window, int screen, const std::shared_ptr<OpenGLRenderer> & shareRenderer);
 
         // Linux memebers.
         ::Colormap      m_colormap;
         ::GLXContext    m_context;
         ::Display *     m_display;
         ::Window        m_window;      
+        bool            m_bufferAgeSupported;
     #endif
 
+        /**
+        * Untextured vertex with per-vertex color.
+        * Solid and gradient quads are queued as such vertices and drawn together by flushQuads,
+        * before any draw call or state change which cannot be batched with them.
+        */
+        struct QuadVertex
+        {
+            float position[3];
+            float color[4];
+        };
+
+        void pushQuadVertex(const float x, const float y, const Vector4f & color);
+        void flushQuads();
+
         void updateProjectionMatrix();
 
-        Vector4f                m_clearColor;
-        Bounds2i32              m_viewPort;
-        float                   m_scale;
-        float                   m_level;
-        std::stack<Bounds2i32>  m_maskStack;
+        void drawTexturedQuad(const Bounds2f & bounds, const Vector4f & color);
+
+        bool loadDistanceFieldProgram();
+
+        Vector4f                        m_clearColor;
+        GLuint                          m_distanceFieldProgram;
+        bool                            m_distanceFieldProgramLoaded;
+        Bounds2i32                      m_viewPort;
+        float                           m_scale;
+        float                           m_level;
+        std::stack<Bounds2i32>          m_maskStack;
+        std::vector<QuadVertex>         m_quadVertices;
+        std::shared_ptr<ResourceGroup>  m_resourceGroup;
 
     };
 
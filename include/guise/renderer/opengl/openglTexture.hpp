@@ -60,9 +60,12 @@ namespace Guise
 
     private:
 
+        void deleteTexture();
+
         Vector2ui32 m_dimensions;
         GLuint      m_id;
         PixelFormat m_pixelFormat;
+        GLsync      m_uploadFence; ///< Signaled when the upload is complete, waited for by contexts binding the texture.
 
     };
 
@@ -0,0 +1,104 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_SHEET_WATCHER_HPP
+#define GUISE_SHEET_WATCHER_HPP
+
+#include "guise/style.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Guise
+{
+
+    namespace Style
+    {
+
+        /**
+        * Style sheet file watcher.
+        * The file is loaded and parsed by a background thread, initially and whenever it changes,
+        * so large sheets never stall the thread polling for new sheets.
+        * Changes are detected with inotify on Linux and by polling the modification time elsewhere.
+        */
+        class GUISE_API SheetWatcher
+        {
+
+        public:
+
+            /**
+            * Create watcher of file.
+            * Parsed sheets are merged over a copy of base, if provided.
+            */
+            static std::shared_ptr<SheetWatcher> create(const std::string & filename, const std::shared_ptr<Sheet> & base = nullptr);
+
+            ~SheetWatcher();
+
+            const std::string & getFilename() const;
+
+            /**
+            * Get the sheet loaded since the last call, without blocking.
+            *
+            * @return nullptr if no new sheet has been loaded.
+            */
+            std::shared_ptr<Sheet> poll();
+
+            /**
+            * Get the error of the last failed load, empty if the last load succeeded.
+            * The previously loaded sheet is kept on errors.
+            */
+            std::string getError() const;
+
+        private:
+
+            SheetWatcher(const std::string & filename, const std::shared_ptr<Sheet> & base);
+
+            SheetWatcher(const SheetWatcher &) = delete;
+
+            void run();
+
+            void reload();
+
+            bool watchNotifications();
+
+            void watchFileTime();
+
+            std::string             m_filename;
+            std::shared_ptr<Sheet>  m_base;
+            std::atomic<bool>       m_running;
+            mutable std::mutex      m_mutex;
+            std::shared_ptr<Sheet>  m_sheet;
+            std::string             m_error;
+            std::thread             m_thread;
+
+        };
+
+    }
+
+}
+
+#endif
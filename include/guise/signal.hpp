@@ -27,6 +27,10 @@
 #define GUISE_SIGNAL_HPP
 
 #include "guise/build.hpp"
+#include "guise/utility/delegate.hpp"
+#include "guise/utility/taskQueue.hpp"
+#include <array>
+#include <deque>
 #include <functional>
 #include <vector>
 #include <memory>
@@ -34,68 +38,163 @@
 namespace Guise
 {
 
-    /*
-    *
-    * Anonymous connections are not disconnected when calling disconnectAll.
-    *
-    *
+    /**
+    * Base class of the connected slots of signals, used by connection handles.
     */
-    template<typename ... T>
-    class Signal;
+    class SignalSlotsBase
+    {
+
+    public:
+
+        /** Maximum number of dependencies of a connection, they are locked on the stack while calling the callback. */
+        static constexpr size_t MaxDependencies = 4;
+
+        virtual ~SignalSlotsBase() = default;
 
-    template<>
-    class Signal<>
+        virtual void disconnect(const uint32_t index, const uint32_t generation) = 0;
+
+        virtual bool isConnected(const uint32_t index, const uint32_t generation) const = 0;
+
+    };
+
+
+    /**
+    * Connection class.
+    * Handle of a callback connected to a signal, disconnecting it in constant time.
+    * Handles stay valid after the signal is destroyed, the connection is then reported as disconnected.
+    */
+    class Connection
     {
 
     public:
 
-        using CallbackNoParams  = std::function<void()>;
-        using Dependencies      = std::vector<std::shared_ptr<void> >;
-        using DependenciesWeak  = std::vector<std::weak_ptr<void> >;
+        Connection();
 
-        struct AssignStructNoParams
-        {
-            DependenciesWeak    dependencies;
-            CallbackNoParams    callback;
-        };
+        void disconnect();
 
-        ~Signal();
+        bool isConnected() const;
 
-        Signal & connect(const CallbackNoParams & callback);
+    private:
 
-        Signal & connect(const DependenciesWeak & dependencies, const CallbackNoParams & callback);
+        template<typename ... T>
+        friend class Signal;
 
-        Signal & connectAnonymously(const CallbackNoParams & callback);
+        Connection(const std::shared_ptr<SignalSlotsBase> & slots, const uint32_t index, const uint32_t generation);
 
-        Signal & connectAnonymously(const DependenciesWeak & dependencies, const CallbackNoParams & callback);
+        std::weak_ptr<SignalSlotsBase>  m_slots;
+        uint32_t                        m_index;
+        uint32_t                        m_generation;
 
-        void disconnectAll();
+    };
 
-        size_t getAnonymousConnectionCount() const;
 
-        size_t getConnectionCount() const;
+    /**
+    * Scoped connection class.
+    * Owns a connection and disconnects it when destroyed or assigned another connection.
+    * Used by objects connecting callbacks capturing this to signals outliving them.
+    */
+    class ScopedConnection
+    {
 
-        size_t getTotalConnectionCount() const;
+    public:
 
-        Signal & operator =(const CallbackNoParams & callback);
+        ScopedConnection();
+        ScopedConnection(const Connection & connection);
+        ScopedConnection(ScopedConnection && scopedConnection);
+        ~ScopedConnection();
 
-        Signal & operator =(const AssignStructNoParams & assignStruct);
+        ScopedConnection & operator = (const Connection & connection);
+        ScopedConnection & operator = (ScopedConnection && scopedConnection);
+
+        void disconnect();
+
+        bool isConnected() const;
+
+        /** Stop owning the connection, without disconnecting it. */
+        Connection release();
+
+    private:
+
+        ScopedConnection(const ScopedConnection &) = delete;
+        ScopedConnection & operator = (const ScopedConnection &) = delete;
+
+        Connection m_connection;
+
+    };
 
-        Signal & operator()();
+
+    /**
+    * Slots connected to a signal.
+    * Slots are stored in a deque, so connecting while calling never moves a callback being called.
+    * Disconnected slots are reused by later connections.
+    */
+    template<typename ... T>
+    class SignalSlots : public SignalSlotsBase
+    {
+
+    public:
+
+        using Callback          = Delegate<void(T...)>;
+        using DependenciesWeak  = std::vector<std::weak_ptr<void> >;
+
+        SignalSlots();
+
+        /** Add slot, returns its index. Throws std::invalid_argument if there are more than MaxDependencies dependencies. */
+        uint32_t connect(Callback && callback, const DependenciesWeak * dependencies, const bool anonymous);
+
+        void disconnect(const uint32_t index, const uint32_t generation) override;
+
+        bool isConnected(const uint32_t index, const uint32_t generation) const override;
+
+        uint32_t getGeneration(const uint32_t index) const;
+
+        /** Disconnect all slots, except anonymous ones. */
+        void disconnectAll();
+
+        /** Call all connected slots, slots connected while calling are called by the next call. */
+        void call(T ... params);
+
+        size_t getConnectionCount() const;
+
+        size_t getAnonymousConnectionCount() const;
 
     private:
 
-        template<typename U>
-        void call(U & callback);
+        struct Slot
+        {
+            Slot();
+
+            Callback                                            callback;
+            std::array<std::weak_ptr<void>, MaxDependencies>    dependencies;
+            uint32_t                                            generation;
+            uint8_t                                             dependencyCount;
+            bool                                                connected;
+            bool                                                anonymous;
+        };
 
-        template<typename T>
-        using Callbacks = std::vector<std::pair<T, DependenciesWeak*> >;
+        void release(const uint32_t index);
 
-        Callbacks<CallbackNoParams> m_callbacksNoParams;
-        Callbacks<CallbackNoParams> m_anonymousCallbacksNoParams;
+        std::deque<Slot>        m_slots;
+        std::vector<uint32_t>   m_freeSlots;
+        std::vector<uint32_t>   m_releasedSlots; ///< Disconnected while calling, released when the outermost call returns.
+        size_t                  m_callDepth;
+        size_t                  m_connectionCount;
+        size_t                  m_anonymousConnectionCount;
 
     };
 
+
+    /**
+    * Signal class.
+    * Callbacks are stored in inline small-buffer delegates and dependencies are locked on the stack,
+    * so calling a signal never allocates.
+    * Callbacks accepting no parameters may be connected to signals with parameters.
+    * Anonymous connections are not disconnected when calling disconnectAll.
+    *
+    * Signals are not synchronized, connecting, disconnecting and calling must not run concurrently.
+    * Queued connections run their callbacks on the thread executing a task queue,
+    * so signals called by worker threads can update controls of an app window.
+    */
     template<typename ... T>
     class Signal
     {
@@ -104,37 +203,48 @@ namespace Guise
 
         using Callback          = std::function<void(T...)>;
         using CallbackNoParams  = std::function<void()>;
-        using Dependencies      = std::vector<std::shared_ptr<void> >;
         using DependenciesWeak  = std::vector<std::weak_ptr<void> >;
 
         struct AssignStruct
         {
             DependenciesWeak    dependencies;
-            Callback            callback;    
+            Callback            callback;
         };
         struct AssignStructNoParams
         {
             DependenciesWeak    dependencies;
-            CallbackNoParams    callback;   
+            CallbackNoParams    callback;
         };
 
-        ~Signal();
-
-        Signal & connect(const Callback & callback);
+        Signal();
 
-        Signal & connect(const CallbackNoParams & callback);
+        /**
+        * Connect callback, invocable with the parameters of the signal or without parameters.
+        * The callback is disconnected if any of its dependencies expire, at most SignalSlotsBase::MaxDependencies.
+        */
+        template<typename F>
+        Connection connect(F && callback);
 
-        Signal & connect(const DependenciesWeak & dependencies, const Callback & callback);
+        template<typename F>
+        Connection connect(const DependenciesWeak & dependencies, F && callback);
 
-        Signal & connect(const DependenciesWeak & dependencies, const CallbackNoParams & callback);
+        template<typename F>
+        Connection connectAnonymously(F && callback);
 
-        Signal & connectAnonymously(const Callback & callback);
+        template<typename F>
+        Connection connectAnonymously(const DependenciesWeak & dependencies, F && callback);
 
-        Signal & connectAnonymously(const CallbackNoParams & callback);
+        /**
+        * Connect callback, called by the thread executing queue instead of the thread calling the signal.
+        * Parameters are copied into the pushed task. Dependencies are locked by the executing thread,
+        * so a worker calling the signal never holds the last reference of e.g. a control.
+        * Tasks pushed before disconnecting are skipped when executed.
+        */
+        template<typename F>
+        Connection connectQueued(const std::shared_ptr<TaskQueue> & queue, F && callback);
 
-        Signal & connectAnonymously(const DependenciesWeak & dependencies, const Callback & callback);
-
-        Signal & connectAnonymously(const DependenciesWeak & dependencies, const CallbackNoParams & callback);
+        template<typename F>
+        Connection connectQueued(const std::shared_ptr<TaskQueue> & queue, const DependenciesWeak & dependencies, F && callback);
 
         void disconnectAll();
 
@@ -144,37 +254,29 @@ namespace Guise
 
         size_t getTotalConnectionCount() const;
 
-        Signal & operator =(const Callback & callback);
-
-        Signal & operator =(const CallbackNoParams & callback);
+        template<typename F, typename = std::enable_if_t<std::is_invocable<F, T...>::value || std::is_invocable<F>::value> >
+        Signal & operator =(F && callback);
 
         Signal & operator =(const AssignStruct & assignStruct);
 
+        template<typename U = void, typename = std::enable_if_t<(sizeof...(T) > 0), U> >
         Signal & operator =(const AssignStructNoParams & assignStruct);
 
         Signal & operator()(T ... params);
 
-        Signal & operator()();
-
     private:
 
-        template<typename U>
-        void call(U & callback);
-
-        template<typename U>
-        void call(U & callback, T ... params);
+        Signal(const Signal &) = delete;
+        Signal & operator =(const Signal &) = delete;
 
-        template<typename U>
-        using Callbacks = std::vector<std::pair<U, DependenciesWeak*> >;
+        template<typename F>
+        Connection connectSlot(const DependenciesWeak * dependencies, F && callback, const bool anonymous);
 
-        Callbacks<Callback>         m_callbacks;
-        Callbacks<CallbackNoParams> m_callbacksNoParams;
-        Callbacks<Callback>         m_anonymousCallbacks;
-        Callbacks<CallbackNoParams> m_anonymousCallbacksNoParams;
+        std::shared_ptr<SignalSlots<T...> > m_slots; ///< Created by the first connection, shared with connection handles.
 
     };
 }
 
 #include "guise/signal.inl"
 
-#endif
\ No newline at end of file
+#endif
@@ -23,336 +23,464 @@
 *
 */
 
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
 namespace Guise
 {
 
-    // Implementation of Signal class with no template parameters.
-    inline Signal<>::~Signal()
+    // Connection implementations.
+    inline Connection::Connection() :
+        m_index(0),
+        m_generation(0)
+    { }
+
+    inline void Connection::disconnect()
     {
-        for (auto it = m_callbacksNoParams.begin(); it != m_callbacksNoParams.end(); it++)
+        if (auto slots = m_slots.lock())
         {
-            if (it->second)
-            {
-                delete it->second;
-            }
+            slots->disconnect(m_index, m_generation);
         }
+        m_slots.reset();
     }
 
-    inline Signal<> & Signal<>::connect(const CallbackNoParams & callback)
+    inline bool Connection::isConnected() const
     {
-        m_callbacksNoParams.push_back({ callback, nullptr });
-        return *this;
+        auto slots = m_slots.lock();
+        return slots && slots->isConnected(m_index, m_generation);
     }
 
-    inline Signal<> & Signal<>::connect(const DependenciesWeak & dependencies, const CallbackNoParams & callback)
+    inline Connection::Connection(const std::shared_ptr<SignalSlotsBase> & slots, const uint32_t index, const uint32_t generation) :
+        m_slots(slots),
+        m_index(index),
+        m_generation(generation)
+    { }
+
+
+    // Scoped connection implementations.
+    inline ScopedConnection::ScopedConnection()
+    { }
+
+    inline ScopedConnection::ScopedConnection(const Connection & connection) :
+        m_connection(connection)
+    { }
+
+    inline ScopedConnection::ScopedConnection(ScopedConnection && scopedConnection) :
+        m_connection(scopedConnection.release())
+    { }
+
+    inline ScopedConnection::~ScopedConnection()
     {
-        DependenciesWeak * deps = new DependenciesWeak;
-        *deps = dependencies;
-        m_callbacksNoParams.push_back({ callback, deps });
-        return *this;
+        m_connection.disconnect();
     }
 
-    inline Signal<> & Signal<>::connectAnonymously(const CallbackNoParams & callback)
+    inline ScopedConnection & ScopedConnection::operator = (const Connection & connection)
     {
-        m_anonymousCallbacksNoParams.push_back({ callback, nullptr });
+        m_connection.disconnect();
+        m_connection = connection;
         return *this;
     }
 
-    inline Signal<> & Signal<>::connectAnonymously(const DependenciesWeak & dependencies, const CallbackNoParams & callback)
+    inline ScopedConnection & ScopedConnection::operator = (ScopedConnection && scopedConnection)
     {
-        DependenciesWeak * deps = new DependenciesWeak;
-        *deps = dependencies;
-        m_anonymousCallbacksNoParams.push_back({ callback, deps });
+        if (this != &scopedConnection)
+        {
+            m_connection.disconnect();
+            m_connection = scopedConnection.release();
+        }
         return *this;
     }
 
-    inline void Signal<>::disconnectAll()
+    inline void ScopedConnection::disconnect()
     {
-        m_callbacksNoParams.clear();
+        m_connection.disconnect();
     }
 
-    inline size_t Signal<>::getAnonymousConnectionCount() const
+    inline bool ScopedConnection::isConnected() const
     {
-        return m_anonymousCallbacksNoParams.size();
+        return m_connection.isConnected();
     }
-    inline size_t Signal<>::getConnectionCount() const
+
+    inline Connection ScopedConnection::release()
     {
-        return m_callbacksNoParams.size();
+        Connection connection = m_connection;
+        m_connection = Connection();
+        return connection;
     }
 
-    inline size_t Signal<>::getTotalConnectionCount() const
+
+    // Signal slots implementations.
+    template<typename ... T>
+    inline SignalSlots<T...>::Slot::Slot() :
+        generation(0),
+        dependencyCount(0),
+        connected(false),
+        anonymous(false)
+    { }
+
+    template<typename ... T>
+    inline SignalSlots<T...>::SignalSlots() :
+        m_callDepth(0),
+        m_connectionCount(0),
+        m_anonymousConnectionCount(0)
+    { }
+
+    template<typename ... T>
+    inline uint32_t SignalSlots<T...>::connect(Callback && callback, const DependenciesWeak * dependencies, const bool anonymous)
     {
-        return getConnectionCount() + getAnonymousConnectionCount();
+        if (dependencies && dependencies->size() > MaxDependencies)
+        {
+            throw std::invalid_argument("Signal connections support at most " + std::to_string(MaxDependencies) + " dependencies.");
+        }
+
+        // Reusing a slot while calling could call the new connection by the ongoing call.
+        uint32_t index = static_cast<uint32_t>(m_slots.size());
+        if (!m_callDepth && !m_freeSlots.empty())
+        {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            m_slots.emplace_back();
+        }
+
+        Slot & slot = m_slots[index];
+        slot.callback = std::move(callback);
+        slot.dependencyCount = 0;
+        if (dependencies)
+        {
+            for (auto & dependency : *dependencies)
+            {
+                slot.dependencies[slot.dependencyCount++] = dependency;
+            }
+        }
+        slot.connected = true;
+        slot.anonymous = anonymous;
+
+        anonymous ? m_anonymousConnectionCount++ : m_connectionCount++;
+        return index;
     }
 
-    inline Signal<> & Signal<>::operator =(const CallbackNoParams & callback)
+    template<typename ... T>
+    inline void SignalSlots<T...>::disconnect(const uint32_t index, const uint32_t generation)
     {
-        return connect(callback);
+        if (!isConnected(index, generation))
+        {
+            return;
+        }
+
+        Slot & slot = m_slots[index];
+        slot.connected = false;
+        slot.generation++;
+        slot.anonymous ? m_anonymousConnectionCount-- : m_connectionCount--;
+
+        // The callback may be disconnecting itself, keep it alive until the call returns.
+        if (m_callDepth)
+        {
+            m_releasedSlots.push_back(index);
+            return;
+        }
+        release(index);
     }
 
-    inline Signal<> & Signal<>::operator =(const AssignStructNoParams & assignStruct)
+    template<typename ... T>
+    inline bool SignalSlots<T...>::isConnected(const uint32_t index, const uint32_t generation) const
     {
-        return connect(assignStruct.dependencies, assignStruct.callback);
+        return index < m_slots.size() && m_slots[index].connected && m_slots[index].generation == generation;
     }
 
-    inline Signal<> & Signal<>::operator()()
+    template<typename ... T>
+    inline uint32_t SignalSlots<T...>::getGeneration(const uint32_t index) const
     {
-        call(m_anonymousCallbacksNoParams);
-        call(m_callbacksNoParams);
-        return *this;
+        return m_slots[index].generation;
     }
 
-    template<typename U>
-    inline void Signal<>::call(U & callback)
+    template<typename ... T>
+    inline void SignalSlots<T...>::disconnectAll()
     {
-        for (auto it = callback.begin(); it != callback.end();)
+        for (size_t i = 0; i < m_slots.size(); i++)
         {
-            bool deleted = false;
+            if (!m_slots[i].anonymous)
+            {
+                disconnect(static_cast<uint32_t>(i), m_slots[i].generation);
+            }
+        }
+    }
 
-            Dependencies dependencies;
-            if (it->second)
+    template<typename ... T>
+    inline void SignalSlots<T...>::call(T ... params)
+    {
+        struct CallDepthGuard
+        {
+            explicit CallDepthGuard(SignalSlots & slots) :
+                slots(slots)
+            {
+                slots.m_callDepth++;
+            }
+            ~CallDepthGuard()
             {
-                for (auto & dep : *it->second)
+                if (--slots.m_callDepth)
                 {
-                    auto locked = dep.lock();
-                    if (!locked)
-                    {
-                        delete it->second;
-                        it = callback.erase(it);
-                        deleted = true;
-                        break;
-                    }
-
-                    dependencies.push_back(locked);
+                    return;
+                }
+                for (auto index : slots.m_releasedSlots)
+                {
+                    slots.release(index);
                 }
+                slots.m_releasedSlots.clear();
             }
+            SignalSlots & slots;
+        } guard(*this);
 
-            if (!deleted)
+        const size_t count = m_slots.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            Slot & slot = m_slots[i];
+            if (!slot.connected)
             {
-                it->first();
-                ++it;
+                continue;
             }
-        }
-    }
 
+            if (!slot.dependencyCount)
+            {
+                slot.callback(params...);
+                continue;
+            }
 
-    // Implementation of Signal class.
-    template<typename ... T>
-    inline Signal<T...>::~Signal()
-    {
-        for (auto it = m_callbacks.begin(); it != m_callbacks.end(); it++)
-        {
-            if (it->second)
+            std::shared_ptr<void> dependencies[MaxDependencies];
+            bool expired = false;
+            for (size_t j = 0; j < slot.dependencyCount; j++)
             {
-                delete it->second;
+                dependencies[j] = slot.dependencies[j].lock();
+                if (!dependencies[j])
+                {
+                    expired = true;
+                    break;
+                }
             }
-        }
-        for (auto it = m_callbacksNoParams.begin(); it != m_callbacksNoParams.end(); it++)
-        {
-            if (it->second)
+
+            if (expired)
             {
-                delete it->second;
+                disconnect(static_cast<uint32_t>(i), slot.generation);
+                continue;
             }
+
+            slot.callback(params...);
         }
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connect(const Callback & callback)
+    inline size_t SignalSlots<T...>::getConnectionCount() const
     {
-        m_callbacks.push_back({ callback, nullptr });
-        return *this;
+        return m_connectionCount;
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connect(const CallbackNoParams & callback)
+    inline size_t SignalSlots<T...>::getAnonymousConnectionCount() const
     {
-        m_callbacksNoParams.push_back({ callback, nullptr });
-        return *this;
+        return m_anonymousConnectionCount;
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connect(const DependenciesWeak & dependencies, const Callback & callback)
+    inline void SignalSlots<T...>::release(const uint32_t index)
     {
-        DependenciesWeak * deps = new DependenciesWeak;
-        *deps = dependencies;
-        m_callbacks.push_back({ callback, deps });
-        return *this;
+        Slot & slot = m_slots[index];
+        slot.callback.reset();
+        for (size_t i = 0; i < slot.dependencyCount; i++)
+        {
+            slot.dependencies[i].reset();
+        }
+        slot.dependencyCount = 0;
+        m_freeSlots.push_back(index);
     }
 
-    template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connect(const DependenciesWeak & dependencies, const CallbackNoParams & callback)
-    {
-        DependenciesWeak * deps = new DependenciesWeak;
-        *deps = dependencies;
-        m_callbacksNoParams.push_back({ callback, deps });
-        return *this;
-    }
 
+    // Signal implementations.
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connectAnonymously(const Callback & callback)
-    {
-        m_anonymousCallbacks.push_back({ callback, nullptr });
-        return *this;
-    }
+    inline Signal<T...>::Signal()
+    { }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connectAnonymously(const CallbackNoParams & callback)
+    template<typename F>
+    inline Connection Signal<T...>::connect(F && callback)
     {
-        m_anonymousCallbacksNoParams.push_back({ callback, nullptr });
-        return *this;
+        return connectSlot(nullptr, std::forward<F>(callback), false);
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connectAnonymously(const DependenciesWeak & dependencies, const Callback & callback)
+    template<typename F>
+    inline Connection Signal<T...>::connect(const DependenciesWeak & dependencies, F && callback)
     {
-        DependenciesWeak * deps = new DependenciesWeak;
-        *deps = dependencies;
-        m_anonymousCallbacks.push_back({ callback, deps });
-        return *this;
+        return connectSlot(&dependencies, std::forward<F>(callback), false);
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::connectAnonymously(const DependenciesWeak & dependencies, const CallbackNoParams & callback)
+    template<typename F>
+    inline Connection Signal<T...>::connectAnonymously(F && callback)
     {
-        DependenciesWeak * deps = new DependenciesWeak;
-        *deps = dependencies;
-        m_anonymousCallbacksNoParams.push_back({ callback, deps });
-        return *this;
+        return connectSlot(nullptr, std::forward<F>(callback), true);
     }
 
     template<typename ... T>
-    inline void Signal<T...>::disconnectAll()
-    {  
-        m_callbacks.clear();
-        m_callbacksNoParams.clear();
+    template<typename F>
+    inline Connection Signal<T...>::connectAnonymously(const DependenciesWeak & dependencies, F && callback)
+    {
+        return connectSlot(&dependencies, std::forward<F>(callback), true);
     }
 
     template<typename ... T>
-    inline size_t Signal<T...>::getAnonymousConnectionCount() const
+    template<typename F>
+    inline Connection Signal<T...>::connectQueued(const std::shared_ptr<TaskQueue> & queue, F && callback)
     {
-        return m_anonymousCallbacks.size() + m_anonymousCallbacksNoParams.size();
+        return connectQueued(queue, DependenciesWeak(), std::forward<F>(callback));
     }
 
     template<typename ... T>
-    inline size_t Signal<T...>::getConnectionCount() const
+    template<typename F>
+    inline Connection Signal<T...>::connectQueued(const std::shared_ptr<TaskQueue> & queue, const DependenciesWeak & dependencies, F && callback)
     {
-        return m_callbacks.size() + m_callbacksNoParams.size();
+        if (dependencies.size() > SignalSlotsBase::MaxDependencies)
+        {
+            throw std::invalid_argument("Signal connections support at most " + std::to_string(SignalSlotsBase::MaxDependencies) + " dependencies.");
+        }
+
+        // Owned by the slot, pushed tasks skip the callback once the slot is disconnected.
+        struct QueuedCallback
+        {
+            std::decay_t<F>     callback;
+            DependenciesWeak    dependencies;
+        };
+        auto queuedCallback = std::make_shared<QueuedCallback>(QueuedCallback{ std::forward<F>(callback), dependencies });
+        std::weak_ptr<TaskQueue> weakQueue = queue;
+
+        return connectSlot(nullptr, [weakQueue, queuedCallback](T ... params)
+        {
+            auto queue = weakQueue.lock();
+            if (!queue)
+            {
+                return;
+            }
+
+            std::weak_ptr<QueuedCallback> weakCallback = queuedCallback;
+            queue->push([weakCallback, arguments = std::make_tuple(std::decay_t<T>(params)...)]() mutable
+            {
+                auto callback = weakCallback.lock();
+                if (!callback)
+                {
+                    return;
+                }
+
+                std::shared_ptr<void> dependencies[SignalSlotsBase::MaxDependencies];
+                for (size_t i = 0; i < callback->dependencies.size(); i++)
+                {
+                    dependencies[i] = callback->dependencies[i].lock();
+                    if (!dependencies[i])
+                    {
+                        return;
+                    }
+                }
+
+                if constexpr (std::is_invocable<std::decay_t<F>, T...>::value)
+                {
+                    std::apply(callback->callback, arguments);
+                }
+                else
+                {
+                    callback->callback();
+                }
+            });
+        }, false);
     }
 
     template<typename ... T>
-    inline size_t Signal<T...>::getTotalConnectionCount() const
+    inline void Signal<T...>::disconnectAll()
     {
-        return getConnectionCount() + getAnonymousConnectionCount();
+        if (m_slots)
+        {
+            m_slots->disconnectAll();
+        }
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::operator =(const Callback & callback)
+    inline size_t Signal<T...>::getAnonymousConnectionCount() const
     {
-        return connect(callback);
+        return m_slots ? m_slots->getAnonymousConnectionCount() : 0;
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::operator =(const CallbackNoParams & callback)
+    inline size_t Signal<T...>::getConnectionCount() const
     {
-        return connect(callback);
+        return m_slots ? m_slots->getConnectionCount() : 0;
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::operator =(const AssignStruct & assignStruct)
+    inline size_t Signal<T...>::getTotalConnectionCount() const
     {
-        return connect(assignStruct.dependencies, assignStruct.callback);
+        return getConnectionCount() + getAnonymousConnectionCount();
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::operator =(const AssignStructNoParams & assignStruct)
+    template<typename F, typename>
+    inline Signal<T...> & Signal<T...>::operator =(F && callback)
     {
-        return connect(assignStruct.dependencies, assignStruct.callback);
+        connect(std::forward<F>(callback));
+        return *this;
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::operator()(T ... params)
+    inline Signal<T...> & Signal<T...>::operator =(const AssignStruct & assignStruct)
     {
-        call(m_anonymousCallbacks, params...);
-        call(m_anonymousCallbacksNoParams);
-        call(m_callbacks, params...);
-        call(m_callbacksNoParams);       
+        connect(assignStruct.dependencies, assignStruct.callback);
         return *this;
     }
 
     template<typename ... T>
-    inline Signal<T...> & Signal<T...>::operator()()
+    template<typename U, typename>
+    inline Signal<T...> & Signal<T...>::operator =(const AssignStructNoParams & assignStruct)
     {
-        call(m_anonymousCallbacksNoParams);
-        call(m_callbacksNoParams);      
+        connect(assignStruct.dependencies, assignStruct.callback);
         return *this;
     }
 
     template<typename ... T>
-    template<typename U>
-    inline void Signal<T...>::call(U & callback)
+    inline Signal<T...> & Signal<T...>::operator()(T ... params)
     {
-        for (auto it = callback.begin(); it != callback.end();)
+        if (m_slots)
         {
-            bool deleted = false;
-
-            Dependencies dependencies;
-            if (it->second)
-            {
-                for (auto & dep : *it->second)
-                {
-                    auto locked = dep.lock();
-                    if (!locked)
-                    {
-                        delete it->second;
-                        it = callback.erase(it);
-                        deleted = true;
-                        break;
-                    }
-
-                    dependencies.push_back(locked);
-                }
-            }
-
-            if (!deleted)
-            {
-                it->first();
-                ++it;
-            }
+            // Keep the slots alive if a callback destroys the signal.
+            auto slots = m_slots;
+            slots->call(params...);
         }
+        return *this;
     }
 
     template<typename ... T>
-    template<typename U>
-    inline void Signal<T...>::call(U & callback, T ... params)
+    template<typename F>
+    inline Connection Signal<T...>::connectSlot(const DependenciesWeak * dependencies, F && callback, const bool anonymous)
     {
-        for (auto it = callback.begin(); it != callback.end();)
+        if (!m_slots)
         {
-            bool deleted = false;
+            m_slots = std::make_shared<SignalSlots<T...> >();
+        }
 
-            Dependencies dependencies;
-            if (it->second)
-            {
-                for (auto & dep : *it->second)
+        uint32_t index = 0;
+        if constexpr (std::is_invocable<F, T...>::value)
+        {
+            index = m_slots->connect(typename SignalSlots<T...>::Callback(std::forward<F>(callback)), dependencies, anonymous);
+        }
+        else
+        {
+            static_assert(std::is_invocable<F>::value, "Callback must be invocable with the signal parameters or without parameters.");
+            index = m_slots->connect(typename SignalSlots<T...>::Callback(
+                [callback = std::decay_t<F>(std::forward<F>(callback))](T ...) mutable
                 {
-                    auto locked = dep.lock();
-                    if (!locked)
-                    {
-                        delete it->second;
-                        it = callback.erase(it);
-                        deleted = true;
-                        break;
-                    }
-
-                    dependencies.push_back(locked);
-                }
-            }
-
-            if (!deleted)
-            {
-                it->first(params...);
-                ++it;
-            }
+                    callback();
+                }), dependencies, anonymous);
         }
+        return Connection(m_slots, index, m_slots->getGeneration(index));
     }
- 
+
 }
@@ -28,13 +28,14 @@
 
 #include "guise/build.hpp"
 #include "guise/math/bounds.hpp"
-#include "guise/signal.hpp"
 #include <initializer_list>
 #include <mutex>
 #include <map>
 #include <string>
 #include <memory>
+#include <array>
 #include <optional>
+#include <vector>
 
 namespace Guise
 {
@@ -47,12 +48,103 @@ namespace Guise
         class Selector;
         class Property;
 
-        using Properties = std::map<std::string, std::shared_ptr<Property> >;
-        using Selectors = std::map<std::string, std::shared_ptr<Selector> >;
+        /**
+        * Interned identifiers of known style properties.
+        * Unknown property names are assigned identifiers above Count at runtime, see internPropertyId.
+        */
+        enum class PropertyId : uint16_t
+        {
+            BackgroundColor = 0,
+            BorderColor,
+            BorderStyle,
+            BorderWidth,
+            FontBackgroundColor,
+            FontColor,
+            FontFamily,
+            FontSize,
+            HorizontalAlign,
+            Margin,
+            Overflow,
+            Padding,
+            Position,
+            Size,
+            VerticalAlign,
+            TransitionDuration,
+            BackgroundGradient,
+            Count
+        };
+
+        /**
+        * Interned identifiers of the selectors used by the built-in controls.
+        * Unknown selector names are assigned identifiers above Count at runtime, see internSelectorId.
+        */
+        enum class SelectorId : uint16_t
+        {
+            Button = 0,
+            ButtonActive,
+            ButtonDisabled,
+            ButtonHover,
+            Canvas,
+            Checkbox,
+            CheckboxChecked,
+            CheckboxCheckedDisabled,
+            CheckboxCheckedHover,
+            CheckboxDisabled,
+            CheckboxHover,
+            HorizontalGrid,
+            HorizontalGridSlot,
+            Label,
+            Plane,
+            TabWindow,
+            TabWindowTab,
+            TextBox,
+            TextBoxText,
+            VerticalGrid,
+            VerticalGridSlot,
+            Window,
+            Count
+        };
+
+        /**
+        * Get the identifier of a property name, interning the name if it is unknown.
+        * Aliases, such as "vert-align", map to the identifier of their full name.
+        */
+        GUISE_API PropertyId internPropertyId(const std::string & name);
+
+        /**
+        * Get the identifier of a known or already interned property name, without interning it.
+        *
+        * @return false if the name is unknown.
+        */
+        GUISE_API bool findPropertyId(const std::string & name, PropertyId & id);
+        GUISE_API const std::string & getPropertyName(const PropertyId id);
+
+        /**
+        * Get the identifier of a selector name, interning the name if it is unknown.
+        */
+        GUISE_API SelectorId internSelectorId(const std::string & name);
+
+        /**
+        * Get the identifier of a known or already interned selector name, without interning it.
+        *
+        * @return false if the name is unknown.
+        */
+        GUISE_API bool findSelectorId(const std::string & name, SelectorId & id);
+        GUISE_API const std::string & getSelectorName(const SelectorId id);
+
+        /** Properties of a selector, stored by value and sorted by identifier. */
+        using Properties = std::vector<std::pair<PropertyId, Property> >;
+        /** Selectors of a sheet, indexed by identifier. */
+        using Selectors = std::vector<std::optional<Selector> >;
 
         GUISE_API extern const float FitParent;
         GUISE_API extern const float FitContent;
 
+        /**
+        * Linear gradient class.
+        * Blends color A into color B along a direction given by angle in degrees,
+        * 0 blends from top to bottom and 90 from left to right.
+        */
         class GUISE_API LinearGradient
         {
 
@@ -70,6 +162,16 @@ namespace Guise
             const Vector4f & getColorA() const;
             const Vector4f & getColorB() const;
 
+            /**
+            * Get the color at point of the gradient filling bounds.
+            * The gradient line is sized so the corners of bounds are exactly color A and color B,
+            * colors are linear in the point, so a quad with its corner colors renders the gradient exactly.
+            */
+            Vector4f getColor(const Bounds2f & bounds, const Vector2f & point) const;
+
+            bool operator == (const LinearGradient & gradient) const;
+            bool operator != (const LinearGradient & gradient) const;
+
         private:
 
             float       m_angle;
@@ -166,9 +268,7 @@ namespace Guise
             Property(const Vector3f & value);
             Property(const Vector4f & value);
             Property(const HorizontalAlign value);
-            Property(const VerticalAlign value);           
-
-            ~Property();
+            Property(const VerticalAlign value);
 
             DataType getDataType() const;
 
@@ -176,10 +276,10 @@ namespace Guise
             BorderStyle getBorderStyle() const;
             float getFloat() const;
             int getInteger() const;
-            LinearGradient getLinearGradient() const;
+            const LinearGradient & getLinearGradient() const;
             Overflow getOverflow() const;
             const Size & getSize() const;
-            std::string getString() const;
+            const std::string & getString() const;
             const Vector2f & getVector2f() const;
             const Vector3f & getVector3f() const;
             const Vector4f & getVector4f() const;
@@ -200,6 +300,7 @@ namespace Guise
             void setHorizontalAlign(const HorizontalAlign value);
             void setVerticalAlign(const VerticalAlign value);
             
+            Property & operator = (const Property & property);
             Property & operator = (const bool value);
             Property & operator = (const BorderStyle value);
             Property & operator = (const float value);
@@ -213,9 +314,12 @@ namespace Guise
             Property & operator = (const HorizontalAlign value);
             Property & operator = (const VerticalAlign value);
 
+            bool operator == (const Property & property) const;
+            bool operator != (const Property & property) const;
+
         private:
 
-            void deallocate();
+            void copyValue(const Property & property);
 
             DataType    m_dataType;
 
@@ -227,8 +331,8 @@ namespace Guise
                 int                 m_valueInteger;
                 Overflow            m_valueOverflow;
                 Size                m_valueSize;
-                std::string *       m_valueString;
-                LinearGradient *    m_valueLinearGradient;
+                const std::string * m_valueString; ///< Interned, never freed.
+                LinearGradient      m_valueLinearGradient;
                 Vector2f            m_valueVector2f;
                 Vector3f            m_valueVector3f;
                 Vector4f            m_valueVector4f;
@@ -239,6 +343,64 @@ namespace Guise
         };
 
 
+        /**
+        * Block of typed property values.
+        * A block is converted once per selector and shared by every style assigned from that selector,
+        * styles copy their block only when a property is set locally or animated.
+        */
+        struct GUISE_API Block
+        {
+
+            Block();
+            Block(const Block & block);
+            ~Block();
+
+            /** Convert the properties of selector, ignoring properties with unsupported data types. */
+            explicit Block(const Selector & selector);
+
+            /** Copy the values of the properties in the bitmask of PropertyId bits from block. */
+            void copyProperties(const Block & block, const uint32_t properties);
+
+            /** Check if the values of the properties in the bitmask of PropertyId bits are equal to those of block. */
+            bool hasEqualProperties(const Block & block, const uint32_t properties) const;
+
+            std::optional<Vector4f>                     backgroundColor;
+            std::optional<LinearGradient>               backgroundGradient;
+            std::optional<Vector4f>                     borderColor;
+            std::optional<Property::BorderStyle>        borderStyle;
+            std::optional<float>                        borderWidth;
+            std::optional<Vector4f>                     fontBackgroundColor;
+            std::optional<Vector4f>                     fontColor;
+            std::optional<const std::string *>          fontFamily; ///< Interned, never freed.
+            std::optional<int32_t>                      fontSize;
+            std::optional<Property::HorizontalAlign>    horizontalAlign;
+            std::optional<Vector4f>                     margin;
+            std::optional<Property::Overflow>           overflow;
+            std::optional<Vector4f>                     padding;
+            std::optional<Vector2f>                     position;
+            std::optional<Size>                         size;
+            std::optional<float>                        transitionDuration;
+            std::optional<Property::VerticalAlign>      verticalAlign;
+
+            uint32_t localProperties; ///< Bits of the PropertyId values set explicitly, kept when the sheet changes.
+
+            // Animation state of a block copied from a shared block to animate its properties, not copied along with the values.
+            std::shared_ptr<Block>  animationSource;    ///< Shared block this block was copied from.
+            std::unique_ptr<Block>  animationRest;      ///< Values of the animated properties before animating.
+            uint32_t                animatedProperties; ///< Bits of the animated PropertyId values.
+
+        };
+
+        /** Memory used by all live blocks, for memory reports. */
+        struct GUISE_API BlockStatistics
+        {
+            size_t count;
+            size_t bytes;
+        };
+
+        GUISE_API BlockStatistics getBlockStatistics();
+
+
         class GUISE_API Selector
         {
 
@@ -247,25 +409,71 @@ namespace Guise
             struct GUISE_API PropertyNameValue
             {
                 PropertyNameValue(const std::string & name, const Property & property);
+                PropertyNameValue(const PropertyId id, const Property & property);
 
-                const std::string & name;
+                const PropertyId id;
                 const Property & property;
 
             };
 
             Selector();
-            Selector(const Selector & selector);
             Selector(const std::shared_ptr<Selector> & selector);
             Selector(const std::initializer_list<PropertyNameValue> & properties);
+            Selector(const Selector & selector);
+
+            Selector & operator = (const Selector & selector);
 
-            std::shared_ptr<Property> getProperty(const std::string & name) const;
+            /** Get a property by name, nullptr if it is not set. Unknown names are not interned. */
+            const Property * getProperty(const std::string & name) const;
+            const Property * getProperty(const PropertyId id) const;
 
+            void setProperty(const std::string & name, const Property & property);
+            void setProperty(const PropertyId id, const Property & property);
+
+            /**
+            * Get mutable properties.
+            * Properties are shared between copies of a selector, calling this function detaches them.
+            */
             Properties & getProperties();
             const Properties & getProperties() const;
 
+            /**
+            * Get the typed values of the properties, converted on first use and shared by all styles assigned from this selector.
+            * The block must not be modified, styles copy it before setting a property.
+            */
+            std::shared_ptr<Block> getBlock() const;
+
+            bool operator == (const Selector & selector) const;
+            bool operator != (const Selector & selector) const;
+
         private:
 
-            Properties  m_properties;
+            Properties & detach();
+
+            std::shared_ptr<Properties>     m_properties;   ///< Copy-on-write, shared by copies of this selector.
+            mutable std::shared_ptr<Block>  m_block;        ///< Accessed atomically, selectors of shared sheets are read by multiple threads.
+
+        };
+
+
+        /**
+        * Set of selector identifiers, used to report which selectors differ between two sheets.
+        */
+        class GUISE_API SelectorSet
+        {
+
+        public:
+
+            void insert(const SelectorId id);
+
+            bool contains(const SelectorId id) const;
+            bool containsAny(const std::initializer_list<SelectorId> & ids) const;
+
+            bool isEmpty() const;
+
+        private:
+
+            std::vector<bool> m_ids;
 
         };
 
@@ -278,8 +486,9 @@ namespace Guise
             struct GUISE_API SelectorNameValue
             {
                 SelectorNameValue(const std::string & name, const Selector & selector);
+                SelectorNameValue(const SelectorId id, const Selector & selector);
 
-                const std::string & name;
+                const SelectorId id;
                 const Selector & selector;
 
             };
@@ -287,19 +496,165 @@ namespace Guise
             static std::shared_ptr<Sheet> create(const std::initializer_list<SelectorNameValue> & selectors = {});
             static std::shared_ptr<Sheet> createDefault();
 
-            std::shared_ptr<Selector> getSelector(const std::string & name) const;
-
+            /**
+            * Get the default sheet, constructed on first use and shared by all canvases created without a sheet.
+            * Sheets cannot be modified once created, sharing them between canvases and threads is safe.
+            */
+            static const std::shared_ptr<Sheet> & getDefault();
+
+            /**
+            * Parse a style sheet from CSS-like text, see styleParser.cpp for the syntax.
+            * Selectors and properties of the text are merged over a copy of base, if provided.
+            *
+            * @return nullptr on syntax errors, with a description written to error if not null.
+            */
+            static std::shared_ptr<Sheet> parse(const std::string & text, std::string * error = nullptr, const Sheet * base = nullptr);
+
+            /**
+            * Load and parse a style sheet file.
+            *
+            * @see parse
+            */
+            static std::shared_ptr<Sheet> load(const std::string & filename, std::string * error = nullptr, const Sheet * base = nullptr);
+
+            /**
+            * Load a binary style sheet written by saveBinary, see styleBinary.cpp for the layout.
+            * The file is memory mapped and decoded from fixed size records, without any text parsing.
+            * Properties are copied into the selectors of the sheet, so the mapping is released before returning,
+            * and only names of identifiers unknown to this build are interned.
+            *
+            * @return nullptr if the file cannot be mapped or is malformed, with a description written to error if not null.
+            */
+            static std::shared_ptr<Sheet> loadBinary(const std::string & filename, std::string * error = nullptr);
+
+            /**
+            * Load a binary style sheet from memory, e.g. data embedded into the executable.
+            *
+            * @see loadBinary
+            */
+            static std::shared_ptr<Sheet> loadBinary(const void * data, const size_t size, std::string * error = nullptr);
+
+            /**
+            * Get the identifiers of all selectors which are added, removed or modified in newSheet compared to oldSheet.
+            */
+            static SelectorSet diff(const Sheet & oldSheet, const Sheet & newSheet);
+
+            /** Get a selector by name, nullptr if the sheet has none. Unknown names are not interned. */
+            const Selector * getSelector(const std::string & name) const;
+            const Selector * getSelector(const SelectorId id) const;
+
+            /**
+            * Serialize this sheet to the binary format read by loadBinary.
+            * Text sheets can be compiled offline by loading them with load and saving the result.
+            */
+            std::vector<uint8_t> saveBinary() const;
+            bool saveBinary(const std::string & filename, std::string * error = nullptr) const;
 
         private:
 
             Sheet(const std::initializer_list<SelectorNameValue> & selectors = {});
 
+            Selector & getOrAddSelector(const SelectorId id);
+
             Selectors      m_selectors;
 
+            friend class SheetParser;
+            friend class SheetBinaryReader;
+
+        };
+
+
+        /**
+        * Style classes.
+        * Styles hold a shared pointer to a Block, shared with their selector until a property is set locally.
+        * Unset properties are inherited from the parent style, the default values are used if there is none.
+        *
+        * The effective values are resolved into plain fields of each style whenever its block or a parent style changes,
+        * getters never walk the parents. Styles are only modified by the canvas thread, so getters are safe to call
+        * from onPrepareUpdate while the canvas thread waits for the workers.
+        */
+        class GUISE_API BlockStyle
+        {
+
+        public:
+
+            BlockStyle();
+            BlockStyle(const BlockStyle & style);
+            ~BlockStyle();
+
+            BlockStyle & operator = (const BlockStyle & style);
+
+            /** Share the block of selector, keeping properties set explicitly. */
+            void updateEmptyProperties(const Selector * selector);
+
+            /** Clear all properties assigned by updateEmptyProperties, keeping properties set explicitly. */
+            void resetSheetProperties();
+
+            /**
+            * Share the block the style had before animating again, if all animated values are back at their values before animating
+            * and no property was set explicitly since. Called by Animator when the last tween of the style ends.
+            */
+            void releaseAnimatedValues();
+
+            /**
+            * Get a component of an animated property in the current block of the style, copied first if it is shared.
+            * Looked up by Animator on every update, so tweens follow the style when its block is replaced.
+            *
+            * @return nullptr if the property is empty, e.g. after the sheet properties are reset.
+            */
+            float * getAnimatedComponent(const PropertyId id, const size_t component);
+
+            /**
+            * Resolve the effective values again, along with those of all child styles.
+            * Called by every function modifying the block, and by Animator after writing animated components.
+            */
+            void updateResolved();
+
+            /** Get the number of times the effective values were resolved, changed whenever a value may have changed. */
+            uint64_t getResolvedGeneration() const;
+
+        protected:
+
+            /** Effective values of all properties, inherited from the parent style if not set by the block. */
+            struct Resolved
+            {
+                Resolved();
+
+                Vector4f                        backgroundColor;
+                std::optional<LinearGradient>   backgroundGradient;
+                Vector4f                        borderColor;
+                Property::BorderStyle           borderStyle;
+                float                           borderWidth;
+                Vector4f                        fontBackgroundColor;
+                Vector4f                        fontColor;
+                const std::string *             fontFamily;
+                int32_t                         fontSize;
+                Property::HorizontalAlign       horizontalAlign;
+                Vector4f                        margin;
+                Property::Overflow              overflow;
+                Vector4f                        padding;
+                Vector2f                        position;
+                Size                            size;
+                float                           transitionDuration;
+                Property::VerticalAlign         verticalAlign;
+            };
+
+            /** Inherit unset properties from parent, resolving the effective values again. */
+            void setParentStyle(BlockStyle * parent);
+
+            std::shared_ptr<Block>  m_block;    ///< Single block of the style, shared by all base classes.
+            Resolved                m_resolved; ///< Rebuilt by updateResolved, read by the getters.
+
+        private:
+
+            BlockStyle *                m_parentStyle;
+            std::vector<BlockStyle *>   m_childStyles;  ///< Styles inheriting from this style, resolved again along with it.
+            uint64_t                    m_resolvedGeneration;
+
         };
 
 
-        class GUISE_API ParentStyle
+        class GUISE_API ParentStyle : public virtual BlockStyle
         {
 
         public:
@@ -316,21 +671,20 @@ namespace Guise
             void setPaddingLow(const Vector2f & paddingLow);
             void setPaddingHigh(const Vector2f & paddingHigh);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
-
-        protected:
+            /** @see RectStyle::getAnimatedValues */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
 
-            ParentStyle *          m_parent;
+            /** @see RectStyle::hasEqualLayout */
+            bool hasEqualLayout(const ParentStyle & style) const;
 
-            std::optional<Vector4f> m_padding;
+        protected:
 
-        private:
+            Control *               m_control;  ///< Resized when a layout property is changed.
 
-            Signal<> onResizeChange;
         };
 
 
-        class GUISE_API AlignStyle
+        class GUISE_API AlignStyle : public virtual BlockStyle
         {
 
         public:
@@ -343,15 +697,6 @@ namespace Guise
             void setHorizontalAlign(const Property::HorizontalAlign horizontalAlign);
             void setVerticalAlign(const Property::VerticalAlign verticalAlign);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
-
-        protected:
-
-            AlignStyle * m_parent;
-
-            std::optional<Property::HorizontalAlign> m_horizontalAlign;
-            std::optional<Property::VerticalAlign> m_verticalAlign;
-
         };
 
 
@@ -378,27 +723,31 @@ namespace Guise
             void setPosition(const Vector2f & position);
             void setSize(const Size & size);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
+            /**
+            * Get pointers to the components of an animatable property, used by Animator.
+            * The block of the style is copied if shared and an empty property is assigned its resolved value first,
+            * animated values are reset along with the sheet properties.
+            *
+            * @return Number of components written to values, 0 if the property cannot be animated by this style.
+            */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
+
+            /**
+            * Check if all properties affecting the bounds of the control and its childs are equal to those of style.
+            * Styles with equal layout differ only in appearance, switching between them requires a redraw but no resize.
+            */
+            bool hasEqualLayout(const RectStyle & style) const;
             
         protected:
 
             static Bounds2f calcStyledBounds(const RectStyle & style, const Bounds2f & bounds, const float scale);
 
-            RectStyle * m_parent;
-
-            std::optional<Vector4f>                     m_margin;
-            std::optional<Style::Property::Overflow>    m_overflow;
-            std::optional<Vector2f>                     m_position;
-            std::optional<Size>                         m_size;
-
-        private:
-
-            Signal<> onResizeChange;
+            Control *               m_control;  ///< Resized when a layout property is changed.
 
         };
 
 
-        class GUISE_API BorderStyle
+        class GUISE_API BorderStyle : public virtual BlockStyle
         {
 
         public:
@@ -413,15 +762,8 @@ namespace Guise
             void setBorderStyle(const Property::BorderStyle style);
             void setBorderWidth(const float width);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
-
-        protected:
-
-            BorderStyle * m_parent;
-
-            std::optional<Vector4f>                     m_borderColor;
-            std::optional<Style::Property::BorderStyle> m_borderStyle;
-            std::optional<float>                        m_borderWidth;            
+            /** @see RectStyle::getAnimatedValues */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
 
         };
 
@@ -434,21 +776,24 @@ namespace Guise
             PaintRectStyle(Control * control = nullptr, PaintRectStyle * parent = nullptr);
 
             const Vector4f getBackgroundColor() const;
-   
-            void setBackgroundColor(const Vector4f & color);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
+            /** Get the background gradient, drawn instead of the background color if set. */
+            const std::optional<LinearGradient> & getBackgroundGradient() const;
 
-        protected:
-
-            PaintRectStyle * m_parent;
+            /** Get the duration in seconds of color transitions when switching to this style, 0 if disabled. */
+            float getTransitionDuration() const;
+   
+            void setBackgroundColor(const Vector4f & color);
+            void setBackgroundGradient(const LinearGradient & gradient);
+            void setTransitionDuration(const float seconds);
 
-            std::optional<Vector4f> m_backgroundColor;
+            /** @see RectStyle::getAnimatedValues */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
 
         };
 
 
-        class GUISE_API FontStyle : RectStyle
+        class GUISE_API FontStyle : RectStyle, public virtual BlockStyle
         {
 
         public:
@@ -457,7 +802,7 @@ namespace Guise
 
             const Vector4f getFontBackgroundColor() const;
             const Vector4f getFontColor() const;
-            const std::string getFontFamily() const;
+            const std::string & getFontFamily() const;
             const int32_t getFontSize() const;
 
             void setFontBackgroundColor(const Vector4f & color);
@@ -465,20 +810,8 @@ namespace Guise
             void setFontFamily(const std::string & family);
             void setFontSize(const int32_t size);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
-
-        protected:
-
-            FontStyle * m_parent;
-
-            std::optional<Vector4f>     m_fontBackgroundColor;
-            std::optional<Vector4f>     m_fontColor;
-            std::optional<std::string>  m_fontFamily;
-            std::optional<int32_t>      m_fontSize;
-
-        private:
-
-            Signal<> onResizeChange;
+            /** @see RectStyle::getAnimatedValues */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
 
         };
 
@@ -490,7 +823,11 @@ namespace Guise
 
             ParentRectStyle(Control * control = nullptr, ParentRectStyle * parent = nullptr);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
+            /** @see RectStyle::getAnimatedValues */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
+
+            /** @see RectStyle::hasEqualLayout */
+            bool hasEqualLayout(const ParentRectStyle & style) const;
 
         };
 
@@ -502,11 +839,60 @@ namespace Guise
 
             ParentPaintRectStyle(Control * control = nullptr, ParentPaintRectStyle * parent = nullptr);
 
-            void updateEmptyProperties(const std::shared_ptr<Selector> & selector);
+            /** @see RectStyle::getAnimatedValues */
+            size_t getAnimatedValues(const PropertyId id, float * values[4]);
+
+            /** @see RectStyle::hasEqualLayout */
+            bool hasEqualLayout(const ParentPaintRectStyle & style) const;
 
         }; 
 
 
+        /**
+        * Pseudo-state flags of a control, combined into a bitmask selecting the current style of a MultiStyle.
+        */
+        enum class State : uint8_t
+        {
+            None = 0x00,
+            Hover = 0x01,
+            Active = 0x02,
+            Disabled = 0x04,
+            Checked = 0x08
+        };
+
+        /** Number of distinct state bitmasks. */
+        static const size_t StateCount = 16;
+
+        inline State operator | (const State left, const State right)
+        {
+            return static_cast<State>(static_cast<uint8_t>(left) | static_cast<uint8_t>(right));
+        }
+        inline State operator & (const State left, const State right)
+        {
+            return static_cast<State>(static_cast<uint8_t>(left) & static_cast<uint8_t>(right));
+        }
+        inline State operator ~ (const State state)
+        {
+            return static_cast<State>(~static_cast<uint8_t>(state) & (StateCount - 1));
+        }
+
+
+        /**
+        * Animate the colors of style from the current colors of previous, if style has a transition duration.
+        * Defined by the animation module, see animation.hpp.
+        *
+        * @return true if a transition was started.
+        */
+        GUISE_API bool transitionStyle(Control & control, const PaintRectStyle & previous, PaintRectStyle & style);
+
+
+        /**
+        * Style with alternative styles for pseudo-states.
+        * The style of every state bitmask is looked up once when registered by setStateStyle,
+        * changing state is a table lookup followed by a redraw, or a resize if the layout differs.
+        * State styles inherit from this style, their resolved values are rebuilt along with it,
+        * so switching state reads the values of the new style without resolving anything.
+        */
         template<typename T, typename U>
         class MultiStyle : public T
         {
@@ -519,16 +905,30 @@ namespace Guise
 
             const T & getCurrentStyle() const;
 
+            State getState() const;
+
         protected:
 
+            /**
+            * Use style for every state bitmask containing all flags of state.
+            * Styles should be registered in increasing priority, later registrations replace earlier ones for shared bitmasks.
+            * Style should be constructed with this style as parent, to inherit the values it does not set.
+            */
+            void setStateStyle(const State state, T & style);
+
+            /** Set or clear flags of the current state. */
+            void setState(const State flags, const bool set);
+
             void setCurrentStyle(T & style);
 
             void setCurrentStyle(T * style);
 
         private:
 
-            U *   m_control;
-            T *   m_currentStyle;
+            U *                         m_control;
+            T *                         m_currentStyle;
+            State                       m_state;
+            std::array<T *, StateCount> m_stateStyles;
 
         };
 
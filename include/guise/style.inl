@@ -33,8 +33,11 @@ namespace Guise
         MultiStyle<T, U>::MultiStyle(U * control) :
             T(control, nullptr),
             m_control(control),
-            m_currentStyle(this)
-        { }
+            m_currentStyle(this),
+            m_state(State::None)
+        {
+            m_stateStyles.fill(this);
+        }
 
         template<typename T, typename U>
         T & MultiStyle<T, U>::getCurrentStyle()
@@ -49,26 +52,55 @@ namespace Guise
         }
 
         template<typename T, typename U>
-        void MultiStyle<T, U>::setCurrentStyle(T & style)
+        State MultiStyle<T, U>::getState() const
+        {
+            return m_state;
+        }
+
+        template<typename T, typename U>
+        void MultiStyle<T, U>::setStateStyle(const State state, T & style)
         {
-            if (&style != m_currentStyle)
+            for (size_t i = 0; i < StateCount; i++)
             {
-                m_currentStyle = &style;
-                m_control->resize();
+                if ((static_cast<State>(i) & state) == state)
+                {
+                    m_stateStyles[i] = &style;
+                }
             }
+            m_currentStyle = m_stateStyles[static_cast<size_t>(m_state)];
+        }
+
+        template<typename T, typename U>
+        void MultiStyle<T, U>::setState(const State flags, const bool set)
+        {
+            m_state = set ? (m_state | flags) : (m_state & ~flags);
+            setCurrentStyle(m_stateStyles[static_cast<size_t>(m_state)]);
+        }
+
+        template<typename T, typename U>
+        void MultiStyle<T, U>::setCurrentStyle(T & style)
+        {
+            setCurrentStyle(&style);
         }
 
         template<typename T, typename U>
         void MultiStyle<T, U>::setCurrentStyle(T * style)
         {
-            if (!style)
+            if (!style || style == m_currentStyle)
             {
                 return;
             }
 
-            if (style != m_currentStyle)
+            // Pseudo-states usually only change colors, skip the layout pass when possible.
+            T * previous = m_currentStyle;
+            m_currentStyle = style;
+            if (style->hasEqualLayout(*previous))
+            {
+                transitionStyle(*m_control, *previous, *style);
+                m_control->redraw();
+            }
+            else
             {
-                m_currentStyle = style;
                 m_control->resize();
             }
         }
@@ -0,0 +1,74 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_UTILITY_BITMAP_HPP
+#define GUISE_UTILITY_BITMAP_HPP
+
+#include "guise/build.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace Guise
+{
+
+    /**
+    * Row operations used when compositing glyph bitmaps.
+    * Vectorized with SSE2 when targeted by the compiler and with AVX2 when supported by the CPU, detected at runtime
+    * with GCC and Clang, falling back to scalar code.
+    */
+    namespace Bitmap
+    {
+
+        /**
+        * Per-byte maximum of destination and source: dst[i] = max(dst[i], src[i]).
+        */
+        GUISE_API void maxRow(uint8_t * destination, const uint8_t * source, const size_t count);
+
+        /**
+        * Expand alpha values into white RGBA pixels: 255, 255, 255, alpha.
+        * The destination must hold count * 4 bytes.
+        */
+        GUISE_API void expandAlphaToRgba(uint8_t * destination, const uint8_t * source, const size_t count);
+
+        /**
+        * Create signed distance field of an 8-bit coverage bitmap, pixels with coverage >= 128 are inside.
+        * Distances are stored as 128 + distance * 127 / spread, clamped, positive inside.
+        * The destination is padded by spread on each side and must hold
+        * (width + 2 * spread) * (height + 2 * spread) bytes, rows in the same order as the source.
+        */
+        GUISE_API void createDistanceField(uint8_t * destination, const uint8_t * source,
+                                           const size_t width, const size_t height, const size_t pitch, const size_t spread);
+
+        /**
+        * Scalar reference implementations.
+        */
+        GUISE_API void maxRowScalar(uint8_t * destination, const uint8_t * source, const size_t count);
+        GUISE_API void expandAlphaToRgbaScalar(uint8_t * destination, const uint8_t * source, const size_t count);
+
+    }
+
+}
+
+#endif
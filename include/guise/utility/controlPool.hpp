@@ -0,0 +1,111 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_UTILITY_CONTROLPOOL_HPP
+#define GUISE_UTILITY_CONTROLPOOL_HPP
+
+#include "guise/build.hpp"
+#include <cstddef>
+#include <memory>
+
+namespace Guise
+{
+
+    /**
+    * Control pool class.
+    * Process wide pool of fixed size slots, used for allocating controls together with their reference counts.
+    * Slots are grouped in size classes and carved out of chunks growing geometrically,
+    * so creating thousands of controls of the same type results in a few allocations of contiguous memory.
+    * Released slots are reused by later allocations of the same size class, chunks are never freed.
+    *
+    * Compile with GUISE_DISABLE_CONTROL_POOL defined to allocate controls with std::make_shared instead.
+    */
+    class GUISE_API ControlPool
+    {
+
+    public:
+
+        static const size_t SlotGranularity = 64;   ///< Slot sizes are multiples of this, also the slot alignment.
+        static const size_t MaxSlotSize = 4096;     ///< Larger allocations are passed on to operator new.
+
+        struct Statistics
+        {
+            size_t chunkCount;  ///< Number of allocated chunks.
+            size_t chunkBytes;  ///< Total size of allocated chunks.
+            size_t usedSlots;   ///< Number of slots currently in use.
+        };
+
+        /** Allocate size bytes, safe to call from any thread. */
+        static void * allocate(const size_t size);
+
+        /** Release memory returned by allocate, size must equal the allocated size. */
+        static void deallocate(void * pointer, const size_t size);
+
+        static Statistics getStatistics();
+
+    };
+
+
+    /**
+    * Standard allocator of control pool memory, for std::allocate_shared.
+    */
+    template<typename T>
+    class ControlAllocator
+    {
+
+    public:
+
+        using value_type = T;
+
+        ControlAllocator() = default;
+
+        template<typename U>
+        ControlAllocator(const ControlAllocator<U> &);
+
+        T * allocate(const size_t count);
+
+        void deallocate(T * pointer, const size_t count);
+
+    };
+
+    template<typename T, typename U>
+    bool operator == (const ControlAllocator<T> &, const ControlAllocator<U> &);
+    template<typename T, typename U>
+    bool operator != (const ControlAllocator<T> &, const ControlAllocator<U> &);
+
+
+    /**
+    * Create a control of type T, used by the create functions of controls.
+    * The control and its shared pointer control block are constructed in a single control pool slot.
+    * Constructors of T may be protected.
+    */
+    template<typename T, typename ... Args>
+    std::shared_ptr<T> createControl(Args && ... args);
+
+}
+
+#include "guise/utility/controlPool.inl"
+
+#endif
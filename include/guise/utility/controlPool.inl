@@ -0,0 +1,97 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include <utility>
+
+namespace Guise
+{
+
+    // Control allocator implementations.
+    template<typename T>
+    template<typename U>
+    inline ControlAllocator<T>::ControlAllocator(const ControlAllocator<U> &)
+    { }
+
+    template<typename T>
+    inline T * ControlAllocator<T>::allocate(const size_t count)
+    {
+        // Over-aligned types are left to operator new, slots are only aligned to the slot granularity.
+        if (alignof(T) > ControlPool::SlotGranularity)
+        {
+            return std::allocator<T>().allocate(count);
+        }
+        return static_cast<T *>(ControlPool::allocate(sizeof(T) * count));
+    }
+
+    template<typename T>
+    inline void ControlAllocator<T>::deallocate(T * pointer, const size_t count)
+    {
+        if (alignof(T) > ControlPool::SlotGranularity)
+        {
+            std::allocator<T>().deallocate(pointer, count);
+            return;
+        }
+        ControlPool::deallocate(pointer, sizeof(T) * count);
+    }
+
+    template<typename T, typename U>
+    inline bool operator == (const ControlAllocator<T> &, const ControlAllocator<U> &)
+    {
+        return true;
+    }
+
+    template<typename T, typename U>
+    inline bool operator != (const ControlAllocator<T> &, const ControlAllocator<U> &)
+    {
+        return false;
+    }
+
+
+    // Control creation implementations.
+    template<typename T>
+    class PooledControl : public T
+    {
+
+    public:
+
+        // Derived class, able to call protected constructors of T.
+        template<typename ... Args>
+        explicit PooledControl(Args && ... args) :
+            T(std::forward<Args>(args)...)
+        { }
+
+    };
+
+    template<typename T, typename ... Args>
+    inline std::shared_ptr<T> createControl(Args && ... args)
+    {
+    #if defined(GUISE_DISABLE_CONTROL_POOL)
+        return std::make_shared<PooledControl<T> >(std::forward<Args>(args)...);
+    #else
+        return std::allocate_shared<PooledControl<T> >(ControlAllocator<PooledControl<T> >(), std::forward<Args>(args)...);
+    #endif
+    }
+
+}
@@ -0,0 +1,103 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_UTILITY_DELEGATE_HPP
+#define GUISE_UTILITY_DELEGATE_HPP
+
+#include "guise/build.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Guise
+{
+
+    template<typename Signature>
+    class Delegate;
+
+    /**
+    * Delegate class.
+    * Type erased callable, similar to std::function, but movable only.
+    * Callables of up to BufferSize bytes are stored inline, calling or moving them never allocates.
+    * Larger callables are allocated on the heap when assigned.
+    */
+    template<typename R, typename ... T>
+    class Delegate<R(T...)>
+    {
+
+    public:
+
+        static constexpr size_t BufferSize = 4 * sizeof(void *);
+
+        Delegate();
+
+        template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Delegate>::value> >
+        Delegate(F && callable);
+
+        Delegate(Delegate && delegate);
+
+        ~Delegate();
+
+        Delegate & operator = (Delegate && delegate);
+
+        R operator()(T ... params) const;
+
+        explicit operator bool() const;
+
+        void reset();
+
+        /** Check if the callable is stored inline, without heap allocation. */
+        bool isInline() const;
+
+        /** Check if a callable of type F would be stored inline. */
+        template<typename F>
+        static constexpr bool isInlineCallable();
+
+    private:
+
+        Delegate(const Delegate &) = delete;
+        Delegate & operator = (const Delegate &) = delete;
+
+        enum class Operation
+        {
+            Move,   ///< Move source into storage and destroy source.
+            Destroy ///< Destroy source.
+        };
+
+        using Invoker = R(*)(void * storage, T ... params);
+        using Manager = void(*)(const Operation operation, void * storage, void * source);
+
+        alignas(std::max_align_t) mutable unsigned char m_storage[BufferSize];
+        Invoker                                         m_invoker;
+        Manager                                         m_manager;
+        bool                                            m_inline;
+
+    };
+
+}
+
+#include "guise/utility/delegate.inl"
+
+#endif
@@ -0,0 +1,163 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include <new>
+
+namespace Guise
+{
+
+    template<typename R, typename ... T>
+    inline Delegate<R(T...)>::Delegate() :
+        m_invoker(nullptr),
+        m_manager(nullptr),
+        m_inline(true)
+    { }
+
+    template<typename R, typename ... T>
+    template<typename F, typename>
+    inline Delegate<R(T...)>::Delegate(F && callable) :
+        m_invoker(nullptr),
+        m_manager(nullptr),
+        m_inline(isInlineCallable<std::decay_t<F> >())
+    {
+        using Callable = std::decay_t<F>;
+
+        if constexpr (isInlineCallable<Callable>())
+        {
+            new (m_storage) Callable(std::forward<F>(callable));
+            m_invoker = [](void * storage, T ... params) -> R
+            {
+                return (*static_cast<Callable *>(storage))(std::forward<T>(params)...);
+            };
+            m_manager = [](const Operation operation, void * storage, void * source)
+            {
+                Callable * sourceCallable = static_cast<Callable *>(source);
+                if (operation == Operation::Move)
+                {
+                    new (storage) Callable(std::move(*sourceCallable));
+                }
+                sourceCallable->~Callable();
+            };
+        }
+        else
+        {
+            *reinterpret_cast<Callable **>(m_storage) = new Callable(std::forward<F>(callable));
+            m_invoker = [](void * storage, T ... params) -> R
+            {
+                return (**static_cast<Callable **>(storage))(std::forward<T>(params)...);
+            };
+            m_manager = [](const Operation operation, void * storage, void * source)
+            {
+                Callable ** sourceCallable = static_cast<Callable **>(source);
+                if (operation == Operation::Move)
+                {
+                    *static_cast<Callable **>(storage) = *sourceCallable;
+                    return;
+                }
+                delete *sourceCallable;
+            };
+        }
+    }
+
+    template<typename R, typename ... T>
+    inline Delegate<R(T...)>::Delegate(Delegate && delegate) :
+        m_invoker(delegate.m_invoker),
+        m_manager(delegate.m_manager),
+        m_inline(delegate.m_inline)
+    {
+        if (m_manager)
+        {
+            m_manager(Operation::Move, m_storage, delegate.m_storage);
+            delegate.m_invoker = nullptr;
+            delegate.m_manager = nullptr;
+        }
+    }
+
+    template<typename R, typename ... T>
+    inline Delegate<R(T...)>::~Delegate()
+    {
+        reset();
+    }
+
+    template<typename R, typename ... T>
+    inline Delegate<R(T...)> & Delegate<R(T...)>::operator = (Delegate && delegate)
+    {
+        if (this == &delegate)
+        {
+            return *this;
+        }
+
+        reset();
+        m_invoker = delegate.m_invoker;
+        m_manager = delegate.m_manager;
+        m_inline = delegate.m_inline;
+        if (m_manager)
+        {
+            m_manager(Operation::Move, m_storage, delegate.m_storage);
+            delegate.m_invoker = nullptr;
+            delegate.m_manager = nullptr;
+        }
+        return *this;
+    }
+
+    template<typename R, typename ... T>
+    inline R Delegate<R(T...)>::operator()(T ... params) const
+    {
+        return m_invoker(m_storage, std::forward<T>(params)...);
+    }
+
+    template<typename R, typename ... T>
+    inline Delegate<R(T...)>::operator bool() const
+    {
+        return m_invoker != nullptr;
+    }
+
+    template<typename R, typename ... T>
+    inline void Delegate<R(T...)>::reset()
+    {
+        if (m_manager)
+        {
+            m_manager(Operation::Destroy, nullptr, m_storage);
+        }
+        m_invoker = nullptr;
+        m_manager = nullptr;
+        m_inline = true;
+    }
+
+    template<typename R, typename ... T>
+    inline bool Delegate<R(T...)>::isInline() const
+    {
+        return m_inline;
+    }
+
+    template<typename R, typename ... T>
+    template<typename F>
+    inline constexpr bool Delegate<R(T...)>::isInlineCallable()
+    {
+        return sizeof(F) <= BufferSize && alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+}
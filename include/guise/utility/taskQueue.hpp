@@ -0,0 +1,92 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_UTILITY_TASKQUEUE_HPP
+#define GUISE_UTILITY_TASKQUEUE_HPP
+
+#include "guise/build.hpp"
+#include "guise/utility/delegate.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace Guise
+{
+
+    /**
+    * Task queue class.
+    * Lock-free multiple producer, single consumer queue of tasks.
+    * Any thread may push tasks, a single thread executes them, e.g. the thread of an app window once per frame.
+    */
+    class GUISE_API TaskQueue
+    {
+
+    public:
+
+        using Task = Delegate<void()>;
+
+        TaskQueue();
+
+        /** Destroy pending tasks without executing them. */
+        ~TaskQueue();
+
+        /** Push task, safe to call from any thread. */
+        void push(Task && task);
+
+        /**
+        * Execute pending tasks in the order they were pushed, called by the consumer thread only.
+        * Tasks pushed by executed tasks are executed as well.
+        *
+        * @return Number of executed tasks.
+        */
+        size_t execute();
+
+        /** Check if there are no pending tasks, only reliable on the consumer thread. */
+        bool isEmpty() const;
+
+    private:
+
+        TaskQueue(const TaskQueue &) = delete;
+        TaskQueue & operator = (const TaskQueue &) = delete;
+
+        struct Node
+        {
+            Node();
+
+            std::atomic<Node *> next;
+            Task                task;
+        };
+
+        void pushNode(Node * node);
+        Node * popNode();
+
+        std::atomic<Node *> m_head; ///< Last pushed node, exchanged by producers.
+        Node *              m_tail; ///< Next node to pop, owned by the consumer.
+        Node                m_stub;
+
+    };
+
+}
+
+#endif
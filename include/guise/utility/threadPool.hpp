@@ -0,0 +1,121 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef GUISE_UTILITY_THREADPOOL_HPP
+#define GUISE_UTILITY_THREADPOOL_HPP
+
+#include "guise/build.hpp"
+#include "guise/utility/delegate.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Guise
+{
+
+    /**
+    * Thread pool class.
+    * Work stealing pool of worker threads, each owning a queue of tasks.
+    * Workers execute the newest task of their own queue first and steal the oldest task
+    * of another queue when their own runs empty, keeping all workers busy with uneven tasks.
+    */
+    class GUISE_API ThreadPool
+    {
+
+    public:
+
+        using Task = Delegate<void()>;
+
+        /**
+        * Get the pool shared by all canvases of the process, created on first use.
+        * It has one worker per hardware thread, except for the calling thread taking part in parallelFor.
+        */
+        static ThreadPool & getDefault();
+
+        /**
+        * @param workerCount Number of worker threads, zero executes all tasks on the threads calling parallelFor.
+        */
+        explicit ThreadPool(const size_t workerCount);
+
+        /** Execute pending tasks and join the workers. */
+        ~ThreadPool();
+
+        size_t getWorkerCount() const;
+
+        /** Push task to the queue of a worker, safe to call from any thread. */
+        void push(Task && task);
+
+        /**
+        * Call function for every index in [0, count) in parallel and return once all calls are finished.
+        * Indices are split into ranges of grainSize, which are pushed to the workers.
+        * The calling thread executes pending tasks while waiting, so parallelFor may be nested.
+        * Calls must be independent of each other, results are merged by the caller afterwards.
+        */
+        template<typename F>
+        void parallelFor(const size_t count, const F & function, const size_t grainSize = 1);
+
+    private:
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator = (const ThreadPool &) = delete;
+
+        struct alignas(64) Queue
+        {
+            std::mutex          mutex;
+            std::deque<Task>    tasks;
+        };
+
+        using RangeFunction = void(*)(const void * function, const size_t from, const size_t to);
+
+        void run(const size_t count, const size_t grainSize, RangeFunction rangeFunction, const void * function);
+
+        void pushTask(Task && task);
+        void wakeWorkers(const size_t count);
+        void work(const size_t index);
+
+        /** Pop a task from the back of queue index, or steal one from the front of another queue. */
+        bool popTask(const size_t index, Task & task);
+
+        const size_t                m_queueCount;
+        std::unique_ptr<Queue[]>    m_queues;
+        std::vector<std::thread>    m_workers;
+        std::atomic<size_t>         m_nextQueue;
+        std::atomic<size_t>         m_pendingTasks;
+        std::mutex                  m_sleepMutex;
+        std::condition_variable     m_wakeCondition;
+        bool                        m_stopping;
+
+    };
+
+}
+
+#include "guise/utility/threadPool.inl"
+
+#endif
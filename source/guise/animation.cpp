@@ -0,0 +1,422 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/animation.hpp"
+#include "guise/canvas.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace Guise
+{
+
+    // Frame clock implementations.
+    FrameClock::FrameClock() :
+        m_startTime(Clock::now()),
+        m_time(0.0),
+        m_deltaTime(0.0),
+        m_frame(0)
+    { }
+
+    void FrameClock::tick()
+    {
+        tick(std::chrono::duration<double>(Clock::now() - m_startTime).count());
+    }
+
+    void FrameClock::tick(const double time)
+    {
+        m_deltaTime = std::max(time - m_time, 0.0);
+        m_time = std::max(time, m_time);
+        m_frame++;
+    }
+
+    double FrameClock::getTime() const
+    {
+        return m_time;
+    }
+
+    double FrameClock::getDeltaTime() const
+    {
+        return m_deltaTime;
+    }
+
+    uint64_t FrameClock::getFrame() const
+    {
+        return m_frame;
+    }
+
+
+    // Animator implementations.
+    static float ease(const Easing easing, const float t)
+    {
+        switch (easing)
+        {
+        case Easing::EaseIn: return t * t;
+        case Easing::EaseOut: return t * (2.0f - t);
+        case Easing::EaseInOut: return t * t * (3.0f - (2.0f * t));
+        default: break;
+        }
+        return t;
+    }
+
+    Animator::Animator() :
+        m_time(0.0)
+    { }
+
+    bool Animator::TweenKey::operator == (const TweenKey & key) const
+    {
+        return owner == key.owner && component == key.component;
+    }
+
+    size_t Animator::TweenKeyHash::operator()(const TweenKey & key) const
+    {
+        return std::hash<const void *>()(key.owner) ^ (key.component * 0x9E3779B97F4A7C15ULL);
+    }
+
+    void Animator::animate(Control & control, float & value, const float target, const double duration,
+                           const Easing easing, const bool layout)
+    {
+        addTween(control, { &value, SIZE_MAX }, &value, nullptr, Style::PropertyId::Count, 0, value, target, duration, easing, layout);
+    }
+
+    void Animator::animateComponent(Control & control, Style::BlockStyle & style, const Style::PropertyId id, const size_t component,
+                                    const float target, const double duration, const Easing easing, const bool layout)
+    {
+        const float * value = style.getAnimatedComponent(id, component);
+        if (value)
+        {
+            addTween(control, getTweenKey(&style, id, component), nullptr, &style, id, component, *value, target, duration, easing, layout);
+        }
+    }
+
+    void Animator::cancel(const Control * control)
+    {
+        for (size_t i = 0; i < m_controls.size();)
+        {
+            if (m_controls[i] == control)
+            {
+                removeTween(i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    void Animator::cancelAll()
+    {
+        m_keys.clear();
+        m_values.clear();
+        m_from.clear();
+        m_to.clear();
+        m_startTimes.clear();
+        m_durations.clear();
+        m_easings.clear();
+        m_controls.clear();
+        m_styles.clear();
+        m_properties.clear();
+        m_components.clear();
+        m_layouts.clear();
+        m_indices.clear();
+        m_styleTweenCounts.clear();
+    }
+
+    bool Animator::update(const double time)
+    {
+        m_time = time;
+        if (m_values.empty())
+        {
+            return false;
+        }
+
+        m_changedControls.clear();
+        m_changedStyles.clear();
+        for (size_t i = 0; i < m_values.size();)
+        {
+            const float duration = m_durations[i];
+            const float t = duration > 0.0f ? std::min(static_cast<float>((time - m_startTimes[i]) / duration), 1.0f) : 1.0f;
+            const float from = m_from[i];
+
+            // Properties emptied since, e.g. by resetting the sheet properties of the style, stop animating.
+            float * value = getValue(i);
+            if (value)
+            {
+                *value = t < 1.0f ? from + ((m_to[i] - from) * ease(m_easings[i], std::max(t, 0.0f))) : m_to[i];
+                m_changedControls.push_back({ m_controls[i], m_layouts[i] });
+                if (m_styles[i])
+                {
+                    m_changedStyles.push_back(m_styles[i]);
+                }
+            }
+
+            if (t >= 1.0f || !value)
+            {
+                Style::BlockStyle * style = m_styles[i];
+                removeTween(i);
+
+                // The animated block may only be shared again after the last tween of the style.
+                if (style && m_styleTweenCounts.find(style) == m_styleTweenCounts.end())
+                {
+                    style->releaseAnimatedValues();
+                }
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        // Values are written directly, resolve every style and notify every control once.
+        std::sort(m_changedStyles.begin(), m_changedStyles.end());
+        m_changedStyles.erase(std::unique(m_changedStyles.begin(), m_changedStyles.end()), m_changedStyles.end());
+        for (auto style : m_changedStyles)
+        {
+            style->updateResolved();
+        }
+
+        std::sort(m_changedControls.begin(), m_changedControls.end());
+        for (size_t i = 0; i < m_changedControls.size(); i++)
+        {
+            Control * control = m_changedControls[i].first;
+            bool layout = m_changedControls[i].second;
+            while (i + 1 < m_changedControls.size() && m_changedControls[i + 1].first == control)
+            {
+                layout = layout || m_changedControls[++i].second;
+            }
+
+            if (layout)
+            {
+                control->resize();
+            }
+            else
+            {
+                control->redraw();
+            }
+        }
+
+        return isActive();
+    }
+
+    float Animator::getTarget(const float & value) const
+    {
+        auto it = m_indices.find({ &value, SIZE_MAX });
+        return it != m_indices.end() ? m_to[it->second] : value;
+    }
+
+    float Animator::getTarget(const Style::BlockStyle & style, const Style::PropertyId id, const size_t component, const float value) const
+    {
+        auto it = m_indices.find(getTweenKey(&style, id, component));
+        return it != m_indices.end() ? m_to[it->second] : value;
+    }
+
+    bool Animator::isActive() const
+    {
+        return !m_values.empty();
+    }
+
+    size_t Animator::getTweenCount() const
+    {
+        return m_values.size();
+    }
+
+    bool Animator::isLayoutProperty(const Style::PropertyId id)
+    {
+        switch (id)
+        {
+        case Style::PropertyId::Margin:
+        case Style::PropertyId::Padding:
+        case Style::PropertyId::Position:
+        case Style::PropertyId::Size:
+            return true;
+        default: break;
+        }
+        return false;
+    }
+
+    size_t Animator::getPropertyComponents(const Style::Property & property, float values[4])
+    {
+        switch (property.getDataType())
+        {
+        case Style::Property::DataType::Float:
+            values[0] = property.getFloat();
+            return 1;
+        case Style::Property::DataType::Size:
+        case Style::Property::DataType::Vector2f:
+        {
+            auto & vector = property.getDataType() == Style::Property::DataType::Size ? property.getSize() : property.getVector2f();
+            values[0] = vector.x;
+            values[1] = vector.y;
+            return 2;
+        }
+        case Style::Property::DataType::Vector4f:
+        {
+            auto & vector = property.getVector4f();
+            values[0] = vector.x;
+            values[1] = vector.y;
+            values[2] = vector.z;
+            values[3] = vector.w;
+            return 4;
+        }
+        default: break;
+        }
+        return 0;
+    }
+
+    Animator::TweenKey Animator::getTweenKey(const Style::BlockStyle * style, const Style::PropertyId id, const size_t component)
+    {
+        return { style, (static_cast<size_t>(id) * 4) + component };
+    }
+
+    void Animator::addTween(Control & control, const TweenKey & key, float * value, Style::BlockStyle * style, const Style::PropertyId id,
+                            const size_t component, const float from, const float target, const double duration, const Easing easing, const bool layout)
+    {
+        auto it = m_indices.find(key);
+        if (it != m_indices.end())
+        {
+            const size_t index = it->second;
+            m_from[index] = from;
+            m_to[index] = target;
+            m_startTimes[index] = m_time;
+            m_durations[index] = static_cast<float>(duration);
+            m_easings[index] = easing;
+            m_controls[index] = &control;
+            m_layouts[index] = layout;
+            return;
+        }
+
+        m_indices.insert({ key, m_values.size() });
+        m_keys.push_back(key);
+        m_values.push_back(value);
+        m_from.push_back(from);
+        m_to.push_back(target);
+        m_startTimes.push_back(m_time);
+        m_durations.push_back(static_cast<float>(duration));
+        m_easings.push_back(easing);
+        m_controls.push_back(&control);
+        m_styles.push_back(style);
+        m_properties.push_back(id);
+        m_components.push_back(static_cast<uint8_t>(component));
+        m_layouts.push_back(layout);
+
+        if (style)
+        {
+            m_styleTweenCounts[style]++;
+        }
+    }
+
+    float * Animator::getValue(const size_t index) const
+    {
+        Style::BlockStyle * style = m_styles[index];
+        return style ? style->getAnimatedComponent(m_properties[index], m_components[index]) : m_values[index];
+    }
+
+    void Animator::removeTween(const size_t index)
+    {
+        if (Style::BlockStyle * style = m_styles[index])
+        {
+            auto it = m_styleTweenCounts.find(style);
+            if (--it->second == 0)
+            {
+                m_styleTweenCounts.erase(it);
+            }
+        }
+
+        // Swap with the last tween, order of tweens is irrelevant.
+        const size_t last = m_values.size() - 1;
+        m_indices.erase(m_keys[index]);
+        if (index != last)
+        {
+            m_keys[index] = m_keys[last];
+            m_values[index] = m_values[last];
+            m_from[index] = m_from[last];
+            m_to[index] = m_to[last];
+            m_startTimes[index] = m_startTimes[last];
+            m_durations[index] = m_durations[last];
+            m_easings[index] = m_easings[last];
+            m_controls[index] = m_controls[last];
+            m_styles[index] = m_styles[last];
+            m_properties[index] = m_properties[last];
+            m_components[index] = m_components[last];
+            m_layouts[index] = m_layouts[last];
+            m_indices[m_keys[index]] = index;
+        }
+
+        m_keys.pop_back();
+        m_values.pop_back();
+        m_from.pop_back();
+        m_to.pop_back();
+        m_startTimes.pop_back();
+        m_durations.pop_back();
+        m_easings.pop_back();
+        m_controls.pop_back();
+        m_styles.pop_back();
+        m_properties.pop_back();
+        m_components.pop_back();
+        m_layouts.pop_back();
+    }
+
+
+    namespace Style
+    {
+
+        // Set a color of style to the color of previous and animate it back to its target.
+        static void transitionColor(Animator & animator, Control & control, const PropertyId id,
+                                    const Vector4f & previousColor, PaintRectStyle & style, const float duration)
+        {
+            float * values[4];
+            if (style.getAnimatedValues(id, values) != 4)
+            {
+                return;
+            }
+
+            const float previousValues[4] = { previousColor.x, previousColor.y, previousColor.z, previousColor.w };
+            for (size_t i = 0; i < 4; i++)
+            {
+                // Interrupted transitions continue towards their original target.
+                const float target = animator.getTarget(style, id, i, *values[i]);
+                *values[i] = previousValues[i];
+                animator.animateComponent(control, style, id, i, target, duration);
+            }
+            style.updateResolved();
+        }
+
+        bool transitionStyle(Control & control, const PaintRectStyle & previous, PaintRectStyle & style)
+        {
+            const float duration = style.getTransitionDuration();
+            Canvas * canvas = control.getCanvas();
+            if (duration <= 0.0f || !canvas)
+            {
+                return false;
+            }
+
+            auto & animator = canvas->getAnimator();
+            transitionColor(animator, control, PropertyId::BackgroundColor, previous.getBackgroundColor(), style, duration);
+            transitionColor(animator, control, PropertyId::BorderColor, previous.getBorderColor(), style, duration);
+            return true;
+        }
+
+    }
+
+}
@@ -180,6 +180,15 @@ namespace Guise
                     }
                 }
                 break;
+                case Expose:
+                {
+                    // Window contents were lost, render the whole canvas with the next frame.
+                    if (e.xexpose.count == 0)
+                    {
+                        m_canvas->reportDamage({ { 0.0f, 0.0f }, m_canvas->getSize() });
+                    }
+                }
+                break;
                 case MotionNotify:
                     m_input.pushEvent({ Input::EventType::MouseMove, { static_cast<float>(e.xmotion.x), static_cast<float>(e.xmotion.y) } });
                     break;
@@ -455,7 +455,7 @@ namespace Guise
             {
                 switch (wParam)
                 {
-                    case SC_MAXIMIZE: onMaximize(); return 0; break;
+                    case SC_MAXIMIZE: onMaximize(m_size); return 0; break;
                     case SC_MINIMIZE: onMinimize(); return 0; break;
                     default: break;
                 }
@@ -487,6 +487,16 @@ namespace Guise
                 }
             }
             break;
+            case WM_PAINT:
+            {
+                // Window contents were lost, render the whole canvas with the next frame.
+                PAINTSTRUCT paint;
+                ::BeginPaint(windowHandle, &paint);
+                ::EndPaint(windowHandle, &paint);
+                m_canvas->reportDamage({ { 0.0f, 0.0f }, m_canvas->getSize() });
+                return 0;
+            }
+            break;
             case WM_MOVE:
             {
                 m_position = { static_cast<int32_t>(LOWORD(lParam)), static_cast<int32_t>(HIWORD(lParam)) };
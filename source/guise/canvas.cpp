@@ -24,7 +24,12 @@
 */
 
 #include "guise/canvas.hpp"
+#include "guise/sheetWatcher.hpp"
+#include <algorithm>
 #include <iostream>
+#if defined(GUISE_SSE2)
+    #include <emmintrin.h>
+#endif
 
 namespace Guise
 {
@@ -36,13 +41,10 @@ namespace Guise
     CanvasStyle::CanvasStyle(const Style::Selector & selector) :
         CanvasStyle()
     {
-        auto & properties = selector.getProperties();
-        for (auto it = properties.begin(); it != properties.end(); it++)
+        auto backgroundColor = selector.getProperty(Style::PropertyId::BackgroundColor);
+        if (backgroundColor)
         {
-            if (it->first == "background-color")
-            { 
-                m_backgroundColor = it->second->getVector4f();
-            }
+            m_backgroundColor = backgroundColor->getVector4f();
         }
     }
 
@@ -58,13 +60,31 @@ namespace Guise
 
 
     // Canvas implementations.
+    // Join bounds into damaged bounds, which are empty at the origin if nothing was damaged.
+    static void joinDamage(Bounds2f & bounds, const Bounds2f & damage)
+    {
+        if (damage.size.x <= 0.0f || damage.size.y <= 0.0f)
+        {
+            return;
+        }
+        if (bounds.size.x <= 0.0f || bounds.size.y <= 0.0f)
+        {
+            bounds = damage;
+            return;
+        }
+        bounds.outerJoin(damage);
+    }
+
     std::shared_ptr<Canvas> Canvas::create(const Vector2ui32 & size, std::shared_ptr<Style::Sheet> * styleSheet)
     {
         return std::shared_ptr<Canvas>(new Canvas(size, styleSheet));
     }
 
     Canvas::~Canvas()
-    { }
+    {
+        // Planes report their removed controls back to this canvas, release them while the canvas is still intact.
+        m_planes.clear();
+    }
 
     /*bool Canvas::add(const std::shared_ptr<Control> & control, const size_t)
     {
@@ -81,11 +101,44 @@ namespace Guise
         plane->setCanvas(this);
         plane->setLevel(1);
         plane->setBounds({ { 0.0f, 0.0f }, m_size });
+        reportDamage({ { 0.0f, 0.0f }, m_size });
         return true;
     }
 
     void Canvas::update()
     {
+        {
+            StyleBatch batch(*this);
+            m_taskQueue->execute();
+        }
+
+        if (m_styleSheetWatcher)
+        {
+            auto styleSheet = m_styleSheetWatcher->poll();
+            if (styleSheet)
+            {
+                setStyleSheet(styleSheet);
+            }
+        }
+
+        m_frameClock.tick();
+        const double time = m_frameClock.getTime();
+        m_animator.update(time);
+
+        for (size_t i = 0; i < m_scheduledRedraws.size();)
+        {
+            if (m_scheduledRedraws[i].first <= time)
+            {
+                reportControlDamage(m_scheduledRedraws[i].second);
+                m_scheduledRedraws[i] = m_scheduledRedraws.back();
+                m_scheduledRedraws.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+
         m_input.update();
         
         struct MouseIntersector
@@ -184,27 +237,102 @@ namespace Guise
             }
         }
 
-        for (auto * control : m_updateControls)
+        if (m_updateControls.empty())
         {
+            return;
+        }
+
+        // Updates requested by onUpdate are performed by the next update.
+        m_updatingControls.swap(m_updateControls);
+
+        if (m_threadPool && m_threadPool->getWorkerCount() && m_updatingControls.size() >= ParallelUpdateMinimum)
+        {
+            m_threadPool->parallelFor(m_updatingControls.size(), [this](const size_t index)
+            {
+                if (Control * control = m_updatingControls[index])
+                {
+                    control->onPrepareUpdate();
+                }
+            }, ParallelUpdateGrainSize);
+        }
+        else
+        {
+            for (auto * control : m_updatingControls)
+            {
+                if (control)
+                {
+                    control->onPrepareUpdate();
+                }
+            }
+        }
+
+        // Merge prepared results in request order, resizing may touch parents and the canvas.
+        for (size_t i = 0; i < m_updatingControls.size(); i++)
+        {
+            Control * control = m_updatingControls[i];
+            if (!control)
+            {
+                continue;
+            }
+
+            m_updatingControls[i] = nullptr;
+            control->m_updateIndex = Control::InvalidUpdateIndex;
             control->onUpdate();
+            reportControlDamage(control);
         }
-        m_updateControls.clear();
+        m_updatingControls.clear();
     }
 
     void Canvas::render(Renderer & render)
     {
+        const Bounds2f canvasBounds = { { 0.0f, 0.0f }, m_size };
+        Bounds2f damageBounds = m_damaged ? m_damageBounds : Bounds2f(0.0f, 0.0f, 0.0f, 0.0f);
+        damageBounds.innerJoin(canvasBounds);
+
+        // A back buffer holding an older frame misses the damage of the frames rendered since, redraw it too.
+        const size_t bufferAge = static_cast<size_t>(render.getBufferAge());
+        const bool partial = bufferAge > 0 && bufferAge <= m_frameDamage.size() + 1;
+        m_renderBounds = partial ? damageBounds : canvasBounds;
+        for (size_t i = 0; partial && i + 1 < bufferAge; i++)
+        {
+            joinDamage(m_renderBounds, m_frameDamage[i]);
+        }
+
+        m_frameDamage.insert(m_frameDamage.begin(), damageBounds);
+        if (m_frameDamage.size() > MaxFrameDamage)
+        {
+            m_frameDamage.pop_back();
+        }
+
+        m_damaged = false;
+        m_damageBounds = { { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+        m_renderStatistics = { 0, 0 };
+
+        if (partial)
+        {
+            render.setScissor(m_renderBounds);
+        }
         render.clearColor();
         for (auto & plane : m_planes)
         {
             render.clearDepth();
             plane->draw(render);
         }
+        if (partial)
+        {
+            render.resetScissor();
+        }
         /*for (auto & child : m_childs)
         {
             child->draw(renderInterface);
         }*/
     }
 
+    const Canvas::RenderStatistics & Canvas::getRenderStatistics() const
+    {
+        return m_renderStatistics;
+    }
+
     const Input & Canvas::getInput() const
     {
         return m_input;
@@ -219,6 +347,77 @@ namespace Guise
         return m_styleSheet;
     }
 
+    void Canvas::setStyleSheet(const std::shared_ptr<Style::Sheet> & styleSheet)
+    {
+        auto newStyleSheet = styleSheet ? styleSheet : Style::Sheet::getDefault();
+        const auto changed = Style::Sheet::diff(*m_styleSheet, *newStyleSheet);
+        m_styleSheet = newStyleSheet;
+
+        if (changed.isEmpty())
+        {
+            return;
+        }
+
+        if (changed.contains(Style::SelectorId::Canvas))
+        {
+            auto canvasSelector = m_styleSheet->getSelector(Style::SelectorId::Canvas);
+            CanvasStyle::operator=(canvasSelector ? CanvasStyle(*canvasSelector) : CanvasStyle());
+            reportDamage({ { 0.0f, 0.0f }, m_size });
+        }
+
+        // Collect all controls before restyling, resizing may propagate to parents iterating their childs.
+        std::vector<std::shared_ptr<Control> > controls(m_planes.begin(), m_planes.end());
+        for (size_t i = 0; i < controls.size(); i++)
+        {
+            controls[i]->visitChilds([&controls](Control & child, size_t)
+            {
+                controls.push_back(child.shared_from_this());
+            });
+        }
+
+        // Restyled controls are resized once, after all of them are restyled.
+        StyleBatch batch(*this);
+        for (auto & control : controls)
+        {
+            m_animator.cancel(control.get());
+            control->onStyleSheetChange(this, changed);
+        }
+    }
+
+    void Canvas::watchStyleSheet(const std::string & filename)
+    {
+        m_styleSheetWatcher.reset();
+        if (!filename.empty())
+        {
+            m_styleSheetWatcher = Style::SheetWatcher::create(filename, Style::Sheet::getDefault());
+        }
+    }
+
+    Animator & Canvas::getAnimator()
+    {
+        return m_animator;
+    }
+
+    const std::shared_ptr<TaskQueue> & Canvas::getTaskQueue() const
+    {
+        return m_taskQueue;
+    }
+
+    void Canvas::setThreadPool(ThreadPool * threadPool)
+    {
+        m_threadPool = threadPool;
+    }
+
+    ThreadPool * Canvas::getThreadPool() const
+    {
+        return m_threadPool;
+    }
+
+    const FrameClock & Canvas::getFrameClock() const
+    {
+        return m_frameClock;
+    }
+
     const Vector2ui32 & Canvas::getSize() const
     {
         return m_size;
@@ -227,6 +426,7 @@ namespace Guise
     void Canvas::resize(const Vector2ui32 & size)
     {
         m_size = size;
+        reportDamage({ { 0.0f, 0.0f }, m_size });
 
         for (auto & plane : m_planes)
         {
@@ -302,128 +502,160 @@ namespace Guise
             return;
         }
 
-        auto itControl = m_selectControls.find(control);
+        reportControlDamage(control);
 
-        // Add new.
-        if (itControl == m_selectControls.end())
-        {
-            if (!control->getBounds().intersects(Bounds2f{ { 0.0f, 0.0f }, m_size }))
-            {
-                return;
-            }
+        const Bounds2f bounds = control->getSelectBounds();
+        const bool inside = control->getBounds().intersects(Bounds2f{ { 0.0f, 0.0f }, m_size });
+        size_t index = control->m_selectIndex;
 
-            const size_t level = control->getLevel();
-            auto itLevel = m_selectControlLevels.find(level);
-            if (itLevel == m_selectControlLevels.end())
+        // Not inside canvas anymore, remove it.
+        if (!inside)
+        {
+            if (index != Control::InvalidSelectIndex)
             {
-                itLevel = m_selectControlLevels.insert({ level, {} }).first;
+                removeSelectControl(control);
+                releaseControlReferences(control);
             }
+            return;
+        }
 
-            itLevel->second.push_back(control);
-            m_selectControls.insert({ control, level });
+        // Add new.
+        if (index == Control::InvalidSelectIndex)
+        {
+            index = m_selectControls.size();
+            control->m_selectIndex = index;
+            m_selectControls.push_back(control);
+            m_selectMinX.push_back(0.0f);
+            m_selectMinY.push_back(0.0f);
+            m_selectMaxX.push_back(0.0f);
+            m_selectMaxY.push_back(0.0f);
+            m_selectLevels.push_back(control->getLevel());
+            m_selectOrders.push_back(m_selectOrder++);
+            m_selectFlags.push_back(0);
         }
-        // Update existing.
-        else
+        // Controls moved to another level are hit before older controls of that level.
+        else if (m_selectLevels[index] != control->getLevel())
         {
-            // Not inside canvas anymore, remove it.
-            if (!control->getBounds().intersects(Bounds2f{ { 0.0f, 0.0f }, m_size }))
-            {
-                auto itLevel = m_selectControlLevels.find(itControl->second);
-                auto itControl2 = std::find(itLevel->second.begin(), itLevel->second.end(), control);
-
-                itLevel->second.erase(itControl2);
-                m_selectControls.erase(control);
-
-                if (control == m_selectedControl)
-                {
-                    m_selectedControl = nullptr;
-                }
-                if (control == m_activeControl)
-                {
-                    m_activeControl = nullptr;
-                }
-                if (control == m_hoveredControl)
-                {
-                    m_hoveredControl = nullptr;
-                }
-            }
-            else
-            {
-                const size_t currentLevel = control->getLevel();
-                const size_t oldLevel = itControl->second;
-                
-                // Level has been changed.
-                if (currentLevel != oldLevel)
-                {
-                    auto itLevel = m_selectControlLevels.find(oldLevel);
-                    if (itLevel != m_selectControlLevels.end())
-                    {
-                        auto itControl2 = std::find(itLevel->second.begin(), itLevel->second.end(), control);
-                        if (itControl2 != itLevel->second.end())
-                        {
-                            itLevel->second.erase(itControl2);
-                            
-                            if (!itLevel->second.size())
-                            {
-                                m_selectControlLevels.erase(itLevel);
-                            }
-
-                            itLevel = m_selectControlLevels.find(currentLevel);
-                            if (itLevel == m_selectControlLevels.end())
-                            {
-                                itLevel = m_selectControlLevels.insert({ currentLevel, {} }).first;
-                            }
+            m_selectLevels[index] = control->getLevel();
+            m_selectOrders[index] = m_selectOrder++;
+        }
 
-                            itLevel->second.push_back(control);
-                            m_selectControls.insert({ control, currentLevel });
-                            itControl->second = currentLevel;
+        m_selectMinX[index] = bounds.position.x;
+        m_selectMinY[index] = bounds.position.y;
+        m_selectMaxX[index] = bounds.position.x + bounds.size.x;
+        m_selectMaxY[index] = bounds.position.y + bounds.size.y;
+        m_selectFlags[index] = control->isEnabled() && control->isInputEnabled();
+    }
 
-                        }
-                    }
-                }
-            }
+    void Canvas::reportControlInputChange(Control * control)
+    {
+        const size_t index = control->m_selectIndex;
+        if (index != Control::InvalidSelectIndex)
+        {
+            m_selectFlags[index] = control->isEnabled() && control->isInputEnabled();
         }
     }
 
     void Canvas::reportControlRemove(Control * control)
     {
-        auto itLevel = m_selectControlLevels.find(control->getLevel());
-        if (itLevel == m_selectControlLevels.end())
+        m_animator.cancel(control);
+        m_scheduledRedraws.erase(std::remove_if(m_scheduledRedraws.begin(), m_scheduledRedraws.end(),
+            [control](const std::pair<double, Control *> & redraw) { return redraw.second == control; }), m_scheduledRedraws.end());
+        if (control->m_resizeIndex != Control::InvalidResizeIndex)
         {
-            return;
+            m_batchedResizes[control->m_resizeIndex] = nullptr;
+            control->m_resizeIndex = Control::InvalidResizeIndex;
         }
 
-        auto itControl = std::find(itLevel->second.begin(), itLevel->second.end(), control);
-        if (itControl == itLevel->second.end())
+        // Unselectable controls may still be pending for update or be referenced, e.g. as active control.
+        removeUpdateControl(control);
+        releaseControlReferences(control);
+        reportControlDamage(control);
+
+        if (control->m_selectIndex == Control::InvalidSelectIndex)
         {
             return;
         }
 
-        itLevel->second.erase(itControl);
-        m_selectControls.erase(control);
-        m_updateControls.erase(control);
+        removeSelectControl(control);
+    }
 
-        if (control == m_selectedControl)
+    void Canvas::reportDamage(const Bounds2f & bounds)
+    {
+        if (bounds.size.x <= 0.0f || bounds.size.y <= 0.0f)
         {
-            m_selectedControl = nullptr;
+            return;
         }
-        if (control == m_activeControl)
+
+        if (!m_damaged)
         {
-            m_activeControl = nullptr;
+            m_damaged = true;
+            m_damageBounds = bounds;
+            return;
         }
-        if (control == m_hoveredControl)
+        m_damageBounds.outerJoin(bounds);
+    }
+
+    void Canvas::reportControlDamage(Control * control)
+    {
+        if (control)
         {
-            m_hoveredControl = nullptr;
+            reportDamage(control->getBounds());
         }
     }
 
+    bool Canvas::isDamaged() const
+    {
+        return m_damaged;
+    }
+
+    bool Canvas::needsRender() const
+    {
+        return m_damaged || m_animator.isActive();
+    }
+
+    void Canvas::scheduleRedraw(Control * control, const double time)
+    {
+        for (auto & redraw : m_scheduledRedraws)
+        {
+            if (redraw.second == control)
+            {
+                redraw.first = std::min(redraw.first, time);
+                return;
+            }
+        }
+        m_scheduledRedraws.push_back({ time, control });
+    }
+
+    const Bounds2f & Canvas::getDamageBounds() const
+    {
+        return m_damageBounds;
+    }
+
     void Canvas::updateControl(Control * control)
     {
-        m_updateControls.insert(control);
+        // Controls waiting for their onUpdate of the running update are not requested again.
+        if (control->m_updateIndex != Control::InvalidUpdateIndex)
+        {
+            return;
+        }
+
+        control->m_updateIndex = m_updateControls.size();
+        m_updateControls.push_back(control);
     }
 
     void Canvas::resizeControl(Control * control)
     {
+        if (m_styleBatchDepth)
+        {
+            if (control->m_resizeIndex == Control::InvalidResizeIndex)
+            {
+                control->m_resizeIndex = m_batchedResizes.size();
+                m_batchedResizes.push_back(control);
+            }
+            return;
+        }
+
         Control * rootControl = control;
         Control * parent = nullptr;
 
@@ -443,13 +675,48 @@ namespace Guise
         while (parent && parent->isChildBoundsAware());
     }
 
+    void Canvas::beginStyleBatch()
+    {
+        m_styleBatchDepth++;
+    }
+
+    void Canvas::endStyleBatch()
+    {
+        if (!m_styleBatchDepth || --m_styleBatchDepth)
+        {
+            return;
+        }
+
+        // Resizing may report more resizes, which are performed directly, or batches appending to the batched resizes.
+        // Entries are cleared before resizing, so nested batches skip them and removed controls are set to nullptr.
+        for (size_t i = 0; i < m_batchedResizes.size(); i++)
+        {
+            Control * control = m_batchedResizes[i];
+            if (control)
+            {
+                m_batchedResizes[i] = nullptr;
+                control->m_resizeIndex = Control::InvalidResizeIndex;
+                resizeControl(control);
+            }
+        }
+        m_batchedResizes.clear();
+    }
+
     Canvas::Canvas(const Vector2ui32 & size, std::shared_ptr<Style::Sheet> * styleSheet) :
         m_dpi(GUISE_DEFAULT_DPI),
         m_scale(1.0f),
         m_selectedControl(nullptr),
         m_size(size),
         m_activeControl(nullptr),
-        m_hoveredControl(nullptr)
+        m_hoveredControl(nullptr),
+        m_selectOrder(0),
+        m_threadPool(&ThreadPool::getDefault()),
+        m_damaged(true),
+        m_damageBounds({ 0.0f, 0.0f }, Vector2f(size)),
+        m_styleBatchDepth(0),
+        m_taskQueue(std::make_shared<TaskQueue>()),
+        m_renderBounds({ 0.0f, 0.0f }, Vector2f(size)),
+        m_renderStatistics({ 0, 0 })
     {
         if (styleSheet != nullptr)
         {
@@ -457,25 +724,158 @@ namespace Guise
         }
         if(!m_styleSheet)
         {
-            m_styleSheet = Style::Sheet::createDefault();
+            m_styleSheet = Style::Sheet::getDefault();
         }
 
-        CanvasStyle::operator=(*m_styleSheet->getSelector("canvas"));
+        auto canvasSelector = m_styleSheet->getSelector(Style::SelectorId::Canvas);
+        if (canvasSelector)
+        {
+            CanvasStyle::operator=(*canvasSelector);
+        }
     }
 
     Control * Canvas::queryControlHit(const Vector2f & point) const
     {
-        for (auto levelIt = m_selectControlLevels.rbegin(); levelIt != m_selectControlLevels.rend(); levelIt++)
+        const size_t count = m_selectControls.size();
+        const float * minX = m_selectMinX.data();
+        const float * minY = m_selectMinY.data();
+        const float * maxX = m_selectMaxX.data();
+        const float * maxY = m_selectMaxY.data();
+
+        // Pick the hit of the highest level, most recently added within the level.
+        size_t hit = Control::InvalidSelectIndex;
+        auto testHit = [&](const size_t i)
+        {
+            if (m_selectFlags[i] && (hit == Control::InvalidSelectIndex || m_selectLevels[i] > m_selectLevels[hit] ||
+                (m_selectLevels[i] == m_selectLevels[hit] && m_selectOrders[i] > m_selectOrders[hit])))
+            {
+                hit = i;
+            }
+        };
+
+        size_t i = 0;
+    #if defined(GUISE_SSE2)
+        // Test the bounds of four controls per iteration, only hits are compared further.
+        const __m128 x = _mm_set1_ps(point.x);
+        const __m128 y = _mm_set1_ps(point.y);
+        for (; i + 4 <= count; i += 4)
         {
-            for (auto controlIt = levelIt->second.rbegin(); controlIt != levelIt->second.rend(); controlIt++)
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX + i), x), _mm_cmple_ps(x, _mm_loadu_ps(maxX + i))),
+                _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY + i), y), _mm_cmple_ps(y, _mm_loadu_ps(maxY + i))));
+
+            const int mask = _mm_movemask_ps(inside);
+            if (mask)
             {
-                if ((*controlIt)->intersects(point))
+                for (size_t lane = 0; lane < 4; lane++)
                 {
-                    return *controlIt;
+                    if (mask & (1 << lane))
+                    {
+                        testHit(i + lane);
+                    }
                 }
             }
         }
-        return nullptr;
+    #endif
+        for (; i < count; i++)
+        {
+            if (minX[i] <= point.x && point.x <= maxX[i] && minY[i] <= point.y && point.y <= maxY[i])
+            {
+                testHit(i);
+            }
+        }
+
+        return hit != Control::InvalidSelectIndex ? m_selectControls[hit] : nullptr;
+    }
+
+    void Canvas::removeSelectControl(Control * control)
+    {
+        // Swap with the last control, hit order is kept by the insertion orders.
+        const size_t index = control->m_selectIndex;
+        const size_t last = m_selectControls.size() - 1;
+        if (index != last)
+        {
+            m_selectControls[index] = m_selectControls[last];
+            m_selectMinX[index] = m_selectMinX[last];
+            m_selectMinY[index] = m_selectMinY[last];
+            m_selectMaxX[index] = m_selectMaxX[last];
+            m_selectMaxY[index] = m_selectMaxY[last];
+            m_selectLevels[index] = m_selectLevels[last];
+            m_selectOrders[index] = m_selectOrders[last];
+            m_selectFlags[index] = m_selectFlags[last];
+            m_selectControls[index]->m_selectIndex = index;
+        }
+
+        m_selectControls.pop_back();
+        m_selectMinX.pop_back();
+        m_selectMinY.pop_back();
+        m_selectMaxX.pop_back();
+        m_selectMaxY.pop_back();
+        m_selectLevels.pop_back();
+        m_selectOrders.pop_back();
+        m_selectFlags.pop_back();
+        control->m_selectIndex = Control::InvalidSelectIndex;
+    }
+
+    void Canvas::removeUpdateControl(Control * control)
+    {
+        const size_t index = control->m_updateIndex;
+        if (index == Control::InvalidUpdateIndex)
+        {
+            return;
+        }
+
+        // The index refers to the pending updates, or to the running update if the control has not been updated yet.
+        control->m_updateIndex = Control::InvalidUpdateIndex;
+        if (index < m_updateControls.size() && m_updateControls[index] == control)
+        {
+            m_updateControls[index] = nullptr;
+        }
+        else if (index < m_updatingControls.size() && m_updatingControls[index] == control)
+        {
+            m_updatingControls[index] = nullptr;
+        }
+    }
+
+    void Canvas::releaseControlReferences(Control * control)
+    {
+        if (control == m_selectedControl)
+        {
+            m_selectedControl = nullptr;
+        }
+        if (control == m_activeControl)
+        {
+            m_activeControl = nullptr;
+        }
+        if (control == m_hoveredControl)
+        {
+            m_hoveredControl = nullptr;
+        }
+    }
+
+
+    // Style batch implementations.
+    StyleBatch::StyleBatch(Canvas & canvas) :
+        m_canvas(&canvas)
+    {
+        m_canvas->beginStyleBatch();
+    }
+
+    StyleBatch::StyleBatch(Control & control) :
+        m_canvas(control.getCanvas())
+    {
+        if (m_canvas)
+        {
+            m_canvas->beginStyleBatch();
+        }
+    }
+
+    StyleBatch::~StyleBatch()
+    {
+        if (m_canvas)
+        {
+            m_canvas->endStyleBatch();
+        }
     }
 
 }
\ No newline at end of file
@@ -24,61 +24,109 @@
 */
 
 #include "guise/context.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#if defined(GUISE_PLATFORM_LINUX)
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+#endif
 
 namespace Guise
 {
 
     Context::~Context()
-    { }
+    {
+        stop();
+
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        if (m_wakeEvent)
+        {
+            ::CloseHandle(m_wakeEvent);
+        }
+    #elif defined(GUISE_PLATFORM_LINUX)
+        if (m_wakeFd >= 0)
+        {
+            ::close(m_wakeFd);
+        }
+    #endif
+    }
 
-    std::shared_ptr<Context> Context::create()
+    std::shared_ptr<Context> Context::create(const Threading threading)
     {
-        return std::shared_ptr<Context>(new Context());
+        return std::shared_ptr<Context>(new Context(threading));
     }
 
     std::shared_ptr<AppWindow> Context::addAppWindow(const std::wstring & title, const Vector2ui32 & size)
     {
         auto appWindowData = std::make_shared<AppWindowData>();
-
         Semaphore windowIsCreated;
 
-        appWindowData->m_thread = std::thread([this, &windowIsCreated, appWindowData, &title, &size]()
+        // The mutex is released before waiting for the window, the creating thread may call into the context meanwhile.
+        // Threads are started while holding it, so stop joins them and the loop thread runs the queued creation before exiting.
         {
-            appWindowData->appWindow = AppWindow::create(title, size);
-            auto appWindow = appWindowData->appWindow;
-            auto renderer = Renderer::createDefault(appWindowData->appWindow);
-            appWindowData->appWindow->setRenderer(renderer);
-            renderer->setViewportSize({0, 0}, appWindow->getSize());
-            renderer->setScale(appWindow->getScale());
-
-            windowIsCreated.notifyOne();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running)
+            {
+                return nullptr;
+            }
+            m_appWindows.insert(appWindowData);
 
-            while (1)
+            if (m_threading == Threading::SingleThread)
             {
-                auto timerStart = std::chrono::system_clock::now();
+                // Called by a window of the loop, e.g. from a signal, waiting for the loop thread would wait for itself.
+                if (m_loopThread.get_id() == std::this_thread::get_id())
+                {
+                    createLoopWindow(appWindowData, title, size);
+                    return appWindowData->appWindow;
+                }
 
-                //DWORD err = GetLastError();
-                appWindow->update();
+                m_loopTasks.push([this, &windowIsCreated, appWindowData, &title, &size]()
+                {
+                    createLoopWindow(appWindowData, title, size);
+                    windowIsCreated.notifyOne();
+                });
 
-                //err = GetLastError();
-                if (appWindow->isShowing())
+                if (!m_loopThread.joinable())
                 {
-                    appWindow->render();
+                    m_loopThread = std::thread([this]()
+                    {
+                        runLoop();
+                    });
                 }
+            }
+            else
+            {
+                appWindowData->m_thread = std::thread([this, &windowIsCreated, appWindowData, &title, &size]()
+                {
+                    createAppWindow(*appWindowData, title, size);
 
-                // = GetLastError();
+                    windowIsCreated.notifyOne();
 
-                auto timerEnd = std::chrono::system_clock::now();
-                std::chrono::duration<double> deltaTime = timerEnd - timerStart;
-                std::chrono::duration<double> frameSleepTime = getMaxFrameTime() - deltaTime;
+                    while (m_running)
+                    {
+                        auto timerStart = std::chrono::system_clock::now();
 
-                if (frameSleepTime.count() > 0.0f)
-                {
-                    std::this_thread::sleep_for(frameSleepTime);
-                }
+                        updateAppWindow(*appWindowData);
+
+                        auto timerEnd = std::chrono::system_clock::now();
+                        std::chrono::duration<double> deltaTime = timerEnd - timerStart;
+                        std::chrono::duration<double> frameSleepTime = getFrameTime(*appWindowData) - deltaTime;
+
+                        if (frameSleepTime.count() > 0.0f)
+                        {
+                            std::this_thread::sleep_for(frameSleepTime);
+                        }
+                    }
+                });
             }
-        });
+        }
 
+        if (m_threading == Threading::SingleThread)
+        {
+            wakeLoop();
+        }
         windowIsCreated.wait();
         return appWindowData->appWindow;
     }
@@ -88,11 +136,64 @@ namespace Guise
         m_maxFrameTime = frameTime;
     }
 
+    void Context::setMaxFrameTime(const std::shared_ptr<AppWindow> & appWindow, const std::chrono::duration<double> & frameTime)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto & appWindowData : m_appWindows)
+        {
+            if (appWindowData->appWindow == appWindow)
+            {
+                appWindowData->maxFrameTime = frameTime;
+                return;
+            }
+        }
+    }
+
     std::chrono::duration<double> Context::getMaxFrameTime() const
     {
         return m_maxFrameTime;
     }
 
+    Context::Threading Context::getThreading() const
+    {
+        return m_threading;
+    }
+
+    void Context::setResourceSharing(const bool share)
+    {
+        m_resourceSharing = share;
+    }
+
+    bool Context::isResourceSharing() const
+    {
+        return m_resourceSharing;
+    }
+
+    void Context::stop()
+    {
+        // Threads are joined without holding the mutex, app windows may call into the context until they stop.
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+
+            threads.push_back(std::move(m_loopThread));
+            for (auto & appWindowData : m_appWindows)
+            {
+                threads.push_back(std::move(appWindowData->m_thread));
+            }
+        }
+        wakeLoop();
+
+        for (auto & thread : threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+
     bool Context::setDpiAware()
     {
     #if defined(GUISE_PLATFORM_WINDOWS)
@@ -106,9 +207,178 @@ namespace Guise
     #endif
     }
 
-    Context::Context()
+    Context::AppWindowData::AppWindowData() :
+        maxFrameTime(std::chrono::duration<double>(0.0))
+    { }
+
+    Context::Context(const Threading threading) :
+        m_threading(threading),
+        m_running(true),
+        m_maxFrameTime(std::chrono::duration<double>(0.0)),
+        m_resourceSharing(true),
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        m_wakeEvent(threading == Threading::SingleThread ? ::CreateEvent(NULL, FALSE, FALSE, NULL) : NULL)
+    #elif defined(GUISE_PLATFORM_LINUX)
+        m_wakeFd(threading == Threading::SingleThread ? ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1)
+    #endif
+    {
+
+    }
+
+    void Context::createAppWindow(AppWindowData & appWindowData, const std::wstring & title, const Vector2ui32 & size)
     {
+        appWindowData.appWindow = AppWindow::create(title, size);
+        auto appWindow = appWindowData.appWindow;
 
+        std::shared_ptr<Renderer> renderer;
+        if (m_resourceSharing)
+        {
+            std::lock_guard<std::mutex> lock(m_shareMutex);
+            renderer = Renderer::createDefault(appWindow, m_shareRenderer);
+            if (!m_shareRenderer)
+            {
+                m_shareRenderer = renderer;
+            }
+        }
+        else
+        {
+            renderer = Renderer::createDefault(appWindow);
+        }
+
+        appWindowData.renderer = renderer;
+        appWindow->setRenderer(renderer);
+        renderer->setViewportSize({0, 0}, appWindow->getSize());
+        renderer->setScale(appWindow->getScale());
+    }
+
+    void Context::createLoopWindow(const std::shared_ptr<AppWindowData> & appWindowData, const std::wstring & title, const Vector2ui32 & size)
+    {
+        createAppWindow(*appWindowData, title, size);
+        appWindowData->nextFrame = FrameClock::now();
+        m_loopWindows.push_back(appWindowData);
+    }
+
+    void Context::updateAppWindow(AppWindowData & appWindowData)
+    {
+        auto & appWindow = appWindowData.appWindow;
+
+        // Several renderers may render on the same thread.
+        appWindowData.renderer->makeCurrent();
+        appWindow->update();
+
+        // Skip rendering of frames without any damage or running animations.
+        if (appWindow->isShowing() && appWindow->getCanvas()->needsRender())
+        {
+            appWindow->render();
+        }
+    }
+
+    std::chrono::duration<double> Context::getFrameTime(const AppWindowData & appWindowData) const
+    {
+        const std::chrono::duration<double> frameTime = appWindowData.maxFrameTime;
+        return frameTime.count() > 0.0 ? frameTime : getMaxFrameTime();
+    }
+
+    static bool hasPendingEvents(AppWindow & appWindow)
+    {
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        (void)appWindow;
+        return HIWORD(::GetQueueStatus(QS_ALLINPUT)) != 0;
+    #elif defined(GUISE_PLATFORM_LINUX)
+        return XPending(appWindow.getLinuxDisplay()) > 0;
+    #endif
+    }
+
+    void Context::runLoop()
+    {
+        while (m_running)
+        {
+            m_loopTasks.execute();
+
+            // Windows are updated once their frame time has passed, or right away when they have events.
+            auto now = FrameClock::now();
+            auto deadline = FrameClock::time_point::max();
+            // Indexed, windows may be added while updating, e.g. by a button opening a window.
+            for (size_t i = 0; i < m_loopWindows.size(); i++)
+            {
+                auto appWindowData = m_loopWindows[i];
+                if (now >= appWindowData->nextFrame || hasPendingEvents(*appWindowData->appWindow))
+                {
+                    updateAppWindow(*appWindowData);
+                    now = FrameClock::now();
+                    appWindowData->nextFrame = now + std::chrono::duration_cast<FrameClock::duration>(getFrameTime(*appWindowData));
+                }
+                deadline = std::min(deadline, appWindowData->nextFrame);
+            }
+
+            waitForEvents(deadline);
+        }
+
+        // Windows queued before stopping are still created, their callers wait for them.
+        m_loopTasks.execute();
+
+        // Only the references of the loop thread are dropped. App windows and their renderers are destroyed
+        // by whichever thread releases the last reference, e.g. the thread destroying the context.
+        m_loopWindows.clear();
+    }
+
+    void Context::waitForEvents(const FrameClock::time_point & deadline)
+    {
+        // Wait without timeout until an event arrives or the loop is woken, if no window awaits a frame.
+        int64_t timeout = -1;
+        if (deadline != FrameClock::time_point::max())
+        {
+            timeout = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - FrameClock::now()).count();
+            if (timeout <= 0)
+            {
+                return;
+            }
+            timeout = std::min(timeout, static_cast<int64_t>(std::numeric_limits<int32_t>::max()));
+        }
+
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        ::MsgWaitForMultipleObjects(1, &m_wakeEvent, FALSE, timeout < 0 ? INFINITE : static_cast<DWORD>(timeout), QS_ALLINPUT);
+    #elif defined(GUISE_PLATFORM_LINUX)
+        // One poll across the wake event and the display connections of all windows.
+        std::vector<::pollfd> fds;
+        fds.reserve(m_loopWindows.size() + 1);
+        fds.push_back({ m_wakeFd, POLLIN, 0 });
+        for (auto & appWindowData : m_loopWindows)
+        {
+            ::Display * display = appWindowData->appWindow->getLinuxDisplay();
+
+            // Events already read from the connection do not make it readable.
+            if (XEventsQueued(display, QueuedAlready) > 0)
+            {
+                return;
+            }
+            fds.push_back({ ConnectionNumber(display), POLLIN, 0 });
+        }
+
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), static_cast<int>(timeout)) > 0 && (fds[0].revents & POLLIN))
+        {
+            uint64_t value = 0;
+            while (::read(m_wakeFd, &value, sizeof(value)) > 0)
+            { }
+        }
+    #endif
+    }
+
+    void Context::wakeLoop()
+    {
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        if (m_wakeEvent)
+        {
+            ::SetEvent(m_wakeEvent);
+        }
+    #elif defined(GUISE_PLATFORM_LINUX)
+        if (m_wakeFd >= 0)
+        {
+            const uint64_t value = 1;
+            while (::write(m_wakeFd, &value, sizeof(value)) < 0 && errno == EINTR)
+            { }
+        }
+    #endif
     }
 
 }
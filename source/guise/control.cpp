@@ -36,6 +36,7 @@
 #define GUISE_CONTROL_FLAG_INPUTENABLED     0x04    // 4    0000 0100
 #define GUISE_CONTROL_FLAG_VISIBLE          0x08    // 8    0000 1000
 #define GUISE_CONTROL_FLAG_CHILDBOUNDSAWARE 0x10    // 16   0001 0000
+#define GUISE_CONTROL_FLAG_SUBTREEDIRTY     0x20    // 32   0010 0000
 
 namespace Guise
 {
@@ -44,9 +45,15 @@ namespace Guise
     Control::Control() :
         m_availableBounds(0.0f, 0.0f, 0.0f, 0.0f),
         m_bounds(0.0f, 0.0f, 0.0f, 0.0f),
+        m_subtreeBounds(0.0f, 0.0f, 0.0f, 0.0f),
+        m_subtreeSize(1),
         m_canvas(nullptr),
-        m_flags(GUISE_CONTROL_FLAG_ENABLED | GUISE_CONTROL_FLAG_INPUTENABLED | GUISE_CONTROL_FLAG_VISIBLE),
-        m_level(0)
+        m_flags(GUISE_CONTROL_FLAG_ENABLED | GUISE_CONTROL_FLAG_INPUTENABLED | GUISE_CONTROL_FLAG_VISIBLE |
+                GUISE_CONTROL_FLAG_SUBTREEDIRTY),
+        m_level(0),
+        m_selectIndex(InvalidSelectIndex),
+        m_updateIndex(InvalidUpdateIndex),
+        m_resizeIndex(InvalidResizeIndex)
     { }
 
     Control::~Control()
@@ -69,6 +76,17 @@ namespace Guise
 
     void Control::draw(RendererInterface & rendererInterface)
     {
+        // Skip subtrees outside of the rendered area of the canvas.
+        if (m_canvas)
+        {
+            if (!getSubtreeBounds().intersects(m_canvas->m_renderBounds))
+            {
+                m_canvas->m_renderStatistics.culledControls += m_subtreeSize;
+                return;
+            }
+            m_canvas->m_renderStatistics.drawnControls++;
+        }
+
         rendererInterface.setLevel(m_level);
         onRender(rendererInterface);
     }
@@ -89,6 +107,10 @@ namespace Guise
         {
             GUISE_CONTROL_SET_FLAG(GUISE_CONTROL_FLAG_ENABLED);
             onEnable();
+            if (m_canvas)
+            {
+                m_canvas->reportControlInputChange(this);
+            }
         }    
     }
 
@@ -98,6 +120,10 @@ namespace Guise
         {
             GUISE_CONTROL_UNSET_FLAG(GUISE_CONTROL_FLAG_ENABLED);
             onDisable();
+            if (m_canvas)
+            {
+                m_canvas->reportControlInputChange(this);
+            }
         }     
     }
 
@@ -109,11 +135,19 @@ namespace Guise
     void Control::enableInput()
     {
         GUISE_CONTROL_SET_FLAG(GUISE_CONTROL_FLAG_INPUTENABLED);
+        if (m_canvas)
+        {
+            m_canvas->reportControlInputChange(this);
+        }
     }
 
     void Control::disableInput()
     {
         GUISE_CONTROL_UNSET_FLAG(GUISE_CONTROL_FLAG_INPUTENABLED);
+        if (m_canvas)
+        {
+            m_canvas->reportControlInputChange(this);
+        }
     }
 
     bool Control::isInputEnabled() const
@@ -178,6 +212,11 @@ namespace Guise
         return nullptr;
     }
 
+    Control::ChildArray Control::getChildArray() const
+    {
+        return { nullptr, 0 };
+    }
+
     std::vector<std::shared_ptr<Control> > Control::getChilds()
     {
         return { };
@@ -254,7 +293,13 @@ namespace Guise
     {
         if (bounds != m_bounds)
         {
+            if (m_canvas)
+            {
+                m_canvas->reportDamage(m_bounds);
+            }
+
             m_bounds = bounds;
+            invalidateSubtree();
         
             if (m_canvas)
             {
@@ -273,6 +318,28 @@ namespace Guise
         return m_bounds;
     }
 
+    const Bounds2f & Control::getSubtreeBounds()
+    {
+        if (GUISE_CONTROL_CHECK_FLAG(GUISE_CONTROL_FLAG_SUBTREEDIRTY))
+        {
+            m_subtreeBounds = m_bounds;
+            m_subtreeSize = 1;
+            visitChilds([&](Control & child, size_t)
+            {
+                m_subtreeBounds.outerJoin(child.getSubtreeBounds());
+                m_subtreeSize += child.m_subtreeSize;
+            });
+            GUISE_CONTROL_UNSET_FLAG(GUISE_CONTROL_FLAG_SUBTREEDIRTY);
+        }
+        return m_subtreeBounds;
+    }
+
+    size_t Control::getSubtreeSize()
+    {
+        getSubtreeBounds();
+        return m_subtreeSize;
+    }
+
     float Control::getScale() const
     {
         return m_canvas ? m_canvas->getScale() : 1.0f;
@@ -299,6 +366,14 @@ namespace Guise
         }*/
     }
 
+    void Control::redraw()
+    {
+        if (m_canvas)
+        {
+            m_canvas->reportControlDamage(this);
+        }
+    }
+
     bool Control::isChildBoundsAware() const
     {
         return GUISE_CONTROL_CHECK_FLAG(GUISE_CONTROL_FLAG_CHILDBOUNDSAWARE);
@@ -316,6 +391,9 @@ namespace Guise
         }
     }
 
+    void Control::onPrepareUpdate()
+    {
+    }
     void Control::onUpdate()
     {
     }
@@ -340,6 +418,9 @@ namespace Guise
     void Control::onResize()
     {
     }
+    void Control::onStyleSheetChange(Canvas *, const Style::SelectorSet &)
+    {
+    }
 
     Bounds2f Control::scale(const Bounds2f & bounds) const
     {
@@ -369,6 +450,17 @@ namespace Guise
         }
     }
 
+    void Control::invalidateSubtree()
+    {
+        // Ancestors of dirty controls are dirty as well, stop at the first one.
+        Control * control = this;
+        while (control && !(control->m_flags & GUISE_CONTROL_FLAG_SUBTREEDIRTY))
+        {
+            control->m_flags |= GUISE_CONTROL_FLAG_SUBTREEDIRTY;
+            control = control->m_parent.lock().get();
+        }
+    }
+
     void Control::setCanvas(Canvas * canvas)
     {
         if (m_canvas != canvas)
@@ -450,6 +542,7 @@ namespace Guise
         control.setCanvas(m_canvas);
         control.release();
         control.m_parent = Control::shared_from_this();
+        invalidateSubtree();
     }
 
     void ControlContainer::releaseControl(Control & control)
@@ -459,6 +552,7 @@ namespace Guise
             m_canvas->reportControlRemove(&control);
         }
         control.m_parent.reset();
+        invalidateSubtree();
     }
 
     void ControlContainer::setCanvas(Canvas * canvas)
@@ -480,8 +574,6 @@ namespace Guise
 
     void ControlContainerSingle::setLevel(const size_t level)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         if (level == getLevel())
         {
             return;
@@ -497,29 +589,32 @@ namespace Guise
 
     std::shared_ptr<Control> ControlContainerSingle::getChild()
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return m_child;
     }
     std::shared_ptr<const Control> ControlContainerSingle::getChild() const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return m_child;
     }
 
     std::vector<std::shared_ptr<Control> > ControlContainerSingle::getChilds()
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_child)
+        {
+            return {};
+        }
         return { m_child };
     }
     std::vector<std::shared_ptr<const Control> > ControlContainerSingle::getChilds() const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_child)
+        {
+            return {};
+        }
         return { m_child };
     }
 
     void ControlContainerSingle::forEachChild(std::function<bool(std::shared_ptr<Control>, size_t)> callback)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         if (!m_child)
         {
             return;
@@ -529,7 +624,6 @@ namespace Guise
     }
     void ControlContainerSingle::forEachChild(std::function<bool(std::shared_ptr<const Control>, size_t)> callback) const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         if (!m_child)
         {
             return;
@@ -545,7 +639,6 @@ namespace Guise
             return;
         }
 
-        std::lock_guard<std::mutex> lock(m_mutex);
         if (!m_child)
         {
             return;
@@ -560,7 +653,6 @@ namespace Guise
             return;
         }
 
-        std::lock_guard<std::mutex> lock(m_mutex);
         if (!m_child)
         {
             return;
@@ -575,8 +667,6 @@ namespace Guise
         {
             Control::enable();
 
-            std::lock_guard<std::mutex> lock(m_mutex);
-
             if (m_child)
             {
                 m_child->enable();
@@ -590,8 +680,6 @@ namespace Guise
         {
             Control::disable();
 
-            std::lock_guard<std::mutex> lock(m_mutex);
-
             if (m_child)
             {
                 m_child->disable();
@@ -615,23 +703,16 @@ namespace Guise
 
         removeAll();
 
-        std::shared_ptr<Control> newChild;
+        adoptControl(*control.get());
+        m_child = control;
 
+        size_t level = getLevel();
+        if (level != 0)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            adoptControl(*control.get());
-            m_child = control;
-
-            size_t level = getLevel();
-            if (level != 0)
-            {
-                m_child->setLevel(level + 1);
-            }
-            newChild = m_child;
+            m_child->setLevel(level + 1);
         }
 
-        onAddChild(*newChild, 0);
+        onAddChild(*control, 0);
 
         return true;
     }
@@ -640,19 +721,15 @@ namespace Guise
     {
         std::shared_ptr<Control> oldChild;
 
+        if (!m_child || m_child.get() != &control)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            if (!m_child || m_child.get() != &control)
-            {
-                return false;
-            }
-
-            oldChild = m_child;
-            releaseControl(*oldChild.get());
-            m_child->setLevel(0);
-            m_child.reset();
+            return false;
         }
+
+        oldChild = m_child;
+        releaseControl(*oldChild.get());
+        m_child->setLevel(0);
+        m_child.reset();
         
         onRemoveChild(*oldChild, 0);
 
@@ -663,18 +740,14 @@ namespace Guise
     {
         std::shared_ptr<Control> oldChild;
 
+        if (!m_child || !control || m_child != control)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            if (!m_child || !control || m_child != control)
-            {
-                return false;
-            }
-
-            oldChild = m_child;
-            releaseControl(*oldChild.get());
-            m_child.reset();
+            return false;
         }
+
+        oldChild = m_child;
+        releaseControl(*oldChild.get());
+        m_child.reset();
         
         onRemoveChild(*oldChild, 0);
 
@@ -685,18 +758,14 @@ namespace Guise
     {
         std::shared_ptr<Control> oldChild;
 
+        if (!m_child)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            if (!m_child)
-            {
-                return false;
-            }
-
-            oldChild = m_child;
-            releaseControl(*oldChild.get());
-            m_child.reset();
+            return false;
         }
+
+        oldChild = m_child;
+        releaseControl(*oldChild.get());
+        m_child.reset();
         
         onRemoveChild(*oldChild, 0);
 
@@ -707,35 +776,32 @@ namespace Guise
     {
         std::shared_ptr<Control> oldChild;
 
+        if (!m_child)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            if (!m_child)
-            {
-                return 0;
-            }
-
-            oldChild = m_child;
-            releaseControl(*oldChild.get());
-            m_child.reset();
+            return 0;
         }
+
+        oldChild = m_child;
+        releaseControl(*oldChild.get());
+        m_child.reset();
         
         onRemoveChild(*oldChild, 0);
 
         return 1;
     }
 
+    Control::ChildArray ControlContainerSingle::getChildArray() const
+    {
+        return { &m_child, m_child ? size_t(1) : size_t(0) };
+    }
+
     void ControlContainerSingle::setCanvas(Canvas * canvas)
     {
         ControlContainer::setCanvas(canvas);
 
+        if (m_child)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-         
-            if (m_child)
-            {
-                setControlCanvas(m_child.get());
-            }
+            setControlCanvas(m_child.get());
         }
     }
 
@@ -748,8 +814,6 @@ namespace Guise
 
     void ControlContainerList::setLevel(const size_t level)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         if (level == getLevel())
         {
             return;
@@ -766,29 +830,24 @@ namespace Guise
 
     std::shared_ptr<Control> ControlContainerList::getChild()
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return m_childs.size() ? m_childs[0] : nullptr;
     }
     std::shared_ptr<const Control> ControlContainerList::getChild() const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return m_childs.size() ? m_childs[0] : nullptr;
     }
 
     std::vector<std::shared_ptr<Control> > ControlContainerList::getChilds()
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return m_childs;
     }
     std::vector<std::shared_ptr<const Control> > ControlContainerList::getChilds() const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return { m_childs.begin(), m_childs.end() };
     }
 
     void ControlContainerList::forEachChild(std::function<bool(std::shared_ptr<Control>, size_t)> callback)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         size_t index = 0;
         for (auto & child : m_childs)
         {
@@ -801,7 +860,6 @@ namespace Guise
     }
     void ControlContainerList::forEachChild(std::function<bool(std::shared_ptr<const Control>, size_t)> callback) const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
         size_t index = 0;
         for (auto & child : m_childs)
         {
@@ -815,8 +873,6 @@ namespace Guise
 
     void ControlContainerList::forEachChild(size_t position, size_t count, std::function<bool(std::shared_ptr<Control>, size_t)> callback)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         if (count == 0 || position >= m_childs.size())
         {
             return;
@@ -838,8 +894,6 @@ namespace Guise
 
     void ControlContainerList::forEachChild(size_t position, size_t count, std::function<bool(std::shared_ptr<const Control>, size_t)> callback) const
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         if (count == 0 || position >= m_childs.size())
         {
             return;
@@ -867,8 +921,6 @@ namespace Guise
         {
             Control::enable();
 
-            std::lock_guard<std::mutex> lock(m_mutex);
-
             for (auto & child : m_childs)
             {
                 child->enable();
@@ -882,8 +934,6 @@ namespace Guise
         {
             Control::disable();
 
-            std::lock_guard<std::mutex> lock(m_mutex);
-
             for (auto & child : m_childs)
             {
                 child->disable();
@@ -907,25 +957,21 @@ namespace Guise
 
         size_t newIndex = index;
 
+        adoptControl(*control.get());
+        if (index >= m_childs.size())
         {
-            std::lock_guard<std::mutex> lock(m_mutex);          
-
-            adoptControl(*control.get());
-            if (index >= m_childs.size())
-            {
-                newIndex = m_childs.size();
-                m_childs.push_back(control);
-            }
-            else
-            {
-                m_childs.insert(m_childs.begin() + index, control);
-            }
+            newIndex = m_childs.size();
+            m_childs.push_back(control);
+        }
+        else
+        {
+            m_childs.insert(m_childs.begin() + index, control);
+        }
 
-            size_t level = getLevel();
-            if (level != 0)
-            {
-                control->setLevel(level + 1);
-            }
+        size_t level = getLevel();
+        if (level != 0)
+        {
+            control->setLevel(level + 1);
         }
 
         onAddChild(*control, newIndex);
@@ -938,20 +984,16 @@ namespace Guise
         std::shared_ptr<Control> foundControl;
         size_t index = 0;
 
+        for (auto it = m_childs.begin(); it != m_childs.end(); it++)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            for (auto it = m_childs.begin(); it != m_childs.end(); it++)
+            if (it->get() == &control)
             {
-                if (it->get() == &control)
-                {
-                    foundControl = *it;
-                    releaseControl(*it->get());
-                    m_childs.erase(it);
-                    break;
-                }
-                index++;
+                foundControl = *it;
+                releaseControl(*it->get());
+                m_childs.erase(it);
+                break;
             }
+            index++;
         }
 
         if (foundControl)
@@ -967,20 +1009,16 @@ namespace Guise
         std::shared_ptr<Control> foundControl;
         size_t index = 0;
 
+        for (auto it = m_childs.begin(); it != m_childs.end(); it++)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            for (auto it = m_childs.begin(); it != m_childs.end(); it++)
+            if (*it == control)
             {
-                if (*it == control)
-                {
-                    foundControl = *it;
-                    releaseControl(*control);
-                    m_childs.erase(it);
-                    break;
-                }
-                index++;
+                foundControl = *it;
+                releaseControl(*control);
+                m_childs.erase(it);
+                break;
             }
+            index++;
         }
 
         if (foundControl)
@@ -996,19 +1034,14 @@ namespace Guise
     {
         std::shared_ptr<Control> foundControl;
 
+        if (index >= m_childs.size())
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            if (index >= m_childs.size())
-            {
-                return false;
-            }
-
-            foundControl = m_childs.at(index);
-            releaseControl(*foundControl);
-            m_childs.erase(m_childs.begin() + index);
+            return false;
         }
 
+        foundControl = m_childs.at(index);
+        releaseControl(*foundControl);
+        m_childs.erase(m_childs.begin() + index);
 
         onRemoveChild(*foundControl, index);
 
@@ -1018,16 +1051,11 @@ namespace Guise
     size_t ControlContainerList::removeAll()
     {
         std::vector<std::shared_ptr<Control> > oldChilds;
+        oldChilds.swap(m_childs);
 
+        for (auto & child : oldChilds)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            oldChilds = m_childs;
-
-            for (auto & child : m_childs)
-            {
-                releaseControl(*child);
-            }
-            m_childs.clear();
+            releaseControl(*child);
         }
 
         size_t index = 0;
@@ -1040,17 +1068,18 @@ namespace Guise
         return oldChilds.size();
     }
 
+    Control::ChildArray ControlContainerList::getChildArray() const
+    {
+        return { m_childs.data(), m_childs.size() };
+    }
+
     void ControlContainerList::setCanvas(Canvas * canvas)
     {
         ControlContainer::setCanvas(canvas);
 
+        for (auto & child : m_childs)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            for (auto & child : m_childs)
-            {
-                setControlCanvas(child.get());
-            }
+            setControlCanvas(child.get());
         }
     }
 
@@ -33,7 +33,7 @@ namespace Guise
     // Button implementations.
     std::shared_ptr<Button> Button::create()
     {
-        return std::shared_ptr<Button>(new Button());
+        return createControl<Button>();
     }
 
     bool Button::add(const std::shared_ptr<Control> & control, const size_t)
@@ -58,11 +58,11 @@ namespace Guise
 
     Style::ParentPaintRectStyle & Button::getStyleDisabled()
     {
-        return m_styleHover;
+        return m_styleDisabled;
     }
     const Style::ParentPaintRectStyle & Button::getStyleDisabled() const
     {
-        return m_styleHover;
+        return m_styleDisabled;
     }
 
     Style::ParentPaintRectStyle & Button::getStyleHover()
@@ -87,15 +87,12 @@ namespace Guise
         {
             if (!m_pressed)
             {
-                if (getBounds().intersects(e.position))
+                const bool hover = getBounds().intersects(e.position);
+                setState(Style::State::Hover, hover);
+                if (hover)
                 {
-                    setCurrentStyle(m_styleHover);
                     onHover(e.position);
                 }
-                else
-                {
-                    setCurrentStyle(this);
-                }
             }
         }
         break;
@@ -109,7 +106,7 @@ namespace Guise
             if (getBounds().intersects(e.position))
             {
                 m_pressed = true;
-                setCurrentStyle(m_styleActive);
+                setState(Style::State::Active, true);
 
                 onPress(e.position);
             }
@@ -123,16 +120,14 @@ namespace Guise
             }
 
             m_pressed = false;
+            setState(Style::State::Active, false);
 
-            if (getBounds().intersects(e.position))
+            const bool hover = getBounds().intersects(e.position);
+            setState(Style::State::Hover, hover);
+            if (hover)
             {
-                setCurrentStyle(m_styleHover);
                 onRelease(e.position);
             }
-            else
-            {
-                setCurrentStyle(this);
-            }
         }
         break;
         default: break;
@@ -148,6 +143,9 @@ namespace Guise
         m_styleDisabled(this, this),
         m_styleHover(this, this)
     {
+        setStateStyle(Style::State::Hover, m_styleHover);
+        setStateStyle(Style::State::Active, m_styleActive);
+        setStateStyle(Style::State::Disabled, m_styleDisabled);
     }
 
     void Button::onAddChild(Control & control, const size_t)
@@ -157,29 +155,48 @@ namespace Guise
 
     void Button::onCanvasChange(Canvas * canvas)
     {
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("button"));
-        m_styleActive.updateEmptyProperties(canvas->getStyleSheet()->getSelector("button:active"));
-        m_styleDisabled.updateEmptyProperties(canvas->getStyleSheet()->getSelector("button:disabled"));
-        m_styleHover.updateEmptyProperties(canvas->getStyleSheet()->getSelector("button:hover"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::Button));
+        m_styleActive.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::ButtonActive));
+        m_styleDisabled.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::ButtonDisabled));
+        m_styleHover.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::ButtonHover));
+    }
+
+    void Button::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
+    {
+        if (!changed.containsAny({
+            Style::SelectorId::Button,
+            Style::SelectorId::ButtonActive,
+            Style::SelectorId::ButtonDisabled,
+            Style::SelectorId::ButtonHover }))
+        {
+            return;
+        }
+
+        resetSheetProperties();
+        m_styleActive.resetSheetProperties();
+        m_styleDisabled.resetSheetProperties();
+        m_styleHover.resetSheetProperties();
+        onCanvasChange(canvas);
+        resize();
     }
 
     void Button::onDisable()
     {
-        setCurrentStyle(m_styleDisabled);
+        setState(Style::State::Disabled, true);
     }
 
     void Button::onEnable()
     {
-        setCurrentStyle(this);
+        setState(Style::State::Disabled, false);
     }
 
     void Button::onRender(RendererInterface & rendererInterface)
     {
         rendererInterface.drawRect(getBounds(), getCurrentStyle());
 
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
-            child->draw(rendererInterface);
+            child.draw(rendererInterface);
             return true;
         });
     }
@@ -188,9 +205,9 @@ namespace Guise
     {
         setBounds(calcStyledBounds(getCurrentStyle(), getBounds(), getScale()));
 
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
-            child->setBounds(getBounds().cutEdges(scale(getCurrentStyle().getPadding())));
+            child.setBounds(getBounds().cutEdges(scale(getCurrentStyle().getPadding())));
             return true;
         });
     }
@@ -33,7 +33,7 @@ namespace Guise
     // Button implementations.
     std::shared_ptr<Checkbox> Checkbox::create()
     {
-        return std::shared_ptr<Checkbox>(new Checkbox());
+        return createControl<Checkbox>();
     }
 
     Style::PaintRectStyle & Checkbox::getCheckedStyle()
@@ -90,6 +90,11 @@ namespace Guise
     {
         switch (e.type)
         {
+            case Input::EventType::MouseMove:
+            {
+                setState(Style::State::Hover, getBounds().intersects(e.position));
+            }
+            break;
             case Input::EventType::MouseRelease:
             {
                 if (e.button != 0)
@@ -100,16 +105,7 @@ namespace Guise
                 if (getBounds().intersects(e.position))
                 {
                     m_checked = !m_checked;
-
-                    if (m_checked)
-                    {
-                        setCurrentStyle(m_styleChecked);
-                    }
-                    else
-                    {
-                        setCurrentStyle(this);
-                    }
-
+                    setState(Style::State::Checked, m_checked);
                 }
 
                 update();
@@ -130,26 +126,54 @@ namespace Guise
         m_styleDisabled(this, this),
         m_styleHover(this, this)
     {
+        setStateStyle(Style::State::Hover, m_styleHover);
+        setStateStyle(Style::State::Checked, m_styleChecked);
+        setStateStyle(Style::State::Checked | Style::State::Hover, m_styleCheckedHover);
+        setStateStyle(Style::State::Disabled, m_styleDisabled);
+        setStateStyle(Style::State::Checked | Style::State::Disabled, m_styleCheckedDisabled);
     }
 
     void Checkbox::onCanvasChange(Canvas * canvas)
     {
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("checkbox"));
-        m_styleChecked.updateEmptyProperties(canvas->getStyleSheet()->getSelector("checkbox:checked"));
-        m_styleCheckedHover.updateEmptyProperties(canvas->getStyleSheet()->getSelector("checkbox:checked:hover"));
-        m_styleCheckedDisabled.updateEmptyProperties(canvas->getStyleSheet()->getSelector("checkbox:checked:disabled"));
-        m_styleDisabled.updateEmptyProperties(canvas->getStyleSheet()->getSelector("checkbox:disabled"));
-        m_styleHover.updateEmptyProperties(canvas->getStyleSheet()->getSelector("checkbox:hover"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::Checkbox));
+        m_styleChecked.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::CheckboxChecked));
+        m_styleCheckedHover.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::CheckboxCheckedHover));
+        m_styleCheckedDisabled.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::CheckboxCheckedDisabled));
+        m_styleDisabled.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::CheckboxDisabled));
+        m_styleHover.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::CheckboxHover));
+    }
+
+    void Checkbox::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
+    {
+        if (!changed.containsAny({
+            Style::SelectorId::Checkbox,
+            Style::SelectorId::CheckboxChecked,
+            Style::SelectorId::CheckboxCheckedHover,
+            Style::SelectorId::CheckboxCheckedDisabled,
+            Style::SelectorId::CheckboxDisabled,
+            Style::SelectorId::CheckboxHover }))
+        {
+            return;
+        }
+
+        resetSheetProperties();
+        m_styleChecked.resetSheetProperties();
+        m_styleCheckedHover.resetSheetProperties();
+        m_styleCheckedDisabled.resetSheetProperties();
+        m_styleDisabled.resetSheetProperties();
+        m_styleHover.resetSheetProperties();
+        onCanvasChange(canvas);
+        resize();
     }
 
     void Checkbox::onDisable()
     {
-        setCurrentStyle(m_styleDisabled);
+        setState(Style::State::Disabled, true);
     }
 
     void Checkbox::onEnable()
     {
-        setCurrentStyle(this);
+        setState(Style::State::Disabled, false);
     }
 
     void Checkbox::onRender(RendererInterface & rendererInterface)
@@ -32,7 +32,7 @@ namespace Guise
     // Vertical grid implementations.
     std::shared_ptr<HorizontalGrid> HorizontalGrid::create()
     {
-        return std::shared_ptr<HorizontalGrid>(new HorizontalGrid());
+        return createControl<HorizontalGrid>();
     }
 
     Style::ParentRectStyle & HorizontalGrid::getSlotStyle()
@@ -68,8 +68,21 @@ namespace Guise
 
     void HorizontalGrid::onCanvasChange(Canvas * canvas)
     {
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("horizontal-grid"));
-        m_slotStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector("horizontal-grid-slot"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::HorizontalGrid));
+        m_slotStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::HorizontalGridSlot));
+    }
+
+    void HorizontalGrid::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
+    {
+        if (!changed.containsAny({ Style::SelectorId::HorizontalGrid, Style::SelectorId::HorizontalGridSlot }))
+        {
+            return;
+        }
+
+        resetSheetProperties();
+        m_slotStyle.resetSheetProperties();
+        onCanvasChange(canvas);
+        resize();
     }
 
     void HorizontalGrid::onRemoveChild(Control &, const size_t index)
@@ -85,9 +98,9 @@ namespace Guise
     {
         //rendererInterface.drawQuad(getBounds(), Vector4f(0.0f, 0.0f, 1.0f, 0.4f));
 
-        forEachChild(0, m_childRenderCount, [&](std::shared_ptr<Control> child, size_t)
+        visitChilds(0, m_childRenderCount, [&](Control & child, size_t)
         {
-            child->draw(rendererInterface);
+            child.draw(rendererInterface);
             return true;
         });
     }
@@ -107,12 +120,12 @@ namespace Guise
 
         m_childRenderCount = 0;
         
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
             auto cutBoundsLeft = Bounds2f(boundsLeft).cutEdges(slotPadding);
-            child->setBounds(cutBoundsLeft);
+            child.setBounds(cutBoundsLeft);
 
-            auto childBounds = child->getBounds();
+            auto childBounds = child.getBounds();
 
             float extraWidth = std::max(childBounds.position.x - cutBoundsLeft.position.x, 0.0f);
             auto childWidth = std::max(childBounds.size.x + extraWidth, 0.0f);
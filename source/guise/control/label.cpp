@@ -35,12 +35,12 @@ namespace Guise
     // Button implementations.
     std::shared_ptr<Label> Label::create(const std::wstring & text)
     {
-        return std::shared_ptr<Label>(new Label(text));
+        return createControl<Label>(text);
     }
 
     std::shared_ptr<Label> Label::create(const std::string & font, const std::wstring & text)
     {
-        return std::shared_ptr<Label>(new Label(font, text));
+        return createControl<Label>(font, text);
     }
 
     std::shared_ptr<Font> Label::getFont() const
@@ -58,6 +58,36 @@ namespace Guise
         return ControlType::Label;
     }
 
+    bool Label::getDistanceField() const
+    {
+        return m_distanceField;
+    }
+
+    void Label::setDistanceField(const bool distanceField)
+    {
+        if (distanceField != m_distanceField)
+        {
+            m_distanceField = distanceField;
+            m_changedText = true;
+            update();
+        }
+    }
+
+    bool Label::getWordWrap() const
+    {
+        return m_wordWrap;
+    }
+
+    void Label::setWordWrap(const bool wordWrap)
+    {
+        if (wordWrap != m_wordWrap)
+        {
+            m_wordWrap = wordWrap;
+            m_changedText = true;
+            update();
+        }
+    }
+
     void Label::setText(const std::wstring & text)
     {
         if (text != m_text)
@@ -71,23 +101,32 @@ namespace Guise
 
     Label::Label(const std::wstring & text) :        
         Style::FontStyle(this, nullptr),
+        m_changedLayout(false),
         m_changedText(true),
+        m_distanceField(false),
         m_dpi(0),
-        m_fontSequence(m_font),
+        m_layoutData(nullptr),
+        m_layoutSize(0, 0),
+        m_preparedText(false),
         m_text(text),
-        m_texture(nullptr),
-        m_textureSize(0, 0)
+        m_textRun(nullptr),
+        m_wordWrap(false)
     {
     }
 
     Label::Label(const std::string & font, const std::wstring & text) :
         Style::FontStyle(this, nullptr),
+        m_changedLayout(false),
         m_changedText(true),
+        m_distanceField(false),
         m_dpi(0),
         m_font(FontLibrary::get(font)),
-        m_fontSequence(m_font),
+        m_layoutData(nullptr),
+        m_layoutSize(0, 0),
+        m_preparedText(false),
         m_text(text),
-        m_textureSize(0, 0)
+        m_textRun(nullptr),
+        m_wordWrap(false)
     {
     }
 
@@ -95,65 +134,175 @@ namespace Guise
     {
         m_dpi = canvas->getDpi();
 
-        // We need to get rid of old connection...
-        canvas->onDpiChange.connectAnonymously([this](uint32_t dpi)
+        // Replacing the connection disconnects it from the previous canvas.
+        m_dpiConnection = canvas->onDpiChange.connectAnonymously([this](uint32_t dpi)
         {
             m_dpi = dpi;
             m_changedText = true;
             update();
         });
 
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("label"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::Label));
         m_font = FontLibrary::get(getFontFamily());
+        m_changedText = true;
 
         update();
     }
 
-    void Label::onRender(RendererInterface & rendererInterface)
+    void Label::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
     {
-        if (m_changedText)
+        if (!changed.contains(Style::SelectorId::Label))
         {
-            m_changedText = false;
+            return;
+        }
+
+        resetSheetProperties();
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::Label));
+        m_font = FontLibrary::get(getFontFamily());
+        m_changedText = true;
 
-            if (m_loadData)
+        update();
+    }
+
+    void Label::onRender(RendererInterface & rendererInterface)
+    {
+        if (m_wordWrap)
+        {
+            if (m_layoutData)
             {
-                if (!m_texture)
+                if (!m_layoutTexture)
                 {
-                    m_texture = rendererInterface.createTexture();
+                    m_layoutTexture = rendererInterface.createTexture();
                 }
 
-                m_texture->load(m_loadData.get(), Texture::PixelFormat::RGBA8, m_textureSize);
-                m_loadData.reset();
+                m_layoutTexture->load(m_layoutData, Texture::PixelFormat::RGBA8, m_layoutSize);
+                m_layoutData = nullptr;
             }
+
+            if (m_layoutTexture && m_layoutSize.x && m_layoutSize.y)
+            {
+                rendererInterface.drawQuad(getBounds(), m_layoutTexture, getFontColor());
+            }
+            return;
+        }
+
+        if (!m_textRun)
+        {
+            return;
+        }
+
+        auto texture = m_textRun->getTexture(rendererInterface);
+        if (!texture)
+        {
+            return;
         }
 
-        if (m_texture)
+        if (m_textRun->isDistanceField())
+        {
+            rendererInterface.drawDistanceFieldQuad(getBounds(), texture, getFontColor());
+        }
+        else
         {
-            rendererInterface.drawQuad(getBounds(), m_texture, getFontColor());
+            rendererInterface.drawQuad(getBounds(), texture, getFontColor());
         }
     }
 
     void Label::onResize()
     {
-        setBounds({ getBounds().position, m_textureSize });
+        if (m_wordWrap)
+        {
+            if (m_layout.setWidth(getWrapWidth()) || m_changedLayout)
+            {
+                updateLayoutBitmap();
+            }
+
+            setBounds({ getBounds().position, m_layoutSize });
+            return;
+        }
+
+        if (m_textRun && m_textRun->isDistanceField())
+        {
+            const float scale = FontSequence::getDistanceFieldScale(static_cast<uint32_t>(getFontSize()), m_dpi);
+            const Vector2f size = Vector2f(static_cast<float>(m_textRun->getSize().x), static_cast<float>(m_textRun->getSize().y)) * scale;
+            setBounds({ getBounds().position, size });
+            return;
+        }
+
+        const Vector2<size_t> size = m_textRun ? m_textRun->getSize() : Vector2<size_t>(0, 0);
+        setBounds({ getBounds().position, size });
     }
 
-    void Label::onUpdate()
+    void Label::onPrepareUpdate()
     {
-        if (m_changedText)
+        // Replaced runs and textures wait for onUpdate, they must not be destroyed without the renderer context.
+        if (!m_changedText || m_releasedTextRun || m_releasedLayoutTexture)
         {
-            m_fontSequence.createSequence(m_text, getFontSize(), m_dpi);
+            return;
+        }
 
-            m_loadData.reset();
-            if (m_fontSequence.createBitmapRgba(m_loadData, m_textureSize))
-            {
-                resize();
-            }
-            else
+        m_changedText = false;
+        m_preparedText = true;
+        m_releasedTextRun = std::move(m_textRun);
+
+        if (m_wordWrap)
+        {
+            // Wrapped text is laid out per label and not shared via the text run cache.
+            m_layout = TextLayout(m_font);
+            m_layout.create(m_text, static_cast<uint32_t>(getFontSize()), m_dpi, getWrapWidth());
+            updateLayoutBitmap();
+        }
+        else
+        {
+            m_layout = TextLayout();
+            m_layoutData = nullptr;
+            m_releasedLayoutTexture = std::move(m_layoutTexture);
+
+            // Labels with equal text, font, size and dpi share the same run and texture.
+            // Distance field runs are shared regardless of size and dpi.
+            m_textRun = m_distanceField ?
+                TextRunCache::getDistanceField(m_font, m_text) :
+                TextRunCache::get(m_font, m_text, static_cast<uint32_t>(getFontSize()), m_dpi);
+            if (!m_textRun->isValid())
             {
-                m_changedText = false;
+                // Invalid runs never create textures.
+                m_textRun.reset();
             }
         }
     }
 
+    void Label::onUpdate()
+    {
+        // Called by the thread of the renderer, deleting textures of released runs is safe.
+        m_releasedTextRun.reset();
+        m_releasedLayoutTexture.reset();
+
+        // Text changed after being prepared, or preparation was skipped while waiting for the release.
+        if (m_changedText)
+        {
+            onPrepareUpdate();
+            m_releasedTextRun.reset();
+            m_releasedLayoutTexture.reset();
+        }
+
+        if (m_preparedText)
+        {
+            m_preparedText = false;
+            resize();
+        }
+    }
+
+    int32_t Label::getWrapWidth() const
+    {
+        // Do not wrap before the parent has given the label any width.
+        const float width = getAvailableBounds().size.x;
+        return width > 0.0f ? static_cast<int32_t>(width) : std::numeric_limits<int32_t>::max();
+    }
+
+    void Label::updateLayoutBitmap()
+    {
+        m_changedLayout = false;
+        m_layoutSize = { 0, 0 };
+        m_layoutData = m_layout.createBitmapRgba(m_layoutSize);
+    }
+
 }
\ No newline at end of file
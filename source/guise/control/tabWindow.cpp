@@ -33,7 +33,7 @@ namespace Guise
     // Button implementations.
     std::shared_ptr<TabWindow> TabWindow::create()
     {
-        return std::shared_ptr<TabWindow>(new TabWindow());
+        return createControl<TabWindow>();
     }
 
     Style::ParentPaintRectStyle & TabWindow::getStyleTab()
@@ -68,18 +68,31 @@ namespace Guise
 
     void TabWindow::onCanvasChange(Canvas * canvas)
     {
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("tab-window"));
-        m_styleTab.updateEmptyProperties(canvas->getStyleSheet()->getSelector("tab-window-tab"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::TabWindow));
+        m_styleTab.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::TabWindowTab));
     }    
 
+    void TabWindow::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
+    {
+        if (!changed.containsAny({ Style::SelectorId::TabWindow, Style::SelectorId::TabWindowTab }))
+        {
+            return;
+        }
+
+        resetSheetProperties();
+        m_styleTab.resetSheetProperties();
+        onCanvasChange(canvas);
+        resize();
+    }
+
     void TabWindow::onRender(RendererInterface & rendererInterface)
     {
         rendererInterface.drawRect(m_bodyBounds, *this);
         rendererInterface.drawRect(m_tabBounds, m_styleTab);
 
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
-            child->draw(rendererInterface);
+            child.draw(rendererInterface);
             return true;
         });
     }
@@ -98,9 +111,9 @@ namespace Guise
         m_tabBounds.position += scale(m_styleTab.getPosition());
 
         auto childBounds = Bounds2f(m_bodyBounds).cutEdges(scale(getPadding()));
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
-            child->setBounds(childBounds);
+            child.setBounds(childBounds);
             return true;
         });
     }
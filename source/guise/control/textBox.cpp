@@ -34,7 +34,7 @@ namespace Guise
     // Text box implementations.
     std::shared_ptr<TextBox> TextBox::create()
     {
-        return std::shared_ptr<TextBox>(new TextBox());
+        return createControl<TextBox>();
     }
 
     const std::wstring & TextBox::getText() const
@@ -353,6 +353,7 @@ namespace Guise
         m_cursorIndex(0),
         m_cursorSelectIndex(0),
         m_dpi(0),
+        m_loadData(nullptr),
         m_mousePressed(false),
         m_textBounds(0.0f, 0.0f, 0.0f, 0.0f),
         m_textureSize(0, 0)
@@ -363,18 +364,39 @@ namespace Guise
     {
         m_dpi = canvas->getDpi();
 
-        // We need to get rid of old connection...
-        canvas->onDpiChange.connectAnonymously([this](uint32_t dpi)
+        // Replacing the connection disconnects it from the previous canvas.
+        m_dpiConnection = canvas->onDpiChange.connectAnonymously([this](uint32_t dpi)
         {
             m_dpi = dpi;
             m_changedText = true;
             update();
         });
 
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("text-box"));
-        m_textStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector("text-box-text"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::TextBox));
+        m_textStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::TextBoxText));
         m_font = FontLibrary::get(m_textStyle.getFontFamily());
         m_fontSequence = FontSequence(m_font);
+        m_loadData = nullptr;
+        m_changedText = true;
+    }
+
+    void TextBox::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
+    {
+        if (!changed.containsAny({ Style::SelectorId::TextBox, Style::SelectorId::TextBoxText }))
+        {
+            return;
+        }
+
+        resetSheetProperties();
+        m_textStyle.resetSheetProperties();
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::TextBox));
+        m_textStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::TextBoxText));
+        m_font = FontLibrary::get(m_textStyle.getFontFamily());
+        m_fontSequence = FontSequence(m_font);
+        m_loadData = nullptr;
+        m_changedText = true;
+
+        resize();
     }
 
     void TextBox::onDisable()
@@ -396,8 +418,8 @@ namespace Guise
                     m_texture = rendererInterface.createTexture();
                 }
 
-                m_texture->load(m_loadData.get(), Texture::PixelFormat::RGBA8, m_textureSize);
-                m_loadData.reset();
+                m_texture->load(m_loadData, Texture::PixelFormat::RGBA8, m_textureSize);
+                m_loadData = nullptr;
             }
         }
 
@@ -416,7 +438,16 @@ namespace Guise
         {
             // Render cursor.
             std::chrono::duration<double> duration = std::chrono::system_clock::now() - m_cursorBlinkTimer;            
-            if ((static_cast<int>(duration.count() * 1000.0f) % 1000) < 500)
+            const int blinkTime = static_cast<int>(duration.count() * 1000.0f) % 1000;
+
+            // Frames are only rendered on damage, redraw again when the cursor toggles.
+            Canvas * canvas = getCanvas();
+            if (canvas)
+            {
+                canvas->scheduleRedraw(this, canvas->getFrameClock().getTime() + (static_cast<double>(500 - (blinkTime % 500)) / 1000.0));
+            }
+
+            if (blinkTime < 500)
             {
                 Bounds2f cursorBounds = getBounds().cutEdges(scale(getPadding()));
                 cursorBounds.position.x = getBounds().position.x + getCursorPosition(m_cursorIndex);
@@ -460,8 +491,8 @@ namespace Guise
         {
             m_fontSequence.createSequence(m_text, m_textStyle.getFontSize(), m_dpi);
 
-            m_loadData.reset();
-            if (m_fontSequence.createBitmapRgba(m_loadData, m_textureSize))
+            m_loadData = m_fontSequence.createBitmapRgba(m_textureSize);
+            if (m_loadData)
             {
                 calcTextBounds();
             }
@@ -487,6 +518,7 @@ namespace Guise
         m_cursorSelectIndex = 0;
     
         m_cursorBlinkTimer = std::chrono::system_clock::now();     
+        redraw();
     }
 
     bool TextBox::eraseSelected()
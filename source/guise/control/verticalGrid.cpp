@@ -32,7 +32,7 @@ namespace Guise
     // Vertical grid implementations.
     std::shared_ptr<VerticalGrid> VerticalGrid::create()
     {
-        return std::shared_ptr<VerticalGrid>(new VerticalGrid());
+        return createControl<VerticalGrid>();
     }    
 
     Style::ParentRectStyle & VerticalGrid::getSlotStyle()
@@ -68,8 +68,21 @@ namespace Guise
 
     void VerticalGrid::onCanvasChange(Canvas * canvas)
     {
-        updateEmptyProperties(canvas->getStyleSheet()->getSelector("vertical-grid"));
-        m_slotStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector("vertical-grid-slot"));
+        updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::VerticalGrid));
+        m_slotStyle.updateEmptyProperties(canvas->getStyleSheet()->getSelector(Style::SelectorId::VerticalGridSlot));
+    }
+
+    void VerticalGrid::onStyleSheetChange(Canvas * canvas, const Style::SelectorSet & changed)
+    {
+        if (!changed.containsAny({ Style::SelectorId::VerticalGrid, Style::SelectorId::VerticalGridSlot }))
+        {
+            return;
+        }
+
+        resetSheetProperties();
+        m_slotStyle.resetSheetProperties();
+        onCanvasChange(canvas);
+        resize();
     }
 
     void VerticalGrid::onRemoveChild(Control &, const size_t index)
@@ -83,9 +96,9 @@ namespace Guise
 
     void VerticalGrid::onRender(RendererInterface & rendererInterface)
     {
-        forEachChild(0, m_childRenderCount, [&](std::shared_ptr<Control> child, size_t)
+        visitChilds(0, m_childRenderCount, [&](Control & child, size_t)
         {
-            child->draw(rendererInterface);
+            child.draw(rendererInterface);
             return true;
         });
     }
@@ -105,12 +118,12 @@ namespace Guise
 
         m_childRenderCount = 0;
 
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
             auto cutBoundsLeft = Bounds2f(boundsLeft).cutEdges(slotPadding);
-            child->setBounds(cutBoundsLeft);
+            child.setBounds(cutBoundsLeft);
 
-            auto childBounds = child->getBounds();
+            auto childBounds = child.getBounds();
 
             float extraHeight = std::max(childBounds.position.y - cutBoundsLeft.position.y, 0.0f);
             auto childHeight = std::max(childBounds.size.y + extraHeight, 0.0f);
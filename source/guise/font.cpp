@@ -24,12 +24,18 @@
 */
 
 #include "guise/font.hpp"
+#include "guise/fontIndex.hpp"
+#include "guise/renderer.hpp"
+#include "guise/utility/bitmap.hpp"
 #include <map>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 #include <fstream>
 #include <limits>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include "freetype/FreeTypeAmalgam.h"
 
@@ -62,23 +68,56 @@ namespace Guise
             baseline(baseline),
             horiAdvance(horiAdvance),
             horiBearingX(horiBearingX),
-            horiBearingY(horiBearingY)
+            horiBearingY(horiBearingY),
+            buffer(bitmapGlyph->bitmap.buffer),
+            width(static_cast<int32_t>(bitmapGlyph->bitmap.width)),
+            rows(static_cast<int32_t>(bitmapGlyph->bitmap.rows)),
+            pitch(std::abs(bitmapGlyph->bitmap.pitch))
+        { }
+
+        /**
+        * Distance field glyph, owning its bitmap.
+        */
+        Glyph(const FT_UInt index, std::vector<uint8_t> && distanceField, const int32_t width, const int32_t rows,
+              const FT_Pos baseline, const FT_Pos horiAdvance, const FT_Pos horiBearingX, const FT_Pos horiBearingY) :
+            index(index),
+            bitmapGlyph(nullptr),
+            baseline(baseline),
+            horiAdvance(horiAdvance),
+            horiBearingX(horiBearingX),
+            horiBearingY(horiBearingY),
+            distanceField(std::move(distanceField)),
+            buffer(this->distanceField.data()),
+            width(width),
+            rows(rows),
+            pitch(width)
         { }
 
         ~Glyph()
         {
-            FT_Done_Glyph(reinterpret_cast<FT_Glyph>(bitmapGlyph));
+            if (bitmapGlyph)
+            {
+                FT_Done_Glyph(reinterpret_cast<FT_Glyph>(bitmapGlyph));
+            }
         }
 
-        FT_UInt         index;
-        FT_BitmapGlyph  bitmapGlyph;
-        FT_Pos          baseline;
-        FT_Pos          horiAdvance;
-        FT_Pos          horiBearingX;
-        FT_Pos          horiBearingY;
+        FT_UInt                 index;
+        FT_BitmapGlyph          bitmapGlyph;
+        FT_Pos                  baseline;
+        FT_Pos                  horiAdvance;
+        FT_Pos                  horiBearingX;
+        FT_Pos                  horiBearingY;
+        std::vector<uint8_t>    distanceField;
+        const uint8_t *         buffer;     ///< Top-down coverage or distance values.
+        int32_t                 width;
+        int32_t                 rows;
+        int32_t                 pitch;
 
     };
 
+    static const uint32_t g_distanceFieldSize = 48;     ///< Pixel size of em, distance field glyphs are rasterized at.
+    static const uint32_t g_distanceFieldSpread = 6;    ///< Distance range in pixels, at distance field size.
+
     // Font implementations.
     struct Font::Impl
     {
@@ -141,12 +180,69 @@ namespace Guise
             return newIt.first->second.get();
         }
 
+        /**
+        * Get distance field glyph, rasterized once at g_distanceFieldSize and shared by all sizes.
+        * The face must be set to the distance field size.
+        */
+        Glyph * getDistanceGlyph(const wchar_t character)
+        {
+            // Height 0 is never used by bitmap glyphs.
+            auto mapIndex = getGlyphIndex(character, 0);
+
+            auto it = glyphs.find(mapIndex);
+            if (it != glyphs.end())
+            {
+                return it->second.get();
+            }
+
+            FT_UInt index = 0;
+            if ((index = FT_Get_Char_Index(face, static_cast<FT_ULong>(character))) == 0)
+            {
+                return nullptr;
+            }
+
+            if (FT_Load_Glyph(face, index, FT_LOAD_RENDER | FT_LOAD_NO_HINTING) != 0)
+            {
+                return nullptr;
+            }
+
+            auto & metrics = face->glyph->metrics;
+            auto & bitmap = face->glyph->bitmap;
+            const int32_t spread = static_cast<int32_t>(g_distanceFieldSpread);
+            const int32_t width = static_cast<int32_t>(bitmap.width);
+            const int32_t rows = static_cast<int32_t>(bitmap.rows);
+
+            // Empty glyphs, such as spaces, keep an empty bitmap.
+            const bool empty = !width || !rows;
+            const int32_t fieldWidth = empty ? 0 : width + (2 * spread);
+            const int32_t fieldRows = empty ? 0 : rows + (2 * spread);
+            std::vector<uint8_t> distanceField(static_cast<size_t>(fieldWidth * fieldRows));
+
+            if (!empty)
+            {
+                const uint8_t * source = bitmap.buffer;
+                if (bitmap.pitch < 0)
+                {
+                    source += static_cast<ptrdiff_t>(-bitmap.pitch) * (rows - 1);
+                }
+                Bitmap::createDistanceField(distanceField.data(), source, width, rows, std::abs(bitmap.pitch), spread);
+            }
+
+            const FT_Pos padding = empty ? 0 : spread;
+            const FT_Pos baseline = rows - (metrics.horiBearingY >> 6) + padding;
+
+            auto newIt = glyphs.insert({ mapIndex, std::make_unique<Glyph>(index, std::move(distanceField), fieldWidth, fieldRows,
+                baseline, metrics.horiAdvance >> 6, (metrics.horiBearingX >> 6) - padding, (metrics.horiBearingY >> 6) + padding) });
+            return newIt.first->second.get();
+        }
+
         std::unique_ptr<uint8_t[]>                  data;
         size_t                                      dataSize;
         FT_Library                                  library;
         FT_Face                                     face;
         std::map<uint64_t, std::unique_ptr<Glyph> > glyphs;
         uint32_t                                    currentFontSize;
+        std::mutex                                  mutex; ///< Guards the face and glyphs, sequences are created by several threads.
     };
 
     std::shared_ptr<Font> Font::create(const std::string & font)
@@ -260,7 +356,7 @@ namespace Guise
         
         return path;
     #elif defined(GUISE_PLATFORM_LINUX)
-        return "";
+        return FontIndex::getSystem().find(font);
     #endif
     }
 
@@ -271,13 +367,18 @@ namespace Guise
     {
 
         Impl() :
-            size(0, 0)
+            size(0, 0),
+            baseline(0),
+            lineHeight(0),
+            ascender(0)
         { }
 
         Impl(std::shared_ptr<Font> & font) :
             font(font),
             size(0, 0),
-            baseline(0)
+            baseline(0),
+            lineHeight(0),
+            ascender(0)
         { }
 
         struct GlyphData
@@ -286,15 +387,173 @@ namespace Guise
             Glyph * glyph;
         };
 
+        void reset()
+        {
+            sequence.clear();
+            size = { 0, 0 };
+            lowDim = { std::numeric_limits<FT_Pos>::max(), std::numeric_limits<FT_Pos>::max() };
+            highDim = { std::numeric_limits<FT_Pos>::min(), std::numeric_limits<FT_Pos>::min() };
+            baseline = 0;
+            lineHeight = 0;
+            ascender = 0;
+        }
+
+        /**
+        * Lay out glyphs of text on a single line, calculating the bounding box and baseline.
+        */
+        template<typename GetGlyph>
+        bool layout(const std::wstring & text, FT_Face face, GetGlyph getGlyph)
+        {
+            FT_Pos penPos = 0;
+            FT_Pos prevPenPos = 0;
+            const bool hasKerning = FT_HAS_KERNING(face);
+            FT_UInt prevIndex = 0;
+
+            // Calcualte text bounding box and pen start position.
+            for (size_t i = 0; i < text.size(); i++)
+            {
+                Glyph * glyph = getGlyph(text[i]);
+                if (!glyph)
+                {
+                    glyph = getGlyph(L' ');
+                }
+            
+                if (glyph)
+                {
+                    // Move pen if font has kerning.
+                    if (hasKerning && prevIndex)
+                    {
+                        FT_Vector  delta;
+                        FT_Get_Kerning(face, prevIndex, glyph->index, FT_KERNING_DEFAULT, &delta);
+
+                        prevPenPos += delta.x >> 6;
+                        penPos = prevPenPos;
+                    }
+                    prevIndex = glyph->index;
+
+                    // Calc X dimensions.
+                    FT_Pos lowX = penPos + glyph->horiBearingX;
+                    if (lowX < lowDim.x)
+                    {
+                        lowDim.x = lowX;
+                    }
+
+                    FT_Pos highX = penPos + glyph->horiBearingX + glyph->width;
+                    if (highX > highDim.x)
+                    {
+                        highDim.x = highX;
+                    }
+
+                    // Calc Y dimensions.
+                    FT_Pos lowY = glyph->horiBearingY - glyph->rows;
+                    if (lowY < lowDim.y)
+                    {
+                        lowDim.y = lowY;
+                    }
+
+                    FT_Pos highY = glyph->horiBearingY;
+                    if (highY > highDim.y)
+                    {
+                        highDim.y = highY;
+                    }
+
+                    penPos += glyph->horiAdvance;
+                    sequence.push_back({ {  static_cast<int32_t>(prevPenPos),
+                                            static_cast<int32_t>(penPos - prevPenPos) }, glyph });
+                    prevPenPos = penPos;
+                }
+                else
+                {
+                    sequence.push_back({ { static_cast<int32_t>(prevPenPos), static_cast<int32_t>(prevPenPos) }, nullptr });
+                }
+            }
+
+            if (lowDim.x > highDim.x || lowDim.y > highDim.y)
+            {
+                sequence.clear();
+                return false;
+            }
+
+            baseline = -lowDim.y;
+            size.x = static_cast<size_t>(highDim.x - lowDim.x);
+            size.y = static_cast<size_t>(highDim.y - lowDim.y);
+
+            return true;
+        }
+
+        /**
+        * Max-composite glyphs [from, to) into an alpha bitmap.
+        *
+        * @param offsetX Added to pen position of glyphs.
+        * @param baselineRow Bitmap row of baseline, counted from the bottom.
+        */
+        void compositeAlpha(uint8_t * buffer, const Vector2<size_t> & bufferSize, const size_t from, const size_t to,
+                            const int32_t offsetX, const int32_t baselineRow) const;
+
         std::shared_ptr<Font>   font;
         std::vector<GlyphData>  sequence;
         Vector2<size_t>         size;
         Vector2<FT_Pos>         lowDim;
         Vector2<FT_Pos>         highDim;
         int32_t                 baseline;
+        int32_t                 lineHeight;
+        int32_t                 ascender;
+        std::vector<uint8_t>    alphaBuffer; ///< Scratch buffers, reused between bitmap creations.
+        std::vector<uint8_t>    rgbaBuffer;
 
     };
 
+    void FontSequence::Impl::compositeAlpha(uint8_t * buffer, const Vector2<size_t> & bufferSize, const size_t from, const size_t to,
+                                            const int32_t offsetX, const int32_t baselineRow) const
+    {
+        const size_t newTo = to < sequence.size() ? to : sequence.size();
+        for (size_t i = from; i < newTo; i++)
+        {
+            auto & currSeq = sequence[i];
+            auto glyph = currSeq.glyph;
+
+            if (!glyph)
+            {
+                continue;
+            }
+
+            const int32_t width = glyph->width;
+            const int32_t rows = glyph->rows;
+            const int32_t pitch = glyph->pitch;
+
+            // Clip glyph horizontally against the destination bitmap.
+            int32_t posX = static_cast<int32_t>(currSeq.bounds.position + offsetX + glyph->horiBearingX);
+            int32_t srcX = 0;
+            int32_t count = width;
+            if (posX < 0)
+            {
+                srcX = -posX;
+                count += posX;
+                posX = 0;
+            }
+            count = std::min(count, static_cast<int32_t>(bufferSize.x) - posX);
+            if (count <= 0)
+            {
+                continue;
+            }
+
+            // Glyph bitmaps are stored top-down, the destination bitmap bottom-up.
+            const int32_t rowOffset = static_cast<int32_t>(glyph->baseline) - baselineRow;
+            for (int32_t y = 0; y < rows; y++)
+            {
+                const int32_t dstY = y - rowOffset;
+                if (dstY < 0 || dstY >= static_cast<int32_t>(bufferSize.y))
+                {
+                    continue;
+                }
+
+                const uint8_t * source = glyph->buffer + ((rows - 1 - y) * pitch) + srcX;
+                uint8_t * destination = buffer + (dstY * bufferSize.x) + posX;
+                Bitmap::maxRow(destination, source, static_cast<size_t>(count));
+            }
+        }
+    }
+
     FontSequence::FontSequence()
     { }
 
@@ -313,11 +572,7 @@ namespace Guise
 
     bool FontSequence::createSequence(const std::wstring & text, const uint32_t height, const uint32_t dpi)
     {
-        m_impl->sequence.clear();
-        m_impl->size = {0, 0};
-        m_impl->lowDim = { std::numeric_limits<FT_Pos>::max(), std::numeric_limits<FT_Pos>::max() };
-        m_impl->highDim = { std::numeric_limits<FT_Pos>::min(), std::numeric_limits<FT_Pos>::min() };
-        m_impl->baseline = 0;
+        m_impl->reset();
 
         const uint32_t fontSize = height * dpi / GUISE_DEFAULT_DPI;
 
@@ -327,6 +582,7 @@ namespace Guise
         }
 
         const auto fontImpl = m_impl->font->m_impl;
+        std::lock_guard<std::mutex> lock(fontImpl->mutex);
         FT_Error error = 0;
 
         if (fontSize != fontImpl->currentFontSize)
@@ -339,90 +595,54 @@ namespace Guise
 
             fontImpl->currentFontSize = fontSize;
         }
-        
-        FT_Pos penPos = 0;
-        FT_Pos prevPenPos = 0;
-        const bool hasKerning = FT_HAS_KERNING(fontImpl->face);
-        FT_UInt prevIndex = 0;
 
-        // Calcualte text bounding box and pen start position.
-        for (size_t i = 0; i < text.size(); i++)
+        const auto & metrics = fontImpl->face->size->metrics;
+        m_impl->lineHeight = static_cast<int32_t>((metrics.height + 63) >> 6);
+        m_impl->ascender = static_cast<int32_t>((metrics.ascender + 63) >> 6);
+        
+        return m_impl->layout(text, fontImpl->face, [&fontImpl, fontSize](const wchar_t character)
         {
-            auto glyph = fontImpl->getGlypth(text[i], fontSize);
-            if (!glyph)
-            {
-                glyph = fontImpl->getGlypth(L' ', fontSize);
-            }
-            
-            if (glyph)
-            {
-                //glyphs.push_back(glyph);
-                auto & bitmap = glyph->bitmapGlyph->bitmap;
-
-                // Move pen if font has kerning.
-                if (hasKerning && prevIndex)
-                {
-                    FT_Vector  delta;
-                    FT_Get_Kerning(fontImpl->face, prevIndex, glyph->index, FT_KERNING_DEFAULT, &delta);
-
-                    prevPenPos += delta.x >> 6;
-                    penPos = prevPenPos;
-                }
-                prevIndex = glyph->index;
-
-                // Calc X dimensions.
-                FT_Pos lowX = penPos + glyph->horiBearingX;
-                if (lowX < m_impl->lowDim.x)
-                {
-                    m_impl->lowDim.x = lowX;
-                }
-
-                FT_Pos highX = penPos + glyph->horiBearingX + bitmap.width;
-                if (highX > m_impl->highDim.x)
-                {
-                    m_impl->highDim.x = highX;
-                }
-
-                // Calc Y dimensions.
-                FT_Pos lowY = glyph->horiBearingY - bitmap.rows;
-                if (lowY < m_impl->lowDim.y)
-                {
-                    m_impl->lowDim.y = lowY;
-                }
+            return fontImpl->getGlypth(character, fontSize);
+        });
+    }
 
-                FT_Pos highY = glyph->horiBearingY;
-                if (highY > m_impl->highDim.y)
-                {
-                    m_impl->highDim.y = highY;
-                }
+    bool FontSequence::createDistanceFieldSequence(const std::wstring & text)
+    {
+        m_impl->reset();
 
-                penPos += glyph->horiAdvance;
-                m_impl->sequence.push_back({ {  static_cast<int32_t>(prevPenPos),
-                                                static_cast<int32_t>(penPos - prevPenPos) }, glyph });
-                prevPenPos = penPos;
-            }
-            else
-            {
-                m_impl->sequence.push_back({ { static_cast<int32_t>(prevPenPos), static_cast<int32_t>(prevPenPos) }, nullptr });
-            }
+        if (!text.size() || !m_impl->font || !m_impl->font->isValid())
+        {
+            return false;
         }
 
-        if (m_impl->lowDim.x > m_impl->highDim.x || m_impl->lowDim.y > m_impl->highDim.y)
+        const auto fontImpl = m_impl->font->m_impl;
+        std::lock_guard<std::mutex> lock(fontImpl->mutex);
+        if (FT_Set_Pixel_Sizes(fontImpl->face, 0, g_distanceFieldSize) != 0)
         {
-            m_impl->sequence.clear();
             return false;
         }
 
-        m_impl->baseline = -m_impl->lowDim.y;
-        m_impl->size.x = static_cast<size_t>(m_impl->highDim.x - m_impl->lowDim.x);
-        m_impl->size.y = static_cast<size_t>(m_impl->highDim.y - m_impl->lowDim.y);
+        // Face size no longer matches the bitmap glyph size.
+        fontImpl->currentFontSize = 0;
 
-        return true;
+        const auto & metrics = fontImpl->face->size->metrics;
+        m_impl->lineHeight = static_cast<int32_t>((metrics.height + 63) >> 6);
+        m_impl->ascender = static_cast<int32_t>((metrics.ascender + 63) >> 6);
+
+        return m_impl->layout(text, fontImpl->face, [&fontImpl](const wchar_t character)
+        {
+            return fontImpl->getDistanceGlyph(character);
+        });
+    }
+
+    float FontSequence::getDistanceFieldScale(const uint32_t height, const uint32_t dpi)
+    {
+        // Char size in points, 72 points per inch.
+        return (static_cast<float>(height) * static_cast<float>(dpi) / 72.0f) / static_cast<float>(g_distanceFieldSize);
     }
 
     bool FontSequence::createBitmapaAlpha(std::unique_ptr<uint8_t[]> & buffer, Vector2<size_t> & dimensions, const size_t from, const size_t to)
     {
-        const auto fontImpl = m_impl->font->m_impl;
         const size_t bufferSize = m_impl->size.x * m_impl->size.y;
 
         if (!bufferSize)
@@ -432,91 +652,62 @@ namespace Guise
 
         dimensions = m_impl->size;
         buffer = std::make_unique<uint8_t[]>(bufferSize);
-        uint8_t * glyphBuffer = buffer.get();
-        memset(glyphBuffer, 0, bufferSize);
-
-        // Render glyphs.
-        const size_t newTo = to < m_impl->sequence.size() ? to : m_impl->sequence.size();
-        for (size_t i = from; i < newTo; i++)
-        {
-            auto & currSeq = m_impl->sequence[i];
-            auto glyph = currSeq.glyph;
-
-            if (!glyph)
-            {
-                continue;
-            }
-
-            auto & bitmap = glyph->bitmapGlyph->bitmap;
-            auto bitmapBuffer = bitmap.buffer;
-            auto penPos = currSeq.bounds.position - m_impl->lowDim.x;
-
-            for (int y = 0; y < bitmap.rows; y++)
-            {
-                int intY = bitmap.rows - 1 - y;
-
-                for (int x = 0; x < bitmap.width; x++)
-                {
-                    const int glyphIndex = ((y - glyph->baseline + m_impl->lowDim.y) * m_impl->size.x) + (x + penPos + glyph->horiBearingX);
-                    const int bitmapIndex = (intY * bitmap.width) + x;
-
-                    glyphBuffer[glyphIndex] = std::max(bitmapBuffer[bitmapIndex], glyphBuffer[glyphIndex]);
-                }
-            }
-        }
+        memset(buffer.get(), 0, bufferSize);
+        m_impl->compositeAlpha(buffer.get(), m_impl->size, from, to, static_cast<int32_t>(-m_impl->lowDim.x), m_impl->baseline);
 
         return true;
     }
 
     bool FontSequence::createBitmapRgba(std::unique_ptr<uint8_t[]> & buffer, Vector2<size_t> & dimensions, const size_t from, const size_t to)
     {
-        const auto fontImpl = m_impl->font->m_impl;
-        const size_t bufferSize = m_impl->size.x * m_impl->size.y * 4;
+        Vector2<size_t> size;
+        const uint8_t * rgba = createBitmapRgba(size, from, to);
 
-        if (!bufferSize)
+        if (!rgba)
         {
             return false;
         }
 
-        dimensions = m_impl->size;
+        const size_t bufferSize = size.x * size.y * 4;
+        dimensions = size;
         buffer = std::make_unique<uint8_t[]>(bufferSize);
-        uint8_t * glyphBuffer = buffer.get();
-        memset(glyphBuffer, 0, bufferSize);
+        memcpy(buffer.get(), rgba, bufferSize);
 
-        // Render glyphs.
-        const size_t newTo = to < m_impl->sequence.size() ? to : m_impl->sequence.size();
-        for(size_t i = from; i < newTo; i++)
-        {
-            auto & currSeq = m_impl->sequence[i];
-            auto glyph = currSeq.glyph;
+        return true;
+    }
 
-            if (!glyph)
-            {
-                continue;
-            }
+    const uint8_t * FontSequence::createBitmapaAlpha(Vector2<size_t> & dimensions, const size_t from, const size_t to)
+    {
+        const size_t bufferSize = m_impl->size.x * m_impl->size.y;
 
-            auto & bitmap = glyph->bitmapGlyph->bitmap;
-            auto bitmapBuffer = bitmap.buffer;
-            auto penPos = currSeq.bounds.position - m_impl->lowDim.x;
+        if (!bufferSize)
+        {
+            return nullptr;
+        }
 
-            for (int y = 0; y < bitmap.rows; y++)
-            {
-                int intY = bitmap.rows - 1 - y;
+        dimensions = m_impl->size;
+        m_impl->alphaBuffer.assign(bufferSize, 0);
+        m_impl->compositeAlpha(m_impl->alphaBuffer.data(), m_impl->size, from, to, static_cast<int32_t>(-m_impl->lowDim.x), m_impl->baseline);
 
-                for (int x = 0; x < bitmap.width; x++)
-                {
-                    const int glyphIndex = ((y - (glyph->baseline + m_impl->lowDim.y)) * m_impl->size.x * 4) + ((x + penPos + glyph->horiBearingX) * 4);
-                    const int bitmapIndex = (intY * bitmap.width) + x;
+        return m_impl->alphaBuffer.data();
+    }
 
-                    glyphBuffer[glyphIndex] = 255;
-                    glyphBuffer[glyphIndex + 1] = 255;
-                    glyphBuffer[glyphIndex + 2] = 255;
-                    glyphBuffer[glyphIndex + 3] = std::max(bitmapBuffer[bitmapIndex], glyphBuffer[glyphIndex + 3]);
-                }
-            }
+    const uint8_t * FontSequence::createBitmapRgba(Vector2<size_t> & dimensions, const size_t from, const size_t to)
+    {
+        Vector2<size_t> size;
+        const uint8_t * alpha = createBitmapaAlpha(size, from, to);
+
+        if (!alpha)
+        {
+            return nullptr;
         }
 
-        return true;
+        const size_t pixelCount = size.x * size.y;
+        dimensions = size;
+        m_impl->rgbaBuffer.resize(pixelCount * 4);
+        Bitmap::expandAlphaToRgba(m_impl->rgbaBuffer.data(), alpha, pixelCount);
+
+        return m_impl->rgbaBuffer.data();
     }
 
     bool FontSequence::findIndex(const int32_t width, const size_t from, size_t & to) const
@@ -575,15 +766,397 @@ namespace Guise
         return m_impl->sequence.size();
     }
 
-    size_t FontSequence::intersect(const Vector2f & /*point*/) const
+    size_t FontSequence::intersect(const Vector2f & point) const
+    {
+        // First glyph whose horizontal center is right of point.
+        auto & sequence = m_impl->sequence;
+        auto it = std::upper_bound(sequence.begin(), sequence.end(), point.x,
+            [](const float x, const Impl::GlyphData & glyphData)
+        {
+            return x < static_cast<float>(glyphData.bounds.position) + (static_cast<float>(glyphData.bounds.size) * 0.5f);
+        });
+
+        return static_cast<size_t>(it - sequence.begin());
+    }
+
+    int32_t FontSequence::getLineHeight() const
+    {
+        return m_impl->lineHeight;
+    }
+
+
+    // Text layout implementations.
+    static inline bool isWrapSpace(const wchar_t character)
+    {
+        return character == L' ' || character == L'\t';
+    }
+
+    TextLayout::TextLayout() :
+        m_width(std::numeric_limits<int32_t>::max())
+    { }
+
+    TextLayout::TextLayout(std::shared_ptr<Font> & font) :
+        m_sequence(font),
+        m_width(std::numeric_limits<int32_t>::max())
+    { }
+
+    bool TextLayout::create(const std::wstring & text, const uint32_t height, const uint32_t dpi, const int32_t width)
+    {
+        m_text = text;
+        m_width = width;
+        m_paragraphs.clear();
+        m_lines.clear();
+
+        if (!m_sequence.m_impl || !m_sequence.createSequence(text, height, dpi))
+        {
+            return false;
+        }
+
+        size_t from = 0;
+        while (from <= m_text.size())
+        {
+            size_t to = m_text.find(L'\n', from);
+            if (to == std::wstring::npos)
+            {
+                to = m_text.size();
+            }
+
+            const size_t lineCount = m_lines.size();
+            layoutParagraph(from, to, m_lines);
+            m_paragraphs.push_back({ from, to, m_lines.size() - lineCount });
+
+            from = to + 1;
+        }
+
+        return true;
+    }
+
+    bool TextLayout::setWidth(const int32_t width)
+    {
+        if (width == m_width)
+        {
+            return false;
+        }
+        m_width = width;
+
+        // Lines are kept until the first one whose break decision depends on the new width.
+        bool changed = false;
+        size_t lineIndex = 0;
+        m_lineBuffer.clear();
+        for (auto & paragraph : m_paragraphs)
+        {
+            size_t valid = 0;
+            while (valid < paragraph.lineCount)
+            {
+                auto & line = m_lines[lineIndex + valid];
+                if (width < line.minWidth || width >= line.breakWidth)
+                {
+                    break;
+                }
+                valid++;
+            }
+
+            m_lineBuffer.insert(m_lineBuffer.end(), m_lines.begin() + lineIndex, m_lines.begin() + lineIndex + valid);
+            if (valid < paragraph.lineCount)
+            {
+                const size_t paragraphStart = m_lineBuffer.size() - valid;
+                layoutParagraph(m_lines[lineIndex + valid].from, paragraph.to, m_lineBuffer);
+                lineIndex += paragraph.lineCount;
+                paragraph.lineCount = m_lineBuffer.size() - paragraphStart;
+                changed = true;
+            }
+            else
+            {
+                lineIndex += paragraph.lineCount;
+            }
+        }
+
+        std::swap(m_lines, m_lineBuffer);
+        return changed;
+    }
+
+    int32_t TextLayout::getWidth() const
+    {
+        return m_width;
+    }
+
+    const FontSequence & TextLayout::getSequence() const
     {
-        return 0;
+        return m_sequence;
+    }
+
+    const std::vector<TextLayout::Line> & TextLayout::getLines() const
+    {
+        return m_lines;
+    }
+
+    int32_t TextLayout::getLineHeight() const
+    {
+        return m_sequence.m_impl ? m_sequence.m_impl->lineHeight : 0;
+    }
+
+    Vector2<size_t> TextLayout::getSize() const
+    {
+        int32_t width = 0;
+        for (auto & line : m_lines)
+        {
+            width = std::max(width, line.width);
+        }
+
+        return { static_cast<size_t>(width), m_lines.size() * static_cast<size_t>(getLineHeight()) };
+    }
+
+    size_t TextLayout::findLine(const size_t index) const
+    {
+        auto it = std::upper_bound(m_lines.begin(), m_lines.end(), index,
+            [](const size_t i, const Line & line)
+        {
+            return i < line.from;
+        });
+
+        return it == m_lines.begin() ? 0 : static_cast<size_t>(it - m_lines.begin()) - 1;
+    }
+
+    size_t TextLayout::intersect(const Vector2f & point) const
+    {
+        if (m_lines.empty())
+        {
+            return 0;
+        }
+
+        const int32_t lineHeight = std::max(getLineHeight(), 1);
+        const int32_t row = static_cast<int32_t>(std::floor(point.y / static_cast<float>(lineHeight)));
+        const size_t lineIndex = static_cast<size_t>(std::min(std::max(row, 0), static_cast<int32_t>(m_lines.size()) - 1));
+        const auto & line = m_lines[lineIndex];
+
+        if (line.from == line.to)
+        {
+            return line.from;
+        }
+
+        auto & sequence = m_sequence.m_impl->sequence;
+        const float x = point.x + static_cast<float>(sequence[line.from].bounds.position);
+        auto it = std::upper_bound(sequence.begin() + line.from, sequence.begin() + line.to, x,
+            [](const float value, const FontSequence::Impl::GlyphData & glyphData)
+        {
+            return value < static_cast<float>(glyphData.bounds.position) + (static_cast<float>(glyphData.bounds.size) * 0.5f);
+        });
+
+        // Caret past the end of a wrapped line stays on that line.
+        size_t index = static_cast<size_t>(it - sequence.begin());
+        if (index == line.to && lineIndex + 1 < m_lines.size() && m_lines[lineIndex + 1].from == line.to)
+        {
+            index--;
+        }
+
+        return index;
+    }
+
+    Vector2f TextLayout::indexToPosition(const size_t index) const
+    {
+        if (m_lines.empty())
+        {
+            return { 0.0f, 0.0f };
+        }
+
+        auto & sequence = m_sequence.m_impl->sequence;
+        auto penPosition = [&sequence](const size_t i)
+        {
+            if (i < sequence.size())
+            {
+                return sequence[i].bounds.position;
+            }
+            return sequence.empty() ? 0 : sequence.back().bounds.position + sequence.back().bounds.size;
+        };
+
+        const size_t newIndex = std::min(index, m_text.size());
+        const size_t lineIndex = findLine(newIndex);
+        const auto & line = m_lines[lineIndex];
+
+        return
+        {
+            static_cast<float>(penPosition(newIndex) - penPosition(line.from)),
+            static_cast<float>(lineIndex * static_cast<size_t>(getLineHeight()))
+        };
+    }
+
+    const uint8_t * TextLayout::createBitmapRgba(Vector2<size_t> & dimensions)
+    {
+        if (m_lines.empty() || !m_sequence.m_impl || m_sequence.m_impl->sequence.empty())
+        {
+            return nullptr;
+        }
+
+        auto & sequenceImpl = *m_sequence.m_impl;
+        auto & sequence = sequenceImpl.sequence;
+
+        // Horizontal ink extents of all lines.
+        int32_t lowX = 0;
+        int32_t highX = 0;
+        for (auto & line : m_lines)
+        {
+            if (line.from >= sequence.size())
+            {
+                continue;
+            }
+
+            const int32_t start = sequence[line.from].bounds.position;
+            for (size_t i = line.from; i < line.to && i < sequence.size(); i++)
+            {
+                auto glyph = sequence[i].glyph;
+                if (!glyph)
+                {
+                    continue;
+                }
+
+                const int32_t x = static_cast<int32_t>(sequence[i].bounds.position - start + glyph->horiBearingX);
+                lowX = std::min(lowX, x);
+                highX = std::max(highX, x + glyph->width);
+            }
+        }
+
+        const int32_t lineHeight = sequenceImpl.lineHeight;
+        const Vector2<size_t> size = { static_cast<size_t>(highX - lowX), m_lines.size() * static_cast<size_t>(lineHeight) };
+        const size_t pixelCount = size.x * size.y;
+        if (!pixelCount)
+        {
+            return nullptr;
+        }
+
+        m_alphaBuffer.assign(pixelCount, 0);
+        const int32_t descender = std::max(lineHeight - sequenceImpl.ascender, 0);
+        const int32_t lineCount = static_cast<int32_t>(m_lines.size());
+        for (int32_t i = 0; i < lineCount; i++)
+        {
+            auto & line = m_lines[i];
+            if (line.from >= sequence.size())
+            {
+                continue;
+            }
+
+            const int32_t offsetX = -sequence[line.from].bounds.position - lowX;
+            const int32_t baselineRow = ((lineCount - 1 - i) * lineHeight) + descender;
+            sequenceImpl.compositeAlpha(m_alphaBuffer.data(), size, line.from, line.to, offsetX, baselineRow);
+        }
+
+        m_rgbaBuffer.resize(pixelCount * 4);
+        Bitmap::expandAlphaToRgba(m_rgbaBuffer.data(), m_alphaBuffer.data(), pixelCount);
+
+        dimensions = size;
+        return m_rgbaBuffer.data();
+    }
+
+    int32_t TextLayout::measure(const size_t from, const size_t to) const
+    {
+        size_t last = to;
+        while (last > from && isWrapSpace(m_text[last - 1]))
+        {
+            last--;
+        }
+
+        if (last == from)
+        {
+            return 0;
+        }
+
+        auto & sequence = m_sequence.m_impl->sequence;
+        return (sequence[last - 1].bounds.position + sequence[last - 1].bounds.size) - sequence[from].bounds.position;
+    }
+
+    size_t TextLayout::nextBreak(const size_t from, const size_t to) const
+    {
+        size_t i = from;
+        while (i < to && !isWrapSpace(m_text[i]))
+        {
+            i++;
+        }
+        while (i < to && isWrapSpace(m_text[i]))
+        {
+            i++;
+        }
+        return i;
+    }
+
+    void TextLayout::layoutParagraph(const size_t from, const size_t to, std::vector<Line> & lines) const
+    {
+        const int32_t minWidth = std::numeric_limits<int32_t>::min();
+        const int32_t maxWidth = std::numeric_limits<int32_t>::max();
+
+        if (from == to)
+        {
+            lines.push_back({ from, to, 0, minWidth, maxWidth });
+            return;
+        }
+
+        size_t start = from;
+        while (start < to)
+        {
+            Line line;
+            line.from = start;
+
+            size_t end = nextBreak(start, to);
+            int32_t width = measure(start, end);
+
+            if (width > m_width)
+            {
+                // Word is wider than the layout, break it between characters.
+                // A line always holds at least one character, whatever the width.
+                size_t charEnd = start + 1;
+                while (charEnd < end && measure(start, charEnd + 1) <= m_width)
+                {
+                    charEnd++;
+                }
+                const bool forced = charEnd == start + 1;
+                while (charEnd < end && isWrapSpace(m_text[charEnd]))
+                {
+                    charEnd++;
+                }
+
+                line.to = charEnd;
+                line.width = measure(start, charEnd);
+                line.minWidth = forced ? minWidth : line.width;
+                if (charEnd < end)
+                {
+                    line.breakWidth = measure(start, charEnd + 1);
+                }
+                else
+                {
+                    line.breakWidth = end < to ? measure(start, nextBreak(end, to)) : maxWidth;
+                }
+            }
+            else
+            {
+                while (end < to)
+                {
+                    const size_t next = nextBreak(end, to);
+                    const int32_t nextWidth = measure(start, next);
+                    if (nextWidth > m_width)
+                    {
+                        break;
+                    }
+
+                    end = next;
+                    width = nextWidth;
+                }
+
+                line.to = end;
+                line.width = width;
+                line.minWidth = width;
+                line.breakWidth = end < to ? measure(start, nextBreak(end, to)) : maxWidth;
+            }
+
+            lines.push_back(line);
+            start = line.to;
+        }
     }
 
     // Font library implementations.
+    static std::mutex g_fontLibraryMutex;
     static std::unordered_map<std::string, std::shared_ptr<Font>> g_fontLibrary;
     std::shared_ptr<Font> FontLibrary::get(const std::string & font)
     {
+        std::lock_guard<std::mutex> lock(g_fontLibraryMutex);
+
         auto it = g_fontLibrary.find(font);
         if (it == g_fontLibrary.end())
         {
@@ -599,7 +1172,202 @@ namespace Guise
 
         return it->second;
     }
-    
-  
+
+
+    // Text run implementations.
+    bool TextRun::isValid() const
+    {
+        return m_isValid;
+    }
+
+    bool TextRun::isDistanceField() const
+    {
+        return m_isDistanceField;
+    }
+
+    const FontSequence & TextRun::getSequence() const
+    {
+        return m_sequence;
+    }
+
+    const Vector2<size_t> & TextRun::getSize() const
+    {
+        return m_size;
+    }
+
+    std::shared_ptr<Texture> TextRun::getTexture(RendererInterface & rendererInterface)
+    {
+        if (!m_isValid)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_textures.find(rendererInterface.getResourceGroup());
+        if (it != m_textures.end())
+        {
+            return it->second;
+        }
+
+        auto texture = rendererInterface.createTexture();
+        texture->load(m_bitmap, Texture::PixelFormat::RGBA8, m_size);
+        m_textures.insert({ rendererInterface.getResourceGroup(), texture });
+        return texture;
+    }
+
+    TextRun::TextRun(const std::shared_ptr<Font> & font, const std::wstring & text, const uint32_t height, const uint32_t dpi) :
+        m_isValid(false),
+        m_isDistanceField(false),
+        m_bitmap(nullptr),
+        m_size(0, 0)
+    {
+        if (!font)
+        {
+            return;
+        }
+
+        auto sequenceFont = font;
+        m_sequence = FontSequence(sequenceFont);
+        if (m_sequence.createSequence(text, height, dpi))
+        {
+            m_bitmap = m_sequence.createBitmapRgba(m_size);
+            m_isValid = m_bitmap != nullptr;
+        }
+    }
+
+
+    TextRun::TextRun(const std::shared_ptr<Font> & font, const std::wstring & text) :
+        m_isValid(false),
+        m_isDistanceField(true),
+        m_bitmap(nullptr),
+        m_size(0, 0)
+    {
+        if (!font)
+        {
+            return;
+        }
+
+        auto sequenceFont = font;
+        m_sequence = FontSequence(sequenceFont);
+        if (m_sequence.createDistanceFieldSequence(text))
+        {
+            m_bitmap = m_sequence.createBitmapRgba(m_size);
+            m_isValid = m_bitmap != nullptr;
+        }
+    }
+
+
+    // Text run cache implementations.
+    using TextRunKey = std::tuple<const Font *, bool, uint32_t, uint32_t, std::wstring>;
+
+    static std::mutex g_textRunMutex;
+    static std::map<TextRunKey, std::weak_ptr<TextRun> > g_textRuns;
+    static TextRunCache::Statistics g_textRunStatistics = { 0, 0, 0 };
+    static const size_t g_textRunPurgeInterval = 64;
+
+    static size_t purgeTextRuns()
+    {
+        size_t count = 0;
+        for (auto it = g_textRuns.begin(); it != g_textRuns.end();)
+        {
+            if (it->second.expired())
+            {
+                it = g_textRuns.erase(it);
+                count++;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    template<typename CreateFunction>
+    static std::shared_ptr<TextRun> getTextRun(TextRunKey && key, CreateFunction create)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_textRunMutex);
+
+            auto it = g_textRuns.find(key);
+            if (it != g_textRuns.end())
+            {
+                if (auto textRun = it->second.lock())
+                {
+                    g_textRunStatistics.hits++;
+                    return textRun;
+                }
+            }
+
+            g_textRunStatistics.misses++;
+            if ((g_textRunStatistics.misses % g_textRunPurgeInterval) == 0)
+            {
+                purgeTextRuns();
+            }
+        }
+
+        // Created without holding the lock, so labels prepared in parallel shape and rasterize concurrently.
+        auto textRun = create();
+
+        std::lock_guard<std::mutex> lock(g_textRunMutex);
+        auto it = g_textRuns.find(key);
+        if (it != g_textRuns.end())
+        {
+            // Another thread created an equal run meanwhile, share that one.
+            if (auto existingRun = it->second.lock())
+            {
+                return existingRun;
+            }
+            it->second = textRun;
+        }
+        else
+        {
+            g_textRuns.insert({ std::move(key), textRun });
+        }
+
+        return textRun;
+    }
+
+    std::shared_ptr<TextRun> TextRunCache::get(const std::shared_ptr<Font> & font, const std::wstring & text, const uint32_t height, const uint32_t dpi)
+    {
+        return getTextRun(TextRunKey(font.get(), false, height, dpi, text), [&]()
+        {
+            return std::shared_ptr<TextRun>(new TextRun(font, text, height, dpi));
+        });
+    }
+
+    std::shared_ptr<TextRun> TextRunCache::getDistanceField(const std::shared_ptr<Font> & font, const std::wstring & text)
+    {
+        return getTextRun(TextRunKey(font.get(), true, 0, 0, text), [&]()
+        {
+            return std::shared_ptr<TextRun>(new TextRun(font, text));
+        });
+    }
+
+    TextRunCache::Statistics TextRunCache::getStatistics()
+    {
+        std::lock_guard<std::mutex> lock(g_textRunMutex);
+
+        Statistics statistics = g_textRunStatistics;
+        statistics.runs = 0;
+        for (auto & entry : g_textRuns)
+        {
+            statistics.runs += entry.second.expired() ? 0 : 1;
+        }
+        return statistics;
+    }
+
+    void TextRunCache::resetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(g_textRunMutex);
+        g_textRunStatistics = { 0, 0, 0 };
+    }
+
+    size_t TextRunCache::purge()
+    {
+        std::lock_guard<std::mutex> lock(g_textRunMutex);
+        return purgeTextRuns();
+    }
 
 }
\ No newline at end of file
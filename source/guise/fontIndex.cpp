@@ -0,0 +1,627 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/fontIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+namespace Guise
+{
+
+    namespace fs = std::filesystem;
+
+    static const uint32_t g_cacheMagic = 0x58494647; // "GFIX"
+    static const uint32_t g_cacheVersion = 1;
+
+    static std::string toLower(const std::string & string)
+    {
+        std::string result = string;
+        std::transform(result.begin(), result.end(), result.begin(), [](const unsigned char c)
+        {
+            return static_cast<char>(std::tolower(c));
+        });
+        return result;
+    }
+
+    static void setEntryKeys(FontIndex::Entry & entry)
+    {
+        entry.familyKey = toLower(entry.family);
+        entry.styleKey = toLower(entry.style);
+    }
+
+    // Compare entry to a lowercase family and style.
+    static int compareEntry(const FontIndex::Entry & entry, const std::string & family, const std::string & style)
+    {
+        const int result = entry.familyKey.compare(family);
+        return result != 0 ? result : entry.styleKey.compare(style);
+    }
+
+    // Metric compatible replacements of common fonts, in order of preference.
+    struct FontAlias
+    {
+        const char * family;
+        std::vector<const char *> replacements;
+    };
+
+    static const std::vector<FontAlias> g_fontAliases =
+    {
+        { "arial",              { "Liberation Sans", "Arimo", "DejaVu Sans", "FreeSans" } },
+        { "helvetica",          { "Liberation Sans", "Arimo", "DejaVu Sans", "FreeSans" } },
+        { "sans-serif",         { "DejaVu Sans", "Liberation Sans", "FreeSans" } },
+        { "times new roman",    { "Liberation Serif", "Tinos", "DejaVu Serif", "FreeSerif" } },
+        { "times",              { "Liberation Serif", "Tinos", "DejaVu Serif", "FreeSerif" } },
+        { "serif",              { "DejaVu Serif", "Liberation Serif", "FreeSerif" } },
+        { "courier new",        { "Liberation Mono", "Cousine", "DejaVu Sans Mono", "FreeMono" } },
+        { "courier",            { "Liberation Mono", "Cousine", "DejaVu Sans Mono", "FreeMono" } },
+        { "monospace",          { "DejaVu Sans Mono", "Liberation Mono", "FreeMono" } }
+    };
+
+    // Styles tried when only a family is requested.
+    static const char * g_defaultStyles[] = { "regular", "book", "normal", "roman", "medium" };
+
+
+    // Binary reading helpers, sfnt data is big endian.
+    static bool readBytes(std::ifstream & file, const uint64_t offset, uint8_t * data, const size_t size)
+    {
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(size));
+        return static_cast<size_t>(file.gcount()) == size;
+    }
+
+    static uint16_t readUint16(const uint8_t * data)
+    {
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+
+    static uint32_t readUint32(const uint8_t * data)
+    {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+    }
+
+    static std::string decodeName(const uint8_t * data, const size_t size, const bool utf16)
+    {
+        std::string result;
+        if (!utf16)
+        {
+            result.assign(reinterpret_cast<const char *>(data), size);
+            return result;
+        }
+
+        // UTF-16BE to UTF-8, names are expected to be in the basic multilingual plane.
+        for (size_t i = 0; i + 1 < size; i += 2)
+        {
+            const uint16_t c = readUint16(data + i);
+            if (c < 0x80)
+            {
+                result.push_back(static_cast<char>(c));
+            }
+            else if (c < 0x800)
+            {
+                result.push_back(static_cast<char>(0xC0 | (c >> 6)));
+                result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+            else
+            {
+                result.push_back(static_cast<char>(0xE0 | (c >> 12)));
+                result.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+        }
+        return result;
+    }
+
+    bool FontIndex::readNames(const std::string & path, std::string & family, std::string & style)
+    {
+        std::ifstream file(path, std::ifstream::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        // Offset table, or collection header pointing to the first face.
+        uint8_t header[12];
+        if (!readBytes(file, 0, header, sizeof(header)))
+        {
+            return false;
+        }
+
+        uint64_t fontOffset = 0;
+        if (readUint32(header) == 0x74746366) // "ttcf"
+        {
+            uint8_t offset[4];
+            if (!readBytes(file, 12, offset, sizeof(offset)))
+            {
+                return false;
+            }
+            fontOffset = readUint32(offset);
+            if (!readBytes(file, fontOffset, header, sizeof(header)))
+            {
+                return false;
+            }
+        }
+
+        const uint16_t tableCount = readUint16(header + 4);
+        std::vector<uint8_t> tables(static_cast<size_t>(tableCount) * 16);
+        if (!readBytes(file, fontOffset + 12, tables.data(), tables.size()))
+        {
+            return false;
+        }
+
+        uint32_t nameOffset = 0;
+        uint32_t nameLength = 0;
+        for (uint16_t i = 0; i < tableCount; i++)
+        {
+            const uint8_t * record = tables.data() + (i * 16);
+            if (readUint32(record) == 0x6E616D65) // "name"
+            {
+                nameOffset = readUint32(record + 8);
+                nameLength = readUint32(record + 12);
+                break;
+            }
+        }
+
+        if (nameLength < 6)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> name(nameLength);
+        if (!readBytes(file, nameOffset, name.data(), name.size()))
+        {
+            return false;
+        }
+
+        const uint16_t count = readUint16(name.data() + 2);
+        const uint16_t stringOffset = readUint16(name.data() + 4);
+
+        // Prefer typographic names (16, 17) over legacy names (1, 2),
+        // and Windows English names over Macintosh Roman names.
+        std::string names[4];
+        int ranks[4] = { 0, 0, 0, 0 };
+        for (uint16_t i = 0; i < count; i++)
+        {
+            const size_t recordOffset = 6 + (static_cast<size_t>(i) * 12);
+            if (recordOffset + 12 > name.size())
+            {
+                break;
+            }
+
+            const uint8_t * record = name.data() + recordOffset;
+            const uint16_t platformId = readUint16(record);
+            const uint16_t languageId = readUint16(record + 4);
+            const uint16_t nameId = readUint16(record + 6);
+            const uint16_t length = readUint16(record + 8);
+            const size_t offset = static_cast<size_t>(stringOffset) + readUint16(record + 10);
+
+            int slot = -1;
+            switch (nameId)
+            {
+                case 1: slot = 0; break;
+                case 2: slot = 1; break;
+                case 16: slot = 2; break;
+                case 17: slot = 3; break;
+                default: break;
+            }
+
+            int rank = 0;
+            if (platformId == 3 && languageId == 0x0409)
+            {
+                rank = 3;
+            }
+            else if (platformId == 3 || platformId == 0)
+            {
+                rank = 2;
+            }
+            else if (platformId == 1 && languageId == 0)
+            {
+                rank = 1;
+            }
+
+            if (slot < 0 || rank <= ranks[slot] || offset + length > name.size())
+            {
+                continue;
+            }
+
+            names[slot] = decodeName(name.data() + offset, length, platformId != 1);
+            ranks[slot] = rank;
+        }
+
+        family = names[2].size() ? names[2] : names[0];
+        style = names[3].size() ? names[3] : names[1];
+        return family.size() != 0;
+    }
+
+    FontIndex::FontIndex(const std::vector<std::string> & directories, const std::string & cachePath) :
+        m_rootDirectories(directories),
+        m_cachePath(cachePath),
+        m_isCached(false)
+    { }
+
+    void FontIndex::load()
+    {
+        m_isCached = readCache();
+        if (!m_isCached)
+        {
+            scan();
+            writeCache();
+        }
+    }
+
+    bool FontIndex::isCached() const
+    {
+        return m_isCached;
+    }
+
+    const std::vector<FontIndex::Entry> & FontIndex::getEntries() const
+    {
+        return m_entries;
+    }
+
+    std::string FontIndex::find(const std::string & font) const
+    {
+        const std::string name = toLower(font);
+
+        // Split into family and style at each space, longest family first.
+        std::string family = name;
+        std::string style;
+        while (true)
+        {
+            std::string path = findEntry(family, style);
+            if (path.size())
+            {
+                return path;
+            }
+
+            for (auto & alias : g_fontAliases)
+            {
+                if (family != alias.family)
+                {
+                    continue;
+                }
+
+                for (auto replacement : alias.replacements)
+                {
+                    path = findEntry(toLower(replacement), style);
+                    if (path.size())
+                    {
+                        return path;
+                    }
+                }
+            }
+
+            const size_t space = family.find_last_of(' ');
+            if (space == std::string::npos)
+            {
+                return "";
+            }
+
+            style = family.substr(space + 1) + (style.size() ? " " + style : "");
+            family = family.substr(0, space);
+        }
+    }
+
+    std::string FontIndex::find(const std::string & family, const std::string & style) const
+    {
+        return findEntry(toLower(family), toLower(style));
+    }
+
+    const FontIndex & FontIndex::getSystem()
+    {
+        static std::mutex mutex;
+        static std::unique_ptr<FontIndex> index;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (index)
+        {
+            return *index;
+        }
+
+        std::vector<std::string> directories = { "/usr/share/fonts", "/usr/local/share/fonts" };
+        std::string cachePath;
+
+        const char * home = std::getenv("HOME");
+        const char * dataHome = std::getenv("XDG_DATA_HOME");
+        const char * cacheHome = std::getenv("XDG_CACHE_HOME");
+        if (dataHome && *dataHome)
+        {
+            directories.push_back(std::string(dataHome) + "/fonts");
+        }
+        else if (home && *home)
+        {
+            directories.push_back(std::string(home) + "/.local/share/fonts");
+        }
+        if (home && *home)
+        {
+            directories.push_back(std::string(home) + "/.fonts");
+        }
+
+        if (cacheHome && *cacheHome)
+        {
+            cachePath = std::string(cacheHome) + "/guise/fontIndex.cache";
+        }
+        else if (home && *home)
+        {
+            cachePath = std::string(home) + "/.cache/guise/fontIndex.cache";
+        }
+
+        index = std::make_unique<FontIndex>(directories, cachePath);
+        index->load();
+        return *index;
+    }
+
+    static void writeUint32(std::ofstream & file, const uint32_t value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    static void writeString(std::ofstream & file, const std::string & string)
+    {
+        writeUint32(file, static_cast<uint32_t>(string.size()));
+        file.write(string.data(), static_cast<std::streamsize>(string.size()));
+    }
+
+    static bool readUint32(std::ifstream & file, uint32_t & value)
+    {
+        file.read(reinterpret_cast<char *>(&value), sizeof(value));
+        return file.good();
+    }
+
+    static bool readString(std::ifstream & file, std::string & string)
+    {
+        uint32_t size = 0;
+        if (!readUint32(file, size) || size > 4096)
+        {
+            return false;
+        }
+        string.resize(size);
+        file.read(&string[0], static_cast<std::streamsize>(size));
+        return file.good();
+    }
+
+    static int64_t getModifiedTime(const std::string & path)
+    {
+        std::error_code error;
+        auto time = fs::last_write_time(path, error);
+        return error ? -1 : static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    bool FontIndex::readCache()
+    {
+        m_directories.clear();
+        m_entries.clear();
+
+        if (m_cachePath.empty())
+        {
+            return false;
+        }
+
+        std::ifstream file(m_cachePath, std::ifstream::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t rootCount = 0;
+        if (!readUint32(file, magic) || magic != g_cacheMagic ||
+            !readUint32(file, version) || version != g_cacheVersion ||
+            !readUint32(file, rootCount) || rootCount != m_rootDirectories.size())
+        {
+            return false;
+        }
+
+        for (auto & root : m_rootDirectories)
+        {
+            std::string path;
+            if (!readString(file, path) || path != root)
+            {
+                return false;
+            }
+        }
+
+        // Any added, removed or renamed font changes the modification time of its directory.
+        uint32_t directoryCount = 0;
+        if (!readUint32(file, directoryCount))
+        {
+            return false;
+        }
+        m_directories.resize(directoryCount);
+        for (auto & directory : m_directories)
+        {
+            uint32_t low = 0;
+            uint32_t high = 0;
+            if (!readString(file, directory.path) || !readUint32(file, low) || !readUint32(file, high))
+            {
+                return false;
+            }
+
+            directory.modified = static_cast<int64_t>((static_cast<uint64_t>(high) << 32) | low);
+            if (getModifiedTime(directory.path) != directory.modified)
+            {
+                return false;
+            }
+        }
+
+        uint32_t entryCount = 0;
+        if (!readUint32(file, entryCount))
+        {
+            return false;
+        }
+        m_entries.resize(entryCount);
+        for (auto & entry : m_entries)
+        {
+            if (!readString(file, entry.family) || !readString(file, entry.style) || !readString(file, entry.path))
+            {
+                m_entries.clear();
+                return false;
+            }
+            setEntryKeys(entry);
+        }
+
+        return true;
+    }
+
+    void FontIndex::scan()
+    {
+        m_directories.clear();
+        m_entries.clear();
+
+        for (auto & root : m_rootDirectories)
+        {
+            // Missing roots are recorded too, so creating them invalidates the cache.
+            m_directories.push_back({ root, getModifiedTime(root) });
+
+            std::error_code error;
+            fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, error);
+            for (; !error && it != fs::recursive_directory_iterator(); it.increment(error))
+            {
+                // Entries failing to report their type are skipped, without ending the scan.
+                const std::string path = it->path().string();
+                std::error_code entryError;
+                const bool isDirectory = it->is_directory(entryError);
+                if (entryError)
+                {
+                    continue;
+                }
+                if (isDirectory)
+                {
+                    m_directories.push_back({ path, getModifiedTime(path) });
+                    continue;
+                }
+
+                const std::string extension = toLower(it->path().extension().string());
+                if (extension != ".ttf" && extension != ".otf" && extension != ".ttc")
+                {
+                    continue;
+                }
+
+                Entry entry;
+                if (readNames(path, entry.family, entry.style))
+                {
+                    entry.path = path;
+                    setEntryKeys(entry);
+                    m_entries.push_back(entry);
+                }
+            }
+        }
+
+        sortEntries();
+    }
+
+    void FontIndex::writeCache() const
+    {
+        if (m_cachePath.empty())
+        {
+            return;
+        }
+
+        std::error_code error;
+        fs::create_directories(fs::path(m_cachePath).parent_path(), error);
+
+        // Write to temporary file first, concurrent readers never see partial caches.
+        const std::string temporaryPath = m_cachePath + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ofstream::binary | std::ofstream::trunc);
+            if (!file.is_open())
+            {
+                return;
+            }
+
+            writeUint32(file, g_cacheMagic);
+            writeUint32(file, g_cacheVersion);
+            writeUint32(file, static_cast<uint32_t>(m_rootDirectories.size()));
+            for (auto & root : m_rootDirectories)
+            {
+                writeString(file, root);
+            }
+
+            writeUint32(file, static_cast<uint32_t>(m_directories.size()));
+            for (auto & directory : m_directories)
+            {
+                const uint64_t modified = static_cast<uint64_t>(directory.modified);
+                writeString(file, directory.path);
+                writeUint32(file, static_cast<uint32_t>(modified & 0xFFFFFFFFULL));
+                writeUint32(file, static_cast<uint32_t>(modified >> 32));
+            }
+
+            writeUint32(file, static_cast<uint32_t>(m_entries.size()));
+            for (auto & entry : m_entries)
+            {
+                writeString(file, entry.family);
+                writeString(file, entry.style);
+                writeString(file, entry.path);
+            }
+
+            if (!file.good())
+            {
+                return;
+            }
+        }
+
+        fs::rename(temporaryPath, m_cachePath, error);
+    }
+
+    void FontIndex::sortEntries()
+    {
+        std::sort(m_entries.begin(), m_entries.end(), [](const Entry & a, const Entry & b)
+        {
+            return compareEntry(a, b.familyKey, b.styleKey) < 0;
+        });
+    }
+
+    std::string FontIndex::findEntry(const std::string & family, const std::string & style) const
+    {
+        auto lower = [](const Entry & entry, const std::pair<const std::string &, const std::string &> & key)
+        {
+            return compareEntry(entry, key.first, key.second) < 0;
+        };
+
+        if (style.size())
+        {
+            auto it = std::lower_bound(m_entries.begin(), m_entries.end(), std::pair<const std::string &, const std::string &>(family, style), lower);
+            return it != m_entries.end() && compareEntry(*it, family, style) == 0 ? it->path : "";
+        }
+
+        for (auto defaultStyle : g_defaultStyles)
+        {
+            const std::string path = findEntry(family, defaultStyle);
+            if (path.size())
+            {
+                return path;
+            }
+        }
+
+        // Any style of family.
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), std::pair<const std::string &, const std::string &>(family, ""), lower);
+        return it != m_entries.end() && it->familyKey == family ? it->path : "";
+    }
+
+}
@@ -33,7 +33,7 @@ namespace Guise
     // Plane implementations.
     std::shared_ptr<Plane> Plane::create()
     {
-        return std::shared_ptr<Plane>(new Plane());
+        return createControl<Plane>();
     }
 
     ControlType Plane::getType() const
@@ -46,18 +46,18 @@ namespace Guise
 
     void Plane::onRender(RendererInterface & rendererInterface)
     {
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
-            child->draw(rendererInterface);
+            child.draw(rendererInterface);
             return true;
         });
     }
 
     void Plane::onResize()
     {
-        forEachChild([&](std::shared_ptr<Control> child, size_t)
+        visitChilds([&](Control & child, size_t)
         {
-            child->setBounds(getBounds());
+            child.setBounds(getBounds());
             return true;
         });
     }
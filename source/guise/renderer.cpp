@@ -24,6 +24,7 @@
 */
 
 #include "guise/renderer.hpp"
+#include <atomic>
 
 
 
@@ -35,13 +36,40 @@
 
 namespace Guise
 {
+    // Renderer interface implementations.
+    static std::atomic<uint64_t> g_nextResourceGroup(1);
+
+    RendererInterface::RendererInterface() :
+        m_resourceGroup(g_nextResourceGroup++)
+    { }
+
+    uint64_t RendererInterface::getResourceGroup() const
+    {
+        return m_resourceGroup;
+    }
+
     // Renderer implementations.
     Renderer::~Renderer()
     { }
 
-    std::shared_ptr<Renderer> Renderer::createDefault(const std::shared_ptr<AppWindow> & appWindow)
+    void Renderer::makeCurrent()
+    { }
+
+    uint32_t Renderer::getBufferAge()
+    {
+        return 0;
+    }
+
+    void Renderer::setScissor(const Bounds2f &)
+    { }
+
+    void Renderer::resetScissor()
+    { }
+
+    std::shared_ptr<Renderer> Renderer::createDefault(const std::shared_ptr<AppWindow> & appWindow,
+                                                      const std::shared_ptr<Renderer> & shareRenderer)
     {
-        return OpenGLRenderer::create(appWindow);
+        return OpenGLRenderer::create(appWindow, std::dynamic_pointer_cast<OpenGLRenderer>(shareRenderer));
     }
 
 #if defined(GUISE_PLATFORM_WINDOWS)
@@ -27,6 +27,9 @@
 
 #if !defined(GUISE_DISABLE_OPENGL)
 
+#include <cstdio>
+#include <cstring>
+
 #if defined(GUISE_PLATFORM_WINDOWS)
 #include "guise/platform/win32Headers.hpp"
 #endif
@@ -50,9 +53,31 @@ namespace Guise
 
         static bool g_loaded = false;
         static bool g_loadStatus = false;
+        static bool g_shadersLoaded = false;
+        static bool g_shadersLoadStatus = false;
+        static bool g_syncLoaded = false;
+        static bool g_syncLoadStatus = false;
 
         PFNGLACTIVETEXTUREPROC glActiveTexture = NULL;
 
+        PFNGLATTACHSHADERPROC glAttachShader = NULL;
+        PFNGLCOMPILESHADERPROC glCompileShader = NULL;
+        PFNGLCREATEPROGRAMPROC glCreateProgram = NULL;
+        PFNGLCREATESHADERPROC glCreateShader = NULL;
+        PFNGLDELETEPROGRAMPROC glDeleteProgram = NULL;
+        PFNGLDELETESHADERPROC glDeleteShader = NULL;
+        PFNGLGETPROGRAMIVPROC glGetProgramiv = NULL;
+        PFNGLGETSHADERIVPROC glGetShaderiv = NULL;
+        PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = NULL;
+        PFNGLLINKPROGRAMPROC glLinkProgram = NULL;
+        PFNGLSHADERSOURCEPROC glShaderSource = NULL;
+        PFNGLUNIFORM1IPROC glUniform1i = NULL;
+        PFNGLUSEPROGRAMPROC glUseProgram = NULL;
+
+        PFNGLFENCESYNCPROC glFenceSync = NULL;
+        PFNGLDELETESYNCPROC glDeleteSync = NULL;
+        PFNGLWAITSYNCPROC glWaitSync = NULL;
+
         bool loadExtensions()
         {
             if (g_loaded)
@@ -67,6 +92,61 @@ namespace Guise
             return g_loadStatus;
         }
 
+        bool loadShaderExtensions()
+        {
+            if (g_shadersLoaded)
+            {
+                return g_shadersLoadStatus;
+            }
+
+            g_shadersLoadStatus = true;
+            g_shadersLoadStatus &= (glAttachShader = (PFNGLATTACHSHADERPROC)glGetProcAddress("glAttachShader")) != NULL;
+            g_shadersLoadStatus &= (glCompileShader = (PFNGLCOMPILESHADERPROC)glGetProcAddress("glCompileShader")) != NULL;
+            g_shadersLoadStatus &= (glCreateProgram = (PFNGLCREATEPROGRAMPROC)glGetProcAddress("glCreateProgram")) != NULL;
+            g_shadersLoadStatus &= (glCreateShader = (PFNGLCREATESHADERPROC)glGetProcAddress("glCreateShader")) != NULL;
+            g_shadersLoadStatus &= (glDeleteProgram = (PFNGLDELETEPROGRAMPROC)glGetProcAddress("glDeleteProgram")) != NULL;
+            g_shadersLoadStatus &= (glDeleteShader = (PFNGLDELETESHADERPROC)glGetProcAddress("glDeleteShader")) != NULL;
+            g_shadersLoadStatus &= (glGetProgramiv = (PFNGLGETPROGRAMIVPROC)glGetProcAddress("glGetProgramiv")) != NULL;
+            g_shadersLoadStatus &= (glGetShaderiv = (PFNGLGETSHADERIVPROC)glGetProcAddress("glGetShaderiv")) != NULL;
+            g_shadersLoadStatus &= (glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)glGetProcAddress("glGetUniformLocation")) != NULL;
+            g_shadersLoadStatus &= (glLinkProgram = (PFNGLLINKPROGRAMPROC)glGetProcAddress("glLinkProgram")) != NULL;
+            g_shadersLoadStatus &= (glShaderSource = (PFNGLSHADERSOURCEPROC)glGetProcAddress("glShaderSource")) != NULL;
+            g_shadersLoadStatus &= (glUniform1i = (PFNGLUNIFORM1IPROC)glGetProcAddress("glUniform1i")) != NULL;
+            g_shadersLoadStatus &= (glUseProgram = (PFNGLUSEPROGRAMPROC)glGetProcAddress("glUseProgram")) != NULL;
+
+            g_shadersLoaded = true;
+            return g_shadersLoadStatus;
+        }
+
+        bool loadSyncExtensions()
+        {
+            if (g_syncLoaded)
+            {
+                return g_syncLoadStatus;
+            }
+
+            // Function addresses may be returned for unsupported functions, check the version first.
+            int major = 0;
+            int minor = 0;
+            const char * version = reinterpret_cast<const char *>(::glGetString(GL_VERSION));
+            const char * extensions = reinterpret_cast<const char *>(::glGetString(GL_EXTENSIONS));
+            if (!version || std::sscanf(version, "%d.%d", &major, &minor) != 2)
+            {
+                return false;
+            }
+
+            g_syncLoadStatus = major > 3 || (major == 3 && minor >= 2) || (extensions && std::strstr(extensions, "GL_ARB_sync"));
+            if (g_syncLoadStatus)
+            {
+                g_syncLoadStatus &= (glFenceSync = (PFNGLFENCESYNCPROC)glGetProcAddress("glFenceSync")) != NULL;
+                g_syncLoadStatus &= (glDeleteSync = (PFNGLDELETESYNCPROC)glGetProcAddress("glDeleteSync")) != NULL;
+                g_syncLoadStatus &= (glWaitSync = (PFNGLWAITSYNCPROC)glGetProcAddress("glWaitSync")) != NULL;
+            }
+
+            g_syncLoaded = true;
+            return g_syncLoadStatus;
+        }
+
     }
     
 }
@@ -30,6 +30,12 @@
 #include "guise/renderer/opengl/openglTexture.hpp"
 #include "guise/math/matrix.hpp"
 #include "guise/appWindow.hpp"
+#include <cmath>
+#include <cstring>
+
+#if defined(GUISE_PLATFORM_LINUX) && !defined(GLX_BACK_BUFFER_AGE_EXT)
+    #define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+#endif
 
 namespace Guise
 {
@@ -46,7 +52,15 @@ namespace Guise
 
     void OpenGLRenderer::drawRect(const Bounds2f & bounds, const Style::PaintRectStyle & style)
     {
-        drawQuad(bounds, style.getBackgroundColor());
+        auto & gradient = style.getBackgroundGradient();
+        if (gradient)
+        {
+            drawQuad(bounds, *gradient);
+        }
+        else
+        {
+            drawQuad(bounds, style.getBackgroundColor());
+        }
 
         const bool border = style.getBorderStyle() != Style::Property::BorderStyle::None && style.getBorderWidth();
         if (border)
@@ -64,63 +78,71 @@ namespace Guise
             newBounds.innerJoin(m_maskStack.top());
         }
 
-        glDisable(GL_TEXTURE_2D);
-        glBegin(GL_QUADS);
-
-        glColor4f(color.x, color.y, color.z, color.w);
-        glVertex3f(newBounds.position.x, newBounds.position.y, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y + newBounds.size.y, m_level);
-        glVertex3f(newBounds.position.x, newBounds.position.y + newBounds.size.y, m_level);
-
-        glEnd();
+        pushQuadVertex(newBounds.position.x, newBounds.position.y, color);
+        pushQuadVertex(newBounds.position.x + newBounds.size.x, newBounds.position.y, color);
+        pushQuadVertex(newBounds.position.x + newBounds.size.x, newBounds.position.y + newBounds.size.y, color);
+        pushQuadVertex(newBounds.position.x, newBounds.position.y + newBounds.size.y, color);
     }
 
-    void OpenGLRenderer::drawQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color)
+    void OpenGLRenderer::drawQuad(const Bounds2f & bounds, const Style::LinearGradient & gradient)
     {
-        Bounds2f newBounds = Bounds2f::floor(bounds);
-
-        Vector2f newTexCoords[2] = { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+        const Bounds2f gradientBounds = Bounds2f::floor(bounds);
+        Bounds2f newBounds = gradientBounds;
 
         if (m_maskStack.size())
         {
-            Vector2f boundsVec[2] =
-            {
-                newBounds.position, newBounds.position + newBounds.size
-            };
-
             newBounds.innerJoin(m_maskStack.top());
+        }
 
-            Vector2f maskVec[2] =
-            {
-                newBounds.position, newBounds.position + newBounds.size
-            };            
-            
-            newTexCoords[0].x =        ((maskVec[0].x - boundsVec[0].x) / (boundsVec[1].x - boundsVec[0].x));
-            newTexCoords[0].y = 1.0f - ((maskVec[1].y - boundsVec[0].y) / (boundsVec[1].y - boundsVec[0].y));
-            newTexCoords[1].x =        ((maskVec[1].x - boundsVec[0].x) / (boundsVec[1].x - boundsVec[0].x));
-            newTexCoords[1].y = 1.0f - ((maskVec[0].y - boundsVec[0].y) / (boundsVec[1].y - boundsVec[0].y));
+        // Linear gradients are linear in position, interpolated corner colors are exact at any angle.
+        const Vector2f corners[4] =
+        {
+            newBounds.position,
+            { newBounds.position.x + newBounds.size.x, newBounds.position.y },
+            newBounds.position + newBounds.size,
+            { newBounds.position.x, newBounds.position.y + newBounds.size.y }
+        };
+        for (auto & corner : corners)
+        {
+            pushQuadVertex(corner.x, corner.y, gradient.getColor(gradientBounds, corner));
         }
+    }
 
+    void OpenGLRenderer::drawQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color)
+    {
+        flushQuads();
         glEnable(GL_TEXTURE_2D);
         texture->bind(0);
 
-        glBegin(GL_QUADS);
-        glColor4f(color.x, color.y, color.z, color.w);
-
-        glTexCoord2f(newTexCoords[0].x, newTexCoords[1].y);
-        glVertex3f(newBounds.position.x, newBounds.position.y, m_level);
+        drawTexturedQuad(bounds, color);
 
-        glTexCoord2f(newTexCoords[1].x, newTexCoords[1].y);
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y, m_level);
+        texture->unbind();
+    }
 
-        glTexCoord2f(newTexCoords[1].x, newTexCoords[0].y);
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y + newBounds.size.y, m_level);
+    void OpenGLRenderer::drawDistanceFieldQuad(const Bounds2f & bounds, const std::shared_ptr<Texture> & texture, const Vector4f & color)
+    {
+        flushQuads();
+        glEnable(GL_TEXTURE_2D);
+        texture->bind(0);
 
-        glTexCoord2f(newTexCoords[0].x, newTexCoords[0].y);
-        glVertex3f(newBounds.position.x, newBounds.position.y + newBounds.size.y, m_level);
+        // Distances are interpolated, not sampled.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glEnd();
+        if (loadDistanceFieldProgram())
+        {
+            OpenGL::glUseProgram(m_distanceFieldProgram);
+            drawTexturedQuad(bounds, color);
+            OpenGL::glUseProgram(0);
+        }
+        else
+        {
+            // Fixed function fallback, hard edges via alpha testing.
+            glEnable(GL_ALPHA_TEST);
+            glAlphaFunc(GL_GEQUAL, 0.5f * color.w);
+            drawTexturedQuad(bounds, color);
+            glDisable(GL_ALPHA_TEST);
+        }
 
         texture->unbind();
     }
@@ -134,33 +156,30 @@ namespace Guise
         const float widthX = newBounds.size.x > sWidth ? sWidth : newBounds.size.x;
         const float widthY = newBounds.size.y > sWidth ? sWidth : newBounds.size.y;
 
-        glDisable(GL_TEXTURE_2D);
-        glBegin(GL_QUADS);
-
-        glColor4f(color.x, color.y, color.z, color.w);
-
-        glVertex3f(newBounds.position.x, newBounds.position.y, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x , newBounds.position.y, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x - widthX, newBounds.position.y + widthY, m_level);
-        glVertex3f(newBounds.position.x + widthX, newBounds.position.y + widthY, m_level);
-
-        glVertex3f(newBounds.position.x + widthX, newBounds.position.y + newBounds.size.y - widthY, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x - widthX, newBounds.position.y + newBounds.size.y - widthY, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y + newBounds.size.y, m_level);
-        glVertex3f(newBounds.position.x, newBounds.position.y + newBounds.size.y, m_level);
-
-        glVertex3f(newBounds.position.x, newBounds.position.y, m_level);
-        glVertex3f(newBounds.position.x + widthX, newBounds.position.y + widthY, m_level);
-        glVertex3f(newBounds.position.x + widthX, newBounds.position.y + newBounds.size.y - widthY, m_level);
-        glVertex3f(newBounds.position.x, newBounds.position.y + newBounds.size.y, m_level);
-
-
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y + newBounds.size.y, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x - widthX, newBounds.position.y + newBounds.size.y - widthY, m_level);
-        glVertex3f(newBounds.position.x + newBounds.size.x - widthX, newBounds.position.y + widthY, m_level);
-
-        glEnd();
+        const float left = newBounds.position.x;
+        const float top = newBounds.position.y;
+        const float right = newBounds.position.x + newBounds.size.x;
+        const float bottom = newBounds.position.y + newBounds.size.y;
+
+        pushQuadVertex(left, top, color);
+        pushQuadVertex(right, top, color);
+        pushQuadVertex(right - widthX, top + widthY, color);
+        pushQuadVertex(left + widthX, top + widthY, color);
+
+        pushQuadVertex(left + widthX, bottom - widthY, color);
+        pushQuadVertex(right - widthX, bottom - widthY, color);
+        pushQuadVertex(right, bottom, color);
+        pushQuadVertex(left, bottom, color);
+
+        pushQuadVertex(left, top, color);
+        pushQuadVertex(left + widthX, top + widthY, color);
+        pushQuadVertex(left + widthX, bottom - widthY, color);
+        pushQuadVertex(left, bottom, color);
+
+        pushQuadVertex(right, top, color);
+        pushQuadVertex(right, bottom, color);
+        pushQuadVertex(right - widthX, bottom - widthY, color);
+        pushQuadVertex(right - widthX, top + widthY, color);
     }
 
     void OpenGLRenderer::drawLine(const Vector2f & point1, const Vector2f & point2, const float width, const Vector4f & color)
@@ -168,6 +187,7 @@ namespace Guise
         Vector2f p1 = point1 * m_scale;
         Vector2f p2 = point2 * m_scale;
 
+        flushQuads();
         glDisable(GL_TEXTURE_2D);
         glLineWidth(width * m_scale);
         glBegin(GL_LINES);
@@ -198,28 +218,36 @@ namespace Guise
         return std::make_shared<OpenGLTexture>();
     }
 
-    std::shared_ptr<OpenGLRenderer> OpenGLRenderer::create(const std::shared_ptr<AppWindow> & appWindow)
+    uint64_t OpenGLRenderer::getResourceGroup() const
+    {
+        return m_resourceGroup->id;
+    }
+
+    std::shared_ptr<OpenGLRenderer> OpenGLRenderer::create(const std::shared_ptr<AppWindow> & appWindow,
+                                                           const std::shared_ptr<OpenGLRenderer> & shareRenderer)
     {
     #if defined(GUISE_PLATFORM_WINDOWS)
         auto windowContext = appWindow->getWin32HDC();
-        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(windowContext));
+        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(windowContext, shareRenderer));
     #elif defined(GUISE_PLATFORM_LINUX)
         auto display = appWindow->getLinuxDisplay();
         auto window = appWindow->getLinuxWindow();
         auto screen = appWindow->getLinuxScreen();
-        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(display, window, screen));
+        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(display, window, screen, shareRenderer));
     #endif
     }
 
 #if defined(GUISE_PLATFORM_WINDOWS)
-    std::shared_ptr<OpenGLRenderer> OpenGLRenderer::create(::HDC deviceContextHandle)
+    std::shared_ptr<OpenGLRenderer> OpenGLRenderer::create(::HDC deviceContextHandle,
+                                                           const std::shared_ptr<OpenGLRenderer> & shareRenderer)
     {
-        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(deviceContextHandle));
+        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(deviceContextHandle, shareRenderer));
     }
-#elif defined(GUISE_PLATFORM_WINDOWS)
-    std::shared_ptr<OpenGLRenderer> OpenGLRenderer::create(::Display * display, ::Window window, int screen)
+#elif defined(GUISE_PLATFORM_LINUX)
+    std::shared_ptr<OpenGLRenderer> OpenGLRenderer::create(::Display * display, ::Window window, int screen,
+                                                           const std::shared_ptr<OpenGLRenderer> & shareRenderer)
     {
-        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(display, window, screen));
+        return std::shared_ptr<OpenGLRenderer>(new OpenGLRenderer(display, window, screen, shareRenderer));
     }
 #endif
 
@@ -236,6 +264,7 @@ namespace Guise
 
     void OpenGLRenderer::setViewportSize(const Vector2ui32 & position, const Vector2ui32 & size)
     {
+        flushQuads();
         m_viewPort = { position, size };
         glViewport(position.x, position.y, size.x, size.y);
         updateProjectionMatrix();
@@ -248,16 +277,19 @@ namespace Guise
 
     void OpenGLRenderer::clearColor()
     {
+        flushQuads();
         glClear(GL_COLOR_BUFFER_BIT);
     }
 
     void OpenGLRenderer::clearDepth()
     {
+        flushQuads();
         glClear(GL_DEPTH_BUFFER_BIT);
     }
 
     void OpenGLRenderer::present()
     {
+        flushQuads();
     #if defined(GUISE_PLATFORM_WINDOWS)
         ::SwapBuffers(m_deviceContextHandle);
     #elif defined(GUISE_PLATFORM_LINUX)
@@ -265,6 +297,207 @@ namespace Guise
     #endif
     }
 
+    uint32_t OpenGLRenderer::getBufferAge()
+    {
+    #if defined(GUISE_PLATFORM_LINUX)
+        if (m_bufferAgeSupported)
+        {
+            unsigned int age = 0;
+            glXQueryDrawable(m_display, m_window, GLX_BACK_BUFFER_AGE_EXT, &age);
+            return static_cast<uint32_t>(age);
+        }
+    #endif
+        return 0;
+    }
+
+    void OpenGLRenderer::setScissor(const Bounds2f & bounds)
+    {
+        flushQuads();
+
+        // Window coordinates start at the bottom left, round outwards to whole pixels.
+        const float left = std::floor(bounds.position.x * m_scale);
+        const float top = std::floor(bounds.position.y * m_scale);
+        const float right = std::ceil((bounds.position.x + bounds.size.x) * m_scale);
+        const float bottom = std::ceil((bounds.position.y + bounds.size.y) * m_scale);
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(m_viewPort.position.x + static_cast<GLint>(left),
+                  m_viewPort.position.y + m_viewPort.size.y - static_cast<GLint>(bottom),
+                  static_cast<GLsizei>(right - left), static_cast<GLsizei>(bottom - top));
+    }
+
+    void OpenGLRenderer::resetScissor()
+    {
+        flushQuads();
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    void OpenGLRenderer::makeCurrent()
+    {
+    #if defined(GUISE_PLATFORM_WINDOWS)
+        if (::wglGetCurrentContext() != m_context)
+        {
+            ::wglMakeCurrent(m_deviceContextHandle, m_context);
+        }
+    #elif defined(GUISE_PLATFORM_LINUX)
+        if (::glXGetCurrentContext() != m_context)
+        {
+            ::glXMakeCurrent(m_display, m_window, m_context);
+        }
+    #endif
+    }
+
+    void OpenGLRenderer::drawTexturedQuad(const Bounds2f & bounds, const Vector4f & color)
+    {
+        Bounds2f newBounds = Bounds2f::floor(bounds);
+
+        Vector2f newTexCoords[2] = { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+
+        if (m_maskStack.size())
+        {
+            Vector2f boundsVec[2] =
+            {
+                newBounds.position, newBounds.position + newBounds.size
+            };
+
+            newBounds.innerJoin(m_maskStack.top());
+
+            Vector2f maskVec[2] =
+            {
+                newBounds.position, newBounds.position + newBounds.size
+            };            
+            
+            newTexCoords[0].x =        ((maskVec[0].x - boundsVec[0].x) / (boundsVec[1].x - boundsVec[0].x));
+            newTexCoords[0].y = 1.0f - ((maskVec[1].y - boundsVec[0].y) / (boundsVec[1].y - boundsVec[0].y));
+            newTexCoords[1].x =        ((maskVec[1].x - boundsVec[0].x) / (boundsVec[1].x - boundsVec[0].x));
+            newTexCoords[1].y = 1.0f - ((maskVec[0].y - boundsVec[0].y) / (boundsVec[1].y - boundsVec[0].y));
+        }
+
+        glBegin(GL_QUADS);
+        glColor4f(color.x, color.y, color.z, color.w);
+
+        glTexCoord2f(newTexCoords[0].x, newTexCoords[1].y);
+        glVertex3f(newBounds.position.x, newBounds.position.y, m_level);
+
+        glTexCoord2f(newTexCoords[1].x, newTexCoords[1].y);
+        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y, m_level);
+
+        glTexCoord2f(newTexCoords[1].x, newTexCoords[0].y);
+        glVertex3f(newBounds.position.x + newBounds.size.x, newBounds.position.y + newBounds.size.y, m_level);
+
+        glTexCoord2f(newTexCoords[0].x, newTexCoords[0].y);
+        glVertex3f(newBounds.position.x, newBounds.position.y + newBounds.size.y, m_level);
+
+        glEnd();
+    }
+
+    void OpenGLRenderer::pushQuadVertex(const float x, const float y, const Vector4f & color)
+    {
+        m_quadVertices.push_back({ { x, y, m_level }, { color.x, color.y, color.z, color.w } });
+    }
+
+    void OpenGLRenderer::flushQuads()
+    {
+        if (m_quadVertices.empty())
+        {
+            return;
+        }
+
+        glDisable(GL_TEXTURE_2D);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(QuadVertex), m_quadVertices[0].position);
+        glColorPointer(4, GL_FLOAT, sizeof(QuadVertex), m_quadVertices[0].color);
+
+        glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(m_quadVertices.size()));
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        m_quadVertices.clear();
+    }
+
+    static GLuint compileShader(const GLenum type, const char * source)
+    {
+        const GLuint shader = OpenGL::glCreateShader(type);
+        OpenGL::glShaderSource(shader, 1, &source, NULL);
+        OpenGL::glCompileShader(shader);
+
+        GLint status = GL_FALSE;
+        OpenGL::glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (status != GL_TRUE)
+        {
+            OpenGL::glDeleteShader(shader);
+            return 0;
+        }
+
+        return shader;
+    }
+
+    bool OpenGLRenderer::loadDistanceFieldProgram()
+    {
+        if (m_distanceFieldProgramLoaded)
+        {
+            return m_distanceFieldProgram != 0;
+        }
+        m_distanceFieldProgramLoaded = true;
+
+        if (!OpenGL::loadShaderExtensions())
+        {
+            return false;
+        }
+
+        static const char * vertexSource =
+            "#version 110\n"
+            "void main()\n"
+            "{\n"
+            "    gl_FrontColor = gl_Color;\n"
+            "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+            "    gl_Position = ftransform();\n"
+            "}\n";
+
+        // Smooth edges over one screen pixel, whatever the scale of the quad.
+        static const char * fragmentSource =
+            "#version 110\n"
+            "uniform sampler2D distanceField;\n"
+            "void main()\n"
+            "{\n"
+            "    float distance = texture2D(distanceField, gl_TexCoord[0].xy).a;\n"
+            "    float width = max(fwidth(distance) * 0.5, 0.001);\n"
+            "    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+            "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+            "}\n";
+
+        const GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+        const GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+        if (!vertexShader || !fragmentShader)
+        {
+            OpenGL::glDeleteShader(vertexShader);
+            OpenGL::glDeleteShader(fragmentShader);
+            return false;
+        }
+
+        const GLuint program = OpenGL::glCreateProgram();
+        OpenGL::glAttachShader(program, vertexShader);
+        OpenGL::glAttachShader(program, fragmentShader);
+        OpenGL::glLinkProgram(program);
+        OpenGL::glDeleteShader(vertexShader);
+        OpenGL::glDeleteShader(fragmentShader);
+
+        GLint status = GL_FALSE;
+        OpenGL::glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status != GL_TRUE)
+        {
+            OpenGL::glDeleteProgram(program);
+            return false;
+        }
+
+        OpenGL::glUseProgram(program);
+        OpenGL::glUniform1i(OpenGL::glGetUniformLocation(program, "distanceField"), 0);
+        OpenGL::glUseProgram(0);
+
+        m_distanceFieldProgram = program;
+        return true;
+    }
+
     void OpenGLRenderer::updateProjectionMatrix()
     {
         Matrix4x4f orthoMat;
@@ -276,8 +509,10 @@ namespace Guise
     }
 
 #if defined(GUISE_PLATFORM_WINDOWS)
-    OpenGLRenderer::OpenGLRenderer(HDC deviceContextHandle) :
+    OpenGLRenderer::OpenGLRenderer(HDC deviceContextHandle, const std::shared_ptr<OpenGLRenderer> & shareRenderer) :
         m_deviceContextHandle(deviceContextHandle),
+        m_distanceFieldProgram(0),
+        m_distanceFieldProgramLoaded(false),
         m_scale(1.0f),
         m_level(0.0f)
     {
@@ -320,6 +555,18 @@ namespace Guise
             throw std::runtime_error("Failed to create OpenGL context..");
         }
 
+        // Objects are shared before any is created in the new context.
+        if (shareRenderer && ::wglShareLists(shareRenderer->m_resourceGroup->context, m_context))
+        {
+            m_resourceGroup = shareRenderer->m_resourceGroup;
+        }
+        else
+        {
+            m_resourceGroup = std::make_shared<ResourceGroup>();
+            m_resourceGroup->id = RendererInterface::getResourceGroup();
+            m_resourceGroup->context = m_context;
+        }
+
         wglMakeCurrent(NULL, NULL);
         wglMakeCurrent(deviceContextHandle, m_context);
 
@@ -337,10 +584,13 @@ namespace Guise
     }
 
 #elif defined(GUISE_PLATFORM_LINUX)
-    OpenGLRenderer::OpenGLRenderer(::Display * display, ::Window window, int screen) :
+    OpenGLRenderer::OpenGLRenderer(::Display * display, ::Window window, int screen, const std::shared_ptr<OpenGLRenderer> & shareRenderer) :
         m_context(NULL),
         m_display(display),
         m_window(window),
+        m_bufferAgeSupported(false),
+        m_distanceFieldProgram(0),
+        m_distanceFieldProgramLoaded(false),
         m_scale(1.0f),
         m_level(0.0f)
     {
@@ -386,20 +636,45 @@ namespace Guise
         // Set the new color map
         //XSetWindowColormap(m_display, m_window, m_colormap);
 
-        // Create a temporary context.
-        m_context = glXCreateContext(m_display, visualInfo, NULL, GL_TRUE);
+        // Create a temporary context, sharing objects with the resource group of shareRenderer.
+        ::GLXContext shareContext = shareRenderer ? shareRenderer->m_resourceGroup->context : NULL;
+        m_context = glXCreateContext(m_display, visualInfo, shareContext, GL_TRUE);
+        if(!m_context && shareContext)
+        {
+            shareContext = NULL;
+            m_context = glXCreateContext(m_display, visualInfo, NULL, GL_TRUE);
+        }
         if(!m_context)
         {
             XFree(visualInfo);
             throw std::runtime_error("Cannot create OpenGL context.");
         }
 
+        if (shareContext)
+        {
+            m_resourceGroup = shareRenderer->m_resourceGroup;
+        }
+        else
+        {
+            m_resourceGroup = std::make_shared<ResourceGroup>();
+            m_resourceGroup->id = RendererInterface::getResourceGroup();
+            m_resourceGroup->context = m_context;
+        }
+
         // Make the temporary context to the current one.
         glXMakeCurrent(m_display, m_window, m_context);
 
         // Clear the visual info since we are done with it.
         XFree(visualInfo);
 
+        if (!OpenGL::loadExtensions())
+        {
+            throw std::runtime_error("Missing OpenGL extensions.");
+        }
+
+        const char * extensions = glXQueryExtensionsString(m_display, screen);
+        m_bufferAgeSupported = extensions && std::strstr(extensions, "GLX_EXT_buffer_age");
+
         glEnable(GL_COLOR_MATERIAL);
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
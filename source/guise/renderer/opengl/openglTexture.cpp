@@ -40,7 +40,8 @@ namespace Guise
     OpenGLTexture::OpenGLTexture() :
         m_dimensions(0, 0),
         m_id(0),
-        m_pixelFormat(PixelFormat::RGBA8)
+        m_pixelFormat(PixelFormat::RGBA8),
+        m_uploadFence(nullptr)
     { }
 
     OpenGLTexture::OpenGLTexture(const uint8_t * data, const PixelFormat pixelFormat, const Vector2ui32 & dimensions) :
@@ -51,18 +52,12 @@ namespace Guise
 
     OpenGLTexture::~OpenGLTexture()
     {
-        if (m_id)
-        {
-            glDeleteTextures(1, &m_id);
-        }
+        deleteTexture();
     }
 
     void OpenGLTexture::load(const uint8_t * data, const PixelFormat pixelFormat, const Vector2ui32 & dimensions)
     {
-        if (m_id)
-        {
-            glDeleteTextures(1, &m_id);
-        }
+        deleteTexture();
 
         m_dimensions = dimensions;
         m_pixelFormat = pixelFormat;
@@ -83,20 +78,34 @@ namespace Guise
 
         // Unbind the texture
         glBindTexture(GL_TEXTURE_2D, 0);
+
+        // Other contexts of the resource group may only use the texture once the upload is complete.
+        // Flushing does not guarantee completion, a fence is waited for by bind, or the upload is finished here.
+        if (OpenGL::loadSyncExtensions())
+        {
+            m_uploadFence = OpenGL::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+        }
+        else
+        {
+            glFinish();
+        }
     }
 
     void OpenGLTexture::unload()
     {
-        if (m_id)
-        {
-            glDeleteTextures(1, &m_id);
-            m_id = 0;
-            m_dimensions = {0, 0};
-        }
+        deleteTexture();
+        m_dimensions = {0, 0};
     }
 
     void OpenGLTexture::bind(const size_t index) const
     {
+        // Waits on the GPU, without blocking the calling thread. Signaled fences are passed right away.
+        if (m_uploadFence)
+        {
+            OpenGL::glWaitSync(m_uploadFence, 0, GL_TIMEOUT_IGNORED);
+        }
+
         OpenGL::glActiveTexture(GL_TEXTURE0 + index);
         ::glBindTexture(GL_TEXTURE_2D, m_id);
     }
@@ -106,6 +115,20 @@ namespace Guise
         ::glBindTexture(GL_TEXTURE_2D, 0);
     }
 
+    void OpenGLTexture::deleteTexture()
+    {
+        if (m_uploadFence)
+        {
+            OpenGL::glDeleteSync(m_uploadFence);
+            m_uploadFence = nullptr;
+        }
+        if (m_id)
+        {
+            glDeleteTextures(1, &m_id);
+            m_id = 0;
+        }
+    }
+
     Texture::PixelFormat OpenGLTexture::getPixelFormat() const
     {
         return m_pixelFormat;
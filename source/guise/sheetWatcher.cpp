@@ -0,0 +1,186 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/sheetWatcher.hpp"
+#include <chrono>
+#include <filesystem>
+
+#if defined(GUISE_PLATFORM_LINUX)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace Guise
+{
+
+    namespace Style
+    {
+
+        namespace fs = std::filesystem;
+
+        static const int g_pollInterval = 100; ///< Milliseconds between checks of the running flag or file time.
+
+        std::shared_ptr<SheetWatcher> SheetWatcher::create(const std::string & filename, const std::shared_ptr<Sheet> & base)
+        {
+            return std::shared_ptr<SheetWatcher>(new SheetWatcher(filename, base));
+        }
+
+        SheetWatcher::~SheetWatcher()
+        {
+            m_running = false;
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        const std::string & SheetWatcher::getFilename() const
+        {
+            return m_filename;
+        }
+
+        std::shared_ptr<Sheet> SheetWatcher::poll()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return std::move(m_sheet);
+        }
+
+        std::string SheetWatcher::getError() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_error;
+        }
+
+        SheetWatcher::SheetWatcher(const std::string & filename, const std::shared_ptr<Sheet> & base) :
+            m_filename(filename),
+            m_base(base),
+            m_running(true)
+        {
+            m_thread = std::thread([this]()
+            {
+                run();
+            });
+        }
+
+        void SheetWatcher::reload()
+        {
+            std::string error;
+            auto sheet = Sheet::load(m_filename, &error, m_base.get());
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = error;
+            if (sheet)
+            {
+                m_sheet = sheet;
+            }
+        }
+
+        void SheetWatcher::run()
+        {
+            reload();
+
+            if (!watchNotifications())
+            {
+                watchFileTime();
+            }
+        }
+
+        bool SheetWatcher::watchNotifications()
+        {
+#if defined(GUISE_PLATFORM_LINUX)
+            // Watch the directory, editors commonly replace files by renaming.
+            const fs::path path(m_filename);
+            const std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+            const std::string name = path.filename().string();
+
+            const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd < 0)
+            {
+                return false;
+            }
+            if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+            {
+                close(fd);
+                return false;
+            }
+
+            alignas(inotify_event) char buffer[4096];
+            while (m_running)
+            {
+                pollfd pollData = { fd, POLLIN, 0 };
+                if (::poll(&pollData, 1, g_pollInterval) <= 0)
+                {
+                    continue;
+                }
+
+                bool changed = false;
+                ssize_t length = 0;
+                while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (char * it = buffer; it < buffer + length; )
+                    {
+                        auto event = reinterpret_cast<const inotify_event *>(it);
+                        if (event->len && name == event->name)
+                        {
+                            changed = true;
+                        }
+                        it += sizeof(inotify_event) + event->len;
+                    }
+                }
+
+                if (changed)
+                {
+                    reload();
+                }
+            }
+
+            close(fd);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        void SheetWatcher::watchFileTime()
+        {
+            std::error_code error;
+            auto lastTime = fs::last_write_time(m_filename, error);
+            while (m_running)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(g_pollInterval));
+
+                auto time = fs::last_write_time(m_filename, error);
+                if (!error && time != lastTime)
+                {
+                    lastTime = time;
+                    reload();
+                }
+            }
+        }
+
+    }
+
+}
@@ -27,7 +27,12 @@
 #include "guise/defaultStyles.hpp"
 #include "guise/control.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Guise
 {
@@ -40,55 +45,335 @@ namespace Guise
         // External definitions.
         float const FitParent = -1.0f;
         float const FitContent = 0.0f;
-
         // Helper functions and data
-        /*static const std::string g_emptyString = "";
-
-        static const std::string g_PropBackgroundColorName = "background-color";
-        static const std::string g_PropBackgroundImageName = "background-image";
-        static const std::string g_PropBorderColorName = "border-color";
-        static const std::string g_PropBorderStyleName = "border-style";
-        static const std::string g_PropBorderWidthName = "border-width";
-        static const std::string g_PropOverflowName = "overflow";
-        static const std::string g_PropPaddingName = "padding";
-        static const std::string g_PropPositionName = "position";
-        static const std::string g_PropSizeName = "size";
-
-        static const std::string g_SelButtonName = "button";
-        static const std::string g_SelCanvasName = "canvas";
-        static const std::string g_SelPlaneName = "plane";
-        static const std::string g_SelWindowName = "window";
-
-        static const std::string & getPropertyName(const Property::Type type)
-        {
-            switch (type)
-            {
-            case Property::Type::BackgroundColor: return g_PropBackgroundColorName;
-                case Property::Type::BackgroundImage: return g_PropBackgroundImageName;
-                case Property::Type::BorderColor: return g_PropBorderColorName;
-                case Property::Type::BorderStyle: return g_PropBorderStyleName;
-                case Property::Type::BorderWidth: return g_PropBorderWidthName;
-                case Property::Type::Overflow: return g_PropOverflowName;
-                case Property::Type::Padding: return g_PropPaddingName;
-                case Property::Type::Position: return g_PropPositionName;
-                case Property::Type::Size: return g_PropSizeName;
-                default: break;
+        template<typename Id>
+        class AtomTable
+        {
+
+        public:
+
+            AtomTable(const std::initializer_list<std::pair<const char *, Id> > & atoms)
+            {
+                for (auto & atom : atoms)
+                {
+                    if (static_cast<size_t>(atom.second) == m_names.size())
+                    {
+                        m_names.push_back(atom.first);
+                    }
+                    m_ids.insert({ atom.first, atom.second });
+                }
+            }
+
+            Id intern(const std::string & name)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_ids.find(name);
+                if (it != m_ids.end())
+                {
+                    return it->second;
+                }
+
+                const Id id = static_cast<Id>(m_names.size());
+                m_names.push_back(name);
+                m_ids.insert({ name, id });
+                return id;
             }
-            return g_emptyString;
+
+            bool find(const std::string & name, Id & id)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_ids.find(name);
+                if (it == m_ids.end())
+                {
+                    return false;
+                }
+                id = it->second;
+                return true;
+            }
+
+            const std::string & getName(const Id id)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                const size_t index = static_cast<size_t>(id);
+                return index < m_names.size() ? m_names[index] : g_emptyString;
+            }
+
+        private:
+
+            std::mutex m_mutex;
+            std::unordered_map<std::string, Id> m_ids;
+            std::deque<std::string> m_names; ///< Deque keeps returned name references valid.
+
+        };
+
+        static AtomTable<PropertyId> & getPropertyAtoms()
+        {
+            static AtomTable<PropertyId> atoms =
+            {
+                { "background-color",       PropertyId::BackgroundColor },
+                { "border-color",           PropertyId::BorderColor },
+                { "border-style",           PropertyId::BorderStyle },
+                { "border-width",           PropertyId::BorderWidth },
+                { "font-background-color",  PropertyId::FontBackgroundColor },
+                { "font-color",             PropertyId::FontColor },
+                { "font-family",            PropertyId::FontFamily },
+                { "font-size",              PropertyId::FontSize },
+                { "horizontal-align",       PropertyId::HorizontalAlign },
+                { "margin",                 PropertyId::Margin },
+                { "overflow",               PropertyId::Overflow },
+                { "padding",                PropertyId::Padding },
+                { "position",               PropertyId::Position },
+                { "size",                   PropertyId::Size },
+                { "vertical-align",         PropertyId::VerticalAlign },
+                { "transition-duration",    PropertyId::TransitionDuration },
+                { "background-gradient",    PropertyId::BackgroundGradient },
+                { "hori-align",             PropertyId::HorizontalAlign },
+                { "vert-align",             PropertyId::VerticalAlign }
+            };
+            return atoms;
         }
 
-        static const std::string & getSelectorName(const Selector::Type type)
+        static AtomTable<SelectorId> & getSelectorAtoms()
         {
-            switch (type)
+            static AtomTable<SelectorId> atoms =
             {
-                case Selector::Type::Button: return g_SelButtonName;
-                case Selector::Type::Canvas: return g_SelCanvasName;
-                case Selector::Type::Plane: return g_SelPlaneName;
-                case Selector::Type::Window: return g_SelWindowName;
-                default: break;
+                { "button",                     SelectorId::Button },
+                { "button:active",              SelectorId::ButtonActive },
+                { "button:disabled",            SelectorId::ButtonDisabled },
+                { "button:hover",               SelectorId::ButtonHover },
+                { "canvas",                     SelectorId::Canvas },
+                { "checkbox",                   SelectorId::Checkbox },
+                { "checkbox:checked",           SelectorId::CheckboxChecked },
+                { "checkbox:checked:disabled",  SelectorId::CheckboxCheckedDisabled },
+                { "checkbox:checked:hover",     SelectorId::CheckboxCheckedHover },
+                { "checkbox:disabled",          SelectorId::CheckboxDisabled },
+                { "checkbox:hover",             SelectorId::CheckboxHover },
+                { "horizontal-grid",            SelectorId::HorizontalGrid },
+                { "horizontal-grid-slot",       SelectorId::HorizontalGridSlot },
+                { "label",                      SelectorId::Label },
+                { "plane",                      SelectorId::Plane },
+                { "tab-window",                 SelectorId::TabWindow },
+                { "tab-window-tab",             SelectorId::TabWindowTab },
+                { "text-box",                   SelectorId::TextBox },
+                { "text-box-text",              SelectorId::TextBoxText },
+                { "vertical-grid",              SelectorId::VerticalGrid },
+                { "vertical-grid-slot",         SelectorId::VerticalGridSlot },
+                { "window",                     SelectorId::Window },
+                { "checkbox:checkedDisabled",   SelectorId::CheckboxCheckedDisabled },
+                { "checkbox:checkedHover",      SelectorId::CheckboxCheckedHover }
+            };
+            return atoms;
+        }
+
+        static const std::string * internString(const std::string & value)
+        {
+            static std::mutex mutex;
+            static std::unordered_set<std::string> strings;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            return &*strings.insert(value).first;
+        }
+
+        static_assert(static_cast<size_t>(PropertyId::Count) <= 32, "Property bit masks of Block hold at most 32 built-in properties.");
+
+        static uint32_t getPropertyBit(const PropertyId id)
+        {
+            return static_cast<uint32_t>(1) << static_cast<uint32_t>(id);
+        }
+
+        static std::atomic<size_t> g_blockCount(0);
+
+        // Get the block of a style for modification, copying it if shared with a selector or another style.
+        static Block & detachBlock(std::shared_ptr<Block> & block)
+        {
+            if (!block)
+            {
+                block = std::make_shared<Block>();
+            }
+            else if (block.use_count() > 1)
+            {
+                // Animation state is not copied by Block, the copy is still released by releaseAnimatedValues.
+                auto copy = std::make_shared<Block>(*block);
+                copy->animationSource = block->animationSource;
+                copy->animationRest = block->animationRest ? std::make_unique<Block>(*block->animationRest) : nullptr;
+                copy->animatedProperties = block->animatedProperties;
+                block = copy;
+            }
+            return *block;
+        }
+
+        // Get a property of block, nullptr if the block or the property is empty.
+        template<typename T>
+        static const T * findProperty(const std::shared_ptr<Block> & block, std::optional<T> Block::* member)
+        {
+            if (block)
+            {
+                auto & property = (*block).*member;
+                if (property.has_value())
+                {
+                    return &property.value();
+                }
+            }
+            return nullptr;
+        }
+
+        // Set a property explicitly, returns true if the value changed.
+        template<typename T>
+        static bool setBlockProperty(std::shared_ptr<Block> & block, std::optional<T> Block::* member, const T & value, const PropertyId id)
+        {
+            Block & detached = detachBlock(block);
+            detached.localProperties |= getPropertyBit(id);
+
+            auto & property = detached.*member;
+            if (property.has_value() && property.value() == value)
+            {
+                return false;
+            }
+            property = value;
+            return true;
+        }
+
+        // Share the block of selector, keeping the properties set explicitly.
+        static void assignSheetBlock(std::shared_ptr<Block> & block, const Selector * selector)
+        {
+            const uint32_t localProperties = block ? block->localProperties : 0;
+            auto sheetBlock = selector ? selector->getBlock() : nullptr;
+            if (!localProperties)
+            {
+                block = sheetBlock;
+                return;
+            }
+
+            auto newBlock = sheetBlock ? std::make_shared<Block>(*sheetBlock) : std::make_shared<Block>();
+            newBlock->copyProperties(*block, localProperties);
+            newBlock->localProperties = localProperties;
+            block = newBlock;
+        }
+
+        // Drop the sheet properties and animated values of block, keeping the properties set explicitly.
+        static void resetSheetBlock(std::shared_ptr<Block> & block)
+        {
+            if (!block || !block->localProperties)
+            {
+                block.reset();
+                return;
+            }
+
+            auto newBlock = std::make_shared<Block>();
+            newBlock->copyProperties(*block, block->localProperties);
+            newBlock->localProperties = block->localProperties;
+            block = newBlock;
+        }
+
+        // Assign the resolved value to an empty property before animating it.
+        // The value is not marked as local, so resetSheetProperties restores inheritance.
+        // A shared block without local properties is remembered, releaseAnimatedValues shares it again.
+        template<typename T>
+        static T & prepareAnimatedValue(std::shared_ptr<Block> & block, std::optional<T> Block::* member, const T & resolved, const PropertyId id)
+        {
+            if (!block || (block.use_count() > 1 && !block->localProperties))
+            {
+                auto source = block;
+                block = source ? std::make_shared<Block>(*source) : std::make_shared<Block>();
+                block->animationRest = source ? std::make_unique<Block>(*source) : std::make_unique<Block>();
+                block->animationSource = source;
+            }
+
+            auto & property = detachBlock(block).*member;
+            if (!property.has_value())
+            {
+                property = resolved;
+            }
+
+            if (block->animationRest)
+            {
+                auto & rest = (*block->animationRest).*member;
+                if (!rest.has_value())
+                {
+                    rest = resolved;
+                }
+                block->animatedProperties |= getPropertyBit(id);
+            }
+            return property.value();
+        }
+
+        static void resizeControl(Control * control)
+        {
+            if (control)
+            {
+                control->resize();
+            }
+        }
+
+        static size_t getComponents(float & value, float * values[4])
+        {
+            values[0] = &value;
+            return 1;
+        }
+        static size_t getComponents(Vector2f & value, float * values[4])
+        {
+            values[0] = &value.x;
+            values[1] = &value.y;
+            return 2;
+        }
+        static size_t getComponents(Vector4f & value, float * values[4])
+        {
+            values[0] = &value.x;
+            values[1] = &value.y;
+            values[2] = &value.z;
+            values[3] = &value.w;
+            return 4;
+        }
+
+        // Get the components of an animatable property of block, 0 if the property is empty.
+        static size_t getBlockComponents(Block & block, const PropertyId id, float * values[4])
+        {
+            auto components = [values](auto & property) -> size_t
+            {
+                return property.has_value() ? getComponents(property.value(), values) : 0;
+            };
+
+            switch (id)
+            {
+            case PropertyId::BackgroundColor: return components(block.backgroundColor);
+            case PropertyId::BorderColor: return components(block.borderColor);
+            case PropertyId::BorderWidth: return components(block.borderWidth);
+            case PropertyId::FontBackgroundColor: return components(block.fontBackgroundColor);
+            case PropertyId::FontColor: return components(block.fontColor);
+            case PropertyId::Margin: return components(block.margin);
+            case PropertyId::Padding: return components(block.padding);
+            case PropertyId::Position: return components(block.position);
+            case PropertyId::Size: return components(block.size);
+            default: break;
             }
-            return g_emptyString;
-        }*/
+            return 0;
+        }
+
+        PropertyId internPropertyId(const std::string & name)
+        {
+            return getPropertyAtoms().intern(name);
+        }
+        bool findPropertyId(const std::string & name, PropertyId & id)
+        {
+            return getPropertyAtoms().find(name, id);
+        }
+        const std::string & getPropertyName(const PropertyId id)
+        {
+            return getPropertyAtoms().getName(id);
+        }
+
+        SelectorId internSelectorId(const std::string & name)
+        {
+            return getSelectorAtoms().intern(name);
+        }
+        bool findSelectorId(const std::string & name, SelectorId & id)
+        {
+            return getSelectorAtoms().find(name, id);
+        }
+        const std::string & getSelectorName(const SelectorId id)
+        {
+            return getSelectorAtoms().getName(id);
+        }
 
 
         // Linear Gradient implementations.
@@ -140,6 +425,32 @@ namespace Guise
             return m_colorB;
         }
 
+        Vector4f LinearGradient::getColor(const Bounds2f & bounds, const Vector2f & point) const
+        {
+            const float radians = m_angle * 0.01745329252f;
+            const Vector2f direction = { std::sin(radians), std::cos(radians) };
+            const float length = std::abs(bounds.size.x * direction.x) + std::abs(bounds.size.y * direction.y);
+            if (length <= 0.0f)
+            {
+                return m_colorA;
+            }
+
+            const Vector2f offset = point - (bounds.position + (bounds.size * 0.5f));
+            const float t = std::min(std::max(((offset.x * direction.x) + (offset.y * direction.y)) / length + 0.5f, 0.0f), 1.0f);
+            return m_colorA + ((m_colorB - m_colorA) * t);
+        }
+
+
+        bool LinearGradient::operator == (const LinearGradient & gradient) const
+        {
+            return m_angle == gradient.m_angle && m_colorA == gradient.m_colorA && m_colorB == gradient.m_colorB;
+        }
+
+        bool LinearGradient::operator != (const LinearGradient & gradient) const
+        {
+            return !(*this == gradient);
+        }
+
 
         // Size implementations.
         Size::Size() :
@@ -177,43 +488,12 @@ namespace Guise
         Property::Property(const Property & property) :
             m_dataType(property.m_dataType)
         {
-            switch (property.m_dataType)
-            {
-            case Property::DataType::Boolean:       m_valueBoolean = property.m_valueBoolean; break;
-            case Property::DataType::BorderStyle:   m_valueBorderStyle = property.m_valueBorderStyle; break;
-            case Property::DataType::Float:         m_valueFloat = property.m_valueFloat; break;
-            case Property::DataType::Integer:       m_valueInteger = property.m_valueInteger; break;
-            case Property::DataType::Overflow:      m_valueOverflow = property.m_valueOverflow; break;
-            case Property::DataType::String:        m_valueString = new std::string(*property.m_valueString); break;
-            case Property::DataType::Vector2f:      m_valueVector2f = property.m_valueVector2f; break;
-            case Property::DataType::Vector3f:      m_valueVector3f = property.m_valueVector3f; break;
-            case Property::DataType::Vector4f:      m_valueVector4f = property.m_valueVector4f; break;
-            default: break;
-            }
+            copyValue(property);
         }
 
         Property::Property(const std::shared_ptr<Property> & property) :
-            m_dataType(property->m_dataType)
-        {
-            if (!property)
-            {
-                return;
-            }
-
-            switch (property->m_dataType)
-            {
-            case Property::DataType::Boolean:       m_valueBoolean = property->m_valueBoolean; break;
-            case Property::DataType::BorderStyle:   m_valueBorderStyle = property->m_valueBorderStyle; break;
-            case Property::DataType::Float:         m_valueFloat = property->m_valueFloat; break;
-            case Property::DataType::Integer:       m_valueInteger = property->m_valueInteger; break;
-            case Property::DataType::Overflow:      m_valueOverflow = property->m_valueOverflow; break;
-            case Property::DataType::String:        m_valueString = new std::string(*property->m_valueString); break;
-            case Property::DataType::Vector2f:      m_valueVector2f = property->m_valueVector2f; break;
-            case Property::DataType::Vector3f:      m_valueVector3f = property->m_valueVector3f; break;
-            case Property::DataType::Vector4f:      m_valueVector4f = property->m_valueVector4f; break;
-            default: break;
-            }
-        }
+            Property(property ? *property : Property(false))
+        { }
 
         Property::Property(const bool value) :
             m_dataType(DataType::Boolean),
@@ -233,7 +513,7 @@ namespace Guise
         { }
         Property::Property(const LinearGradient & value) :
             m_dataType(DataType::LinearGradient),
-            m_valueLinearGradient(new LinearGradient(value))
+            m_valueLinearGradient(value)
         { }
         Property::Property(const Overflow value) :
             m_dataType(DataType::Overflow),
@@ -245,7 +525,7 @@ namespace Guise
         { }
         Property::Property(const std::string & value) :
             m_dataType(DataType::String),
-            m_valueString(new std::string(value))
+            m_valueString(internString(value))
         { }
         Property::Property(const Vector2f & value) :
             m_dataType(DataType::Vector2f),
@@ -268,11 +548,6 @@ namespace Guise
             m_valueVerticalAlign(value)
         { }
 
-        Property::~Property()
-        {
-            deallocate();
-        }
-
         Property::DataType Property::getDataType() const
         {
             return m_dataType;
@@ -297,13 +572,14 @@ namespace Guise
             return m_valueInteger;
         }
 
-        LinearGradient Property::getLinearGradient() const
+        const LinearGradient & Property::getLinearGradient() const
         {
+            static const LinearGradient emptyLinearGradient;
             if (m_dataType != DataType::LinearGradient)
             {
-                return LinearGradient();
+                return emptyLinearGradient;
             }
-            return *m_valueLinearGradient;
+            return m_valueLinearGradient;
         }
 
         Property::Overflow Property::getOverflow() const
@@ -316,11 +592,11 @@ namespace Guise
             return m_valueSize;
         }
 
-        std::string Property::getString() const
+        const std::string & Property::getString() const
         {
             if (m_dataType != DataType::String)
             {
-                return "";
+                return g_emptyString;
             }
             return *m_valueString;
         }
@@ -351,97 +627,90 @@ namespace Guise
 
         void Property::setBool(const bool value)
         {
-            deallocate();
             m_dataType = DataType::Boolean;
             m_valueBoolean = value;  
         }
 
         void Property::setBorderStyle(const BorderStyle value)
         {
-            deallocate();
             m_dataType = DataType::BorderStyle;
             m_valueBorderStyle = value;           
         }
 
         void Property::setFloat(const float value)
         {
-            deallocate();
             m_dataType = DataType::Float;
             m_valueFloat = value;           
         }
 
         void Property::setInteger(const int value)
         {
-            deallocate();
             m_dataType = DataType::Integer;
             m_valueInteger = value;
         }
 
         void Property::setLinearGradient(const LinearGradient & value)
         {
-            deallocate();
             m_dataType = DataType::LinearGradient;
-            m_valueLinearGradient = new LinearGradient(value);
+            m_valueLinearGradient = value;
         }
 
         void Property::setOverflow(const Overflow value)
         {
-            deallocate();
             m_dataType = DataType::Overflow;
             m_valueOverflow = value;   
         }
 
         void Property::setSize(const Size & value)
         {
-            deallocate();
             m_dataType = DataType::Size;
             m_valueSize = value;
         }
 
         void Property::setString(const std::string & value)
         {
-            deallocate();
             m_dataType = DataType::String;
-            m_valueString = new std::string(value);
+            m_valueString = internString(value);
         }
 
         void Property::setVector2f(const Vector2f & value)
         {
-            deallocate();
             m_dataType = DataType::Vector2f;
             m_valueVector2f = value;
         }
 
         void Property::setVector3f(const Vector3f & value)
         {
-            deallocate();
             m_dataType = DataType::Vector3f;
             m_valueVector3f = value;
         }
 
         void Property::setVector4f(const Vector4f & value)
         {
-            deallocate();
             m_dataType = DataType::Vector4f;
             m_valueVector4f = value;
         }
 
         void Property::setHorizontalAlign(const HorizontalAlign value)
         {
-            deallocate();
             m_dataType = DataType::HorizontalAlign;
             m_valueHorizontalAlign = value;
         }
         void Property::setVerticalAlign(const VerticalAlign value)
         {
-            deallocate();
             m_dataType = DataType::VerticalAlign;
             m_valueVerticalAlign = value;         
         }
 
+        Property & Property::operator = (const Property & property)
+        {
+            m_dataType = property.m_dataType;
+            copyValue(property);
+            return *this;
+        }
+
         Property & Property::operator = (const bool value)
         {
-            deallocate();
             m_dataType = DataType::Boolean;
             m_valueBoolean = value;
             return *this;
@@ -449,7 +718,6 @@ namespace Guise
 
         Property & Property::operator = (const BorderStyle value)
         {
-            deallocate();
             m_dataType = DataType::BorderStyle;
             m_valueBorderStyle = value;
             return *this;
@@ -457,7 +725,6 @@ namespace Guise
 
         Property & Property::operator = (const float value)
         {
-            deallocate();
             m_dataType = DataType::Float;
             m_valueFloat = value;
             return *this;
@@ -465,7 +732,6 @@ namespace Guise
 
         Property & Property::operator = (const int value)
         {
-            deallocate();
             m_dataType = DataType::Integer;
             m_valueInteger = value;
             return *this;
@@ -473,15 +739,13 @@ namespace Guise
 
         Property & Property::operator = (const LinearGradient & value)
         {
-            deallocate();
             m_dataType = DataType::LinearGradient;
-            m_valueLinearGradient = new LinearGradient(value);
+            m_valueLinearGradient = value;
             return *this;
         }
 
         Property & Property::operator = (const Overflow value)
         {
-            deallocate();
             m_dataType = DataType::Overflow;
             m_valueOverflow = value;
             return *this;
@@ -489,15 +753,13 @@ namespace Guise
 
         Property & Property::operator = (const std::string & value)
         {
-            deallocate();
             m_dataType = DataType::String;
-            m_valueString = new std::string(value);
+            m_valueString = internString(value);
             return *this;
         }
 
         Property & Property::operator = (const Vector2f & value)
         {
-            deallocate();
             m_dataType = DataType::Vector2f;
             m_valueVector2f = value;
             return *this;
@@ -505,7 +767,6 @@ namespace Guise
 
         Property & Property::operator = (const Vector3f & value)
         {
-            deallocate();
             m_dataType = DataType::Vector3f;
             m_valueVector3f = value;
             return *this;
@@ -513,7 +774,6 @@ namespace Guise
 
         Property & Property::operator = (const Vector4f & value)
         {
-            deallocate();
             m_dataType = DataType::Vector4f;
             m_valueVector4f = value;
             return *this;
@@ -521,572 +781,1030 @@ namespace Guise
 
         Property & Property::operator = (const HorizontalAlign value)
         {
-            deallocate();
             m_dataType = DataType::HorizontalAlign;
             m_valueHorizontalAlign = value;
             return *this;
         }
         Property & Property::operator = (const VerticalAlign value)
         {
-            deallocate();
             m_dataType = DataType::VerticalAlign;
             m_valueVerticalAlign = value;
             return *this;
         }
 
-        void Property::deallocate()
+        bool Property::operator == (const Property & property) const
         {
+            if (m_dataType != property.m_dataType)
+            {
+                return false;
+            }
+
             switch (m_dataType)
             {
-                case DataType::String: delete m_valueString; break;
-                case DataType::LinearGradient: delete m_valueLinearGradient; break;
-                default: break;
+            case DataType::Boolean:         return m_valueBoolean == property.m_valueBoolean;
+            case DataType::BorderStyle:     return m_valueBorderStyle == property.m_valueBorderStyle;
+            case DataType::Float:           return m_valueFloat == property.m_valueFloat;
+            case DataType::Integer:         return m_valueInteger == property.m_valueInteger;
+            case DataType::LinearGradient:  return m_valueLinearGradient == property.m_valueLinearGradient;
+            case DataType::Overflow:        return m_valueOverflow == property.m_valueOverflow;
+            case DataType::Size:            return m_valueSize == property.m_valueSize && m_valueSize.fit == property.m_valueSize.fit;
+            case DataType::String:          return m_valueString == property.m_valueString;
+            case DataType::Vector2f:        return m_valueVector2f == property.m_valueVector2f;
+            case DataType::Vector3f:        return m_valueVector3f == property.m_valueVector3f;
+            case DataType::Vector4f:        return m_valueVector4f == property.m_valueVector4f;
+            case DataType::HorizontalAlign: return m_valueHorizontalAlign == property.m_valueHorizontalAlign;
+            case DataType::VerticalAlign:   return m_valueVerticalAlign == property.m_valueVerticalAlign;
+            default: break;
             }
+            return false;
         }
 
+        bool Property::operator != (const Property & property) const
+        {
+            return !(*this == property);
+        }
 
-        // Selector implementations.
-        Selector::PropertyNameValue::PropertyNameValue(const std::string & name, const Property & property) :
-            name(name),
-            property(property)
-        { }
-
-        Selector::Selector()
-        { }
 
-        Selector::Selector(const Selector & selector)
+        void Property::copyValue(const Property & property)
         {
-            for (auto it = selector.m_properties.begin(); it != selector.m_properties.end(); it++)
+            switch (property.m_dataType)
             {
-                m_properties.insert({ it->first, std::make_shared<Property>(it->second) });
+            case DataType::Boolean:         m_valueBoolean = property.m_valueBoolean; break;
+            case DataType::BorderStyle:     m_valueBorderStyle = property.m_valueBorderStyle; break;
+            case DataType::Float:           m_valueFloat = property.m_valueFloat; break;
+            case DataType::Integer:         m_valueInteger = property.m_valueInteger; break;
+            case DataType::LinearGradient:  m_valueLinearGradient = property.m_valueLinearGradient; break;
+            case DataType::Overflow:        m_valueOverflow = property.m_valueOverflow; break;
+            case DataType::Size:            m_valueSize = property.m_valueSize; break;
+            case DataType::String:          m_valueString = property.m_valueString; break;
+            case DataType::Vector2f:        m_valueVector2f = property.m_valueVector2f; break;
+            case DataType::Vector3f:        m_valueVector3f = property.m_valueVector3f; break;
+            case DataType::Vector4f:        m_valueVector4f = property.m_valueVector4f; break;
+            case DataType::HorizontalAlign: m_valueHorizontalAlign = property.m_valueHorizontalAlign; break;
+            case DataType::VerticalAlign:   m_valueVerticalAlign = property.m_valueVerticalAlign; break;
+            default: break;
             }
         }
 
-        Selector::Selector(const std::shared_ptr<Selector> & selector)
+
+        // Block implementations.
+        static std::optional<Vector4f> getColorProperty(const Property * property)
         {
-            for (auto it = selector->m_properties.begin(); it != selector->m_properties.end(); it++)
+            if (!property)
             {
-                m_properties.insert({ it->first, std::make_shared<Property>(*it->second) });
+                return {};
             }
-        }
 
-        Selector::Selector(const std::initializer_list<PropertyNameValue> & properties)
-        {
-            for (auto it = properties.begin(); it != properties.end(); it++)
+            switch (property->getDataType())
             {
-                auto itProp = m_properties.find(it->name);
-                if (itProp == m_properties.end())
-                {
-                    m_properties.insert({ it->name, std::make_shared<Property>(it->property) });
-                }
-                else
-                {
-                    *(itProp->second) = it->property;
-                }
+            case Property::DataType::Integer:
+            {
+                const float value = static_cast<float>(property->getInteger());
+                return Vector4f{ value, value, value, 1.0f };
+            }
+            case Property::DataType::Float:
+            {
+                const float value = property->getFloat();
+                return Vector4f{ value, value, value, 1.0f };
+            }
+            case Property::DataType::Vector3f: return Vector4f{ property->getVector3f(), 1.0f };
+            case Property::DataType::Vector4f: return property->getVector4f();
+            default: break;
             }
+            return {};
         }
 
-        std::shared_ptr<Property> Selector::getProperty(const std::string & name) const
+        static std::optional<Vector4f> getEdgesProperty(const Property * property)
         {
-            auto it = m_properties.find(name);
-            if (it != m_properties.end())
+            if (!property)
             {
-                return it->second;
+                return {};
             }
-            return nullptr;
-        }
 
-        Properties & Selector::getProperties()
-        {
-            return m_properties;
-        }
-        const Properties & Selector::getProperties() const
-        {
-            return m_properties;
+            switch (property->getDataType())
+            {
+            case Property::DataType::Float:
+            {
+                const float value = property->getFloat();
+                return Vector4f{ value, value, value, value };
+            }
+            case Property::DataType::Vector2f: return Vector4f{ property->getVector2f(), property->getVector2f() };
+            case Property::DataType::Vector4f: return property->getVector4f();
+            default: break;
+            }
+            return {};
         }
 
-        // Sheet implementations.
-        Sheet::SelectorNameValue::SelectorNameValue(const std::string & name, const Selector & selector) :
-            name(name),
-            selector(selector)
-        { }
-
-        std::shared_ptr<Sheet> Sheet::create(const std::initializer_list<SelectorNameValue> & selectors)
+        Block::Block() :
+            localProperties(0),
+            animatedProperties(0)
         {
-            return std::shared_ptr<Sheet>(new Sheet(selectors));
+            g_blockCount++;
         }
 
-        std::shared_ptr<Sheet> Sheet::createDefault()
+        Block::Block(const Block & block) :
+            backgroundColor(block.backgroundColor),
+            backgroundGradient(block.backgroundGradient),
+            borderColor(block.borderColor),
+            borderStyle(block.borderStyle),
+            borderWidth(block.borderWidth),
+            fontBackgroundColor(block.fontBackgroundColor),
+            fontColor(block.fontColor),
+            fontFamily(block.fontFamily),
+            fontSize(block.fontSize),
+            horizontalAlign(block.horizontalAlign),
+            margin(block.margin),
+            overflow(block.overflow),
+            padding(block.padding),
+            position(block.position),
+            size(block.size),
+            transitionDuration(block.transitionDuration),
+            verticalAlign(block.verticalAlign),
+            localProperties(block.localProperties),
+            animatedProperties(0)
         {
-            return std::shared_ptr<Sheet>(new Sheet(
-                {
-                    { "button", DefaultStyles::button },
-                    { "button:active", DefaultStyles::buttonActive },
-                    { "button:disabled", DefaultStyles::buttonDisabled },
-                    { "button:hover", DefaultStyles::buttonHover },
-                    { "canvas", DefaultStyles::canvas },
-                    { "checkbox", DefaultStyles::checkbox },
-                    { "checkbox:checked", DefaultStyles::checkboxChecked },
-                    { "checkbox:checkedHover", DefaultStyles::checkboxCheckedHover },
-                    { "checkbox:checkedDisabled", DefaultStyles::checkboxCheckedDisabled },
-                    { "checkbox:hover", DefaultStyles::checkboxHover },
-                    { "checkbox:disabled", DefaultStyles::checkboxDisabled },
-                    { "horizontal-grid", DefaultStyles::horizontalGrid },
-                    { "horizontal-grid-slot", DefaultStyles::horizontalGridSlot },
-                    { "label", DefaultStyles::label },
-                    { "plane",  DefaultStyles::plane },
-                    { "tab-window", DefaultStyles::tabWindow },
-                    { "tab-window-tab", DefaultStyles::tabWindowTab },
-                    { "text-box", DefaultStyles::textBox },
-                    { "text-box-text", DefaultStyles::textBoxText },
-                    { "vertical-grid", DefaultStyles::verticalGrid },
-                    { "vertical-grid-slot", DefaultStyles::verticalGridSlot },
-                    { "window", DefaultStyles::window }
-                }
-            ));
+            g_blockCount++;
         }
 
-
-        std::shared_ptr<Selector> Sheet::getSelector(const std::string & name) const
+        Block::~Block()
         {
-            auto it = m_selectors.find(name);
-            if (it != m_selectors.end())
-            {
-                return it->second;
-            }
-            return nullptr;
+            g_blockCount--;
         }
 
-        Sheet::Sheet(const std::initializer_list<SelectorNameValue> & selectors)
+        Block::Block(const Selector & selector) :
+            Block()
         {
-            for (auto it = selectors.begin(); it != selectors.end(); it++)
+            // Unlike font colors, background colors are not set from integers.
+            if (auto property = selector.getProperty(PropertyId::BackgroundColor))
             {
-                auto itSel = m_selectors.find(it->name);
-                if (itSel == m_selectors.end())
+                switch (property->getDataType())
                 {
-                    m_selectors.insert({ it->name, std::make_shared<Selector>(it->selector) });
-                }
-                else
+                case Property::DataType::Float:
                 {
-                    *(itSel->second) = it->selector;
+                    const float value = property->getFloat();
+                    backgroundColor = Vector4f{ value, value, value, 1.0f };
+                }
+                break;
+                case Property::DataType::Vector3f: backgroundColor = Vector4f{ property->getVector3f(), 1.0f }; break;
+                case Property::DataType::Vector4f: backgroundColor = property->getVector4f(); break;
+                default: break;
                 }
             }
-        }
-
 
-        // Parent style implementations.
-        ParentStyle::ParentStyle(Control * control, ParentStyle * parent) :
-            m_parent(parent)
-        {
-            if (control)
+            auto property = selector.getProperty(PropertyId::BackgroundGradient);
+            if (property && property->getDataType() == Property::DataType::LinearGradient)
             {
-                onResizeChange.connectAnonymously([control]()
-                {
-                    control->resize();
-                });
+                backgroundGradient = property->getLinearGradient();
             }
-        }
-
-        Vector4f ParentStyle::getPadding() const
-        {
-            return m_padding.has_value() ? m_padding.value() : (m_parent ? m_parent->getPadding() : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
-        }
-        Vector2f ParentStyle::getPaddingLow() const
-        {
-            return m_padding.has_value() ? Vector2f{ m_padding.value().x, m_padding.value().y } : (m_parent ? m_parent->getPaddingLow() : Vector2f{ 0.0f, 0.0f });
-        }
-        Vector2f ParentStyle::getPaddingHigh() const
-        {
-            return m_padding.has_value() ? Vector2f{ m_padding.value().z, m_padding.value().w } : (m_parent ? m_parent->getPaddingHigh() : Vector2f{ 0.0f, 0.0f });
-        }
 
-        void ParentStyle::setPadding(const Vector4f & padding)
-        {
-            if (!m_padding.has_value())
+            property = selector.getProperty(PropertyId::BorderColor);
+            if (property && property->getDataType() == Property::DataType::Vector4f)
             {
-                m_padding = { 0.0f, 0.0f, 0.0f, 0.0f };
+                borderColor = property->getVector4f();
             }
 
-            if (m_padding.value() != padding)
+            property = selector.getProperty(PropertyId::BorderStyle);
+            if (property && property->getDataType() == Property::DataType::BorderStyle)
             {
-                m_padding = padding;
-                onResizeChange();
+                borderStyle = property->getBorderStyle();
             }
-        }
-        void ParentStyle::setPadding(const Vector2f & padding)
-        {
-            if (!m_padding.has_value())
+
+            property = selector.getProperty(PropertyId::BorderWidth);
+            if (property && property->getDataType() == Property::DataType::Float)
             {
-                m_padding = { 0.0f, 0.0f, 0.0f, 0.0f };
+                borderWidth = property->getFloat();
             }
 
-            if (m_padding.value() != Vector4f{ padding.x, padding.y, padding.x, padding.y })
+            fontBackgroundColor = getColorProperty(selector.getProperty(PropertyId::FontBackgroundColor));
+            fontColor = getColorProperty(selector.getProperty(PropertyId::FontColor));
+
+            property = selector.getProperty(PropertyId::FontFamily);
+            if (property && property->getDataType() == Property::DataType::String)
             {
-                m_padding = { padding.x, padding.y, padding.x, padding.y };
-                onResizeChange();
+                fontFamily = &property->getString();
             }
-        }
-        void ParentStyle::setPadding(const float & padding)
-        {
-            if (!m_padding.has_value())
+
+            property = selector.getProperty(PropertyId::FontSize);
+            if (property && property->getDataType() == Property::DataType::Integer)
             {
-                m_padding = { 0.0f, 0.0f, 0.0f, 0.0f };
+                fontSize = property->getInteger();
             }
 
-            if (m_padding.value() != Vector4f{ padding, padding, padding, padding })
+            property = selector.getProperty(PropertyId::HorizontalAlign);
+            if (property && property->getDataType() == Property::DataType::HorizontalAlign)
             {
-                m_padding = { padding, padding, padding, padding };
-                onResizeChange();
+                horizontalAlign = property->getHorizontalAlign();
             }
-        }
-        void ParentStyle::setPaddingLow(const Vector2f & paddingLow)
-        {
-            if (!m_padding.has_value())
+
+            margin = getEdgesProperty(selector.getProperty(PropertyId::Margin));
+
+            property = selector.getProperty(PropertyId::Overflow);
+            if (property && property->getDataType() == Property::DataType::Overflow)
             {
-                m_padding = { 0.0f, 0.0f, 0.0f, 0.0f };
+                overflow = property->getOverflow();
             }
 
-            if (paddingLow.x != m_padding.value().x || paddingLow.y != m_padding.value().y)
+            padding = getEdgesProperty(selector.getProperty(PropertyId::Padding));
+
+            property = selector.getProperty(PropertyId::Position);
+            if (property && property->getDataType() == Property::DataType::Vector2f)
+            {
+                position = property->getVector2f();
+            }
+
+            property = selector.getProperty(PropertyId::Size);
+            if (property && property->getDataType() == Property::DataType::Size)
             {
-                m_padding.value().x = paddingLow.x;
-                m_padding.value().y = paddingLow.y;
-                onResizeChange();
+                size = property->getSize();
+            }
+            else if (property && property->getDataType() == Property::DataType::Vector2f)
+            {
+                size = Size{ property->getVector2f() };
+            }
+
+            property = selector.getProperty(PropertyId::TransitionDuration);
+            if (property && property->getDataType() == Property::DataType::Float)
+            {
+                transitionDuration = property->getFloat();
+            }
+
+            property = selector.getProperty(PropertyId::VerticalAlign);
+            if (property && property->getDataType() == Property::DataType::VerticalAlign)
+            {
+                verticalAlign = property->getVerticalAlign();
             }
         }
-        void ParentStyle::setPaddingHigh(const Vector2f & paddingHigh)
+
+        template<typename T>
+        static void copyProperty(std::optional<T> & to, const std::optional<T> & from, const PropertyId id, const uint32_t properties)
         {
-            if (!m_padding.has_value())
+            if (properties & getPropertyBit(id))
             {
-                m_padding = { 0.0f, 0.0f, 0.0f, 0.0f };
+                to = from;
             }
+        }
 
-            if (paddingHigh.x != m_padding.value().z || paddingHigh.y != m_padding.value().w)
+        void Block::copyProperties(const Block & block, const uint32_t properties)
+        {
+            copyProperty(backgroundColor, block.backgroundColor, PropertyId::BackgroundColor, properties);
+            copyProperty(backgroundGradient, block.backgroundGradient, PropertyId::BackgroundGradient, properties);
+            copyProperty(borderColor, block.borderColor, PropertyId::BorderColor, properties);
+            copyProperty(borderStyle, block.borderStyle, PropertyId::BorderStyle, properties);
+            copyProperty(borderWidth, block.borderWidth, PropertyId::BorderWidth, properties);
+            copyProperty(fontBackgroundColor, block.fontBackgroundColor, PropertyId::FontBackgroundColor, properties);
+            copyProperty(fontColor, block.fontColor, PropertyId::FontColor, properties);
+            copyProperty(fontFamily, block.fontFamily, PropertyId::FontFamily, properties);
+            copyProperty(fontSize, block.fontSize, PropertyId::FontSize, properties);
+            copyProperty(horizontalAlign, block.horizontalAlign, PropertyId::HorizontalAlign, properties);
+            copyProperty(margin, block.margin, PropertyId::Margin, properties);
+            copyProperty(overflow, block.overflow, PropertyId::Overflow, properties);
+            copyProperty(padding, block.padding, PropertyId::Padding, properties);
+            copyProperty(position, block.position, PropertyId::Position, properties);
+            copyProperty(size, block.size, PropertyId::Size, properties);
+            copyProperty(transitionDuration, block.transitionDuration, PropertyId::TransitionDuration, properties);
+            copyProperty(verticalAlign, block.verticalAlign, PropertyId::VerticalAlign, properties);
+        }
+
+        template<typename T>
+        static bool equalProperty(const std::optional<T> & left, const std::optional<T> & right, const PropertyId id, const uint32_t properties)
+        {
+            return !(properties & getPropertyBit(id)) || left == right;
+        }
+
+        bool Block::hasEqualProperties(const Block & block, const uint32_t properties) const
+        {
+            return equalProperty(backgroundColor, block.backgroundColor, PropertyId::BackgroundColor, properties) &&
+                equalProperty(backgroundGradient, block.backgroundGradient, PropertyId::BackgroundGradient, properties) &&
+                equalProperty(borderColor, block.borderColor, PropertyId::BorderColor, properties) &&
+                equalProperty(borderStyle, block.borderStyle, PropertyId::BorderStyle, properties) &&
+                equalProperty(borderWidth, block.borderWidth, PropertyId::BorderWidth, properties) &&
+                equalProperty(fontBackgroundColor, block.fontBackgroundColor, PropertyId::FontBackgroundColor, properties) &&
+                equalProperty(fontColor, block.fontColor, PropertyId::FontColor, properties) &&
+                equalProperty(fontFamily, block.fontFamily, PropertyId::FontFamily, properties) &&
+                equalProperty(fontSize, block.fontSize, PropertyId::FontSize, properties) &&
+                equalProperty(horizontalAlign, block.horizontalAlign, PropertyId::HorizontalAlign, properties) &&
+                equalProperty(margin, block.margin, PropertyId::Margin, properties) &&
+                equalProperty(overflow, block.overflow, PropertyId::Overflow, properties) &&
+                equalProperty(padding, block.padding, PropertyId::Padding, properties) &&
+                equalProperty(position, block.position, PropertyId::Position, properties) &&
+                equalProperty(size, block.size, PropertyId::Size, properties) &&
+                equalProperty(transitionDuration, block.transitionDuration, PropertyId::TransitionDuration, properties) &&
+                equalProperty(verticalAlign, block.verticalAlign, PropertyId::VerticalAlign, properties);
+        }
+
+        BlockStatistics getBlockStatistics()
+        {
+            const size_t count = g_blockCount.load();
+            return { count, count * sizeof(Block) };
+        }
+
+
+        // Selector implementations.
+        Selector::PropertyNameValue::PropertyNameValue(const std::string & name, const Property & property) :
+            id(internPropertyId(name)),
+            property(property)
+        { }
+
+        Selector::PropertyNameValue::PropertyNameValue(const PropertyId id, const Property & property) :
+            id(id),
+            property(property)
+        { }
+
+        Selector::Selector()
+        { }
+
+        Selector::Selector(const std::shared_ptr<Selector> & selector) :
+            Selector(selector ? *selector : Selector())
+        { }
+
+        Selector::Selector(const Selector & selector) :
+            m_properties(selector.m_properties),
+            m_block(std::atomic_load(&selector.m_block))
+        { }
+
+        Selector::Selector(const std::initializer_list<PropertyNameValue> & properties)
+        {
+            if (!properties.size())
+            {
+                return;
+            }
+
+            m_properties = std::make_shared<Properties>();
+            m_properties->reserve(properties.size());
+            for (auto it = properties.begin(); it != properties.end(); it++)
             {
-                m_padding.value().z = paddingHigh.x;
-                m_padding.value().w = paddingHigh.y;
-                onResizeChange();
+                setProperty(it->id, it->property);
             }
         }
 
-        void ParentStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        Selector & Selector::operator = (const Selector & selector)
         {
-            if (!selector)
+            m_properties = selector.m_properties;
+            std::atomic_store(&m_block, std::atomic_load(&selector.m_block));
+            return *this;
+        }
+
+        const Property * Selector::getProperty(const std::string & name) const
+        {
+            // Unknown names cannot have a property, looking them up must not intern them.
+            PropertyId id;
+            if (!findPropertyId(name, id))
             {
-                return;
+                return nullptr;
+            }
+            return getProperty(id);
+        }
+
+        const Property * Selector::getProperty(const PropertyId id) const
+        {
+            if (!m_properties)
+            {
+                return nullptr;
             }
 
-            if(!m_padding.has_value())
+            auto it = std::lower_bound(m_properties->begin(), m_properties->end(), id,
+                [](const Properties::value_type & property, const PropertyId value)
             {
-                auto padding = selector->getProperty("padding");
-                if (padding)
-                {
-                    switch (padding->getDataType())
-                    {
-                        case Property::DataType::Float:
-                        {
-                            auto val = padding->getFloat();
-                            m_padding = { val, val, val, val };
-                        }
-                        break;
-                        case Property::DataType::Vector2f:
-                        {
-                            m_padding = { padding->getVector2f(), padding->getVector2f() };
-                        }
-                        break;
-                        case Property::DataType::Vector4f:
-                        {
-                            m_padding = padding->getVector4f();
-                        }
-                        break;
-                        default: break;
-                    }
-                }
+                return property.first < value;
+            });
+            if (it != m_properties->end() && it->first == id)
+            {
+                return &it->second;
             }
+            return nullptr;
         }
 
+        void Selector::setProperty(const std::string & name, const Property & property)
+        {
+            setProperty(internPropertyId(name), property);
+        }
 
-        // Align style implementations.
-        AlignStyle::AlignStyle(AlignStyle * parent) :
-            m_parent(parent)
-        {}
+        void Selector::setProperty(const PropertyId id, const Property & property)
+        {
+            auto & properties = detach();
+            auto it = std::lower_bound(properties.begin(), properties.end(), id,
+                [](const Properties::value_type & property, const PropertyId value)
+            {
+                return property.first < value;
+            });
+            if (it != properties.end() && it->first == id)
+            {
+                it->second = property;
+                return;
+            }
+            properties.insert(it, { id, property });
+        }
 
-        Property::HorizontalAlign AlignStyle::getHorizontalAlign() const
+        Properties & Selector::getProperties()
         {
-            return m_horizontalAlign.has_value() ? m_horizontalAlign.value() : (m_parent ? m_parent->getHorizontalAlign() : Property::HorizontalAlign::Left);
+            return detach();
         }
-        Property::VerticalAlign AlignStyle::getVerticalAlign() const
+        const Properties & Selector::getProperties() const
         {
-            return m_verticalAlign.has_value() ? m_verticalAlign.value() : (m_parent ? m_parent->getVerticalAlign() : Property::VerticalAlign::Top);
+            static const Properties emptyProperties;
+            return m_properties ? *m_properties : emptyProperties;
         }
 
-        void AlignStyle::setHorizontalAlign(const Property::HorizontalAlign horizontalAlign)
+        std::shared_ptr<Block> Selector::getBlock() const
         {
-            m_horizontalAlign = horizontalAlign;
+            auto block = std::atomic_load(&m_block);
+            if (!block)
+            {
+                // Racing threads convert the same properties, either block is valid.
+                block = std::make_shared<Block>(*this);
+                std::atomic_store(&m_block, block);
+            }
+            return block;
         }
-        void AlignStyle::setVerticalAlign(const Property::VerticalAlign verticalAlign)
+
+        bool Selector::operator == (const Selector & selector) const
         {
-            m_verticalAlign = verticalAlign;
+            if (m_properties == selector.m_properties)
+            {
+                return true;
+            }
+            const Properties & properties = getProperties();
+            return properties == selector.getProperties();
         }
 
-        void AlignStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        bool Selector::operator != (const Selector & selector) const
         {
-            if (!selector)
+            return !(*this == selector);
+        }
+
+        Properties & Selector::detach()
+        {
+            std::atomic_store(&m_block, std::shared_ptr<Block>());
+            if (!m_properties)
             {
-                return;
+                m_properties = std::make_shared<Properties>();
+            }
+            else if (m_properties.use_count() > 1)
+            {
+                m_properties = std::make_shared<Properties>(*m_properties);
+            }
+            return *m_properties;
+        }
+
+        // Selector set implementations.
+        void SelectorSet::insert(const SelectorId id)
+        {
+            const size_t index = static_cast<size_t>(id);
+            if (index >= m_ids.size())
+            {
+                m_ids.resize(index + 1, false);
             }
+            m_ids[index] = true;
+        }
+
+        bool SelectorSet::contains(const SelectorId id) const
+        {
+            const size_t index = static_cast<size_t>(id);
+            return index < m_ids.size() && m_ids[index];
+        }
 
-            if (!m_verticalAlign.has_value())
+        bool SelectorSet::containsAny(const std::initializer_list<SelectorId> & ids) const
+        {
+            for (auto id : ids)
             {
-                auto vertAlign = selector->getProperty("vertical-align");
-                if (!vertAlign)
+                if (contains(id))
                 {
-                    vertAlign = selector->getProperty("vert-align");
+                    return true;
                 }
-                if (vertAlign)
+            }
+            return false;
+        }
+
+        bool SelectorSet::isEmpty() const
+        {
+            return std::find(m_ids.begin(), m_ids.end(), true) == m_ids.end();
+        }
+
+        // Sheet implementations.
+        Sheet::SelectorNameValue::SelectorNameValue(const std::string & name, const Selector & selector) :
+            id(internSelectorId(name)),
+            selector(selector)
+        { }
+
+        Sheet::SelectorNameValue::SelectorNameValue(const SelectorId id, const Selector & selector) :
+            id(id),
+            selector(selector)
+        { }
+
+        std::shared_ptr<Sheet> Sheet::create(const std::initializer_list<SelectorNameValue> & selectors)
+        {
+            return std::shared_ptr<Sheet>(new Sheet(selectors));
+        }
+
+        std::shared_ptr<Sheet> Sheet::createDefault()
+        {
+            return std::shared_ptr<Sheet>(new Sheet(
                 {
-                    switch (vertAlign->getDataType())
-                    {
-                        case Property::DataType::VerticalAlign:
-                        {
-                            m_verticalAlign = vertAlign->getVerticalAlign();
-                        }
-                        break;
-                        default: break;
-                    }
+                    { SelectorId::Button, DefaultStyles::button },
+                    { SelectorId::ButtonActive, DefaultStyles::buttonActive },
+                    { SelectorId::ButtonDisabled, DefaultStyles::buttonDisabled },
+                    { SelectorId::ButtonHover, DefaultStyles::buttonHover },
+                    { SelectorId::Canvas, DefaultStyles::canvas },
+                    { SelectorId::Checkbox, DefaultStyles::checkbox },
+                    { SelectorId::CheckboxChecked, DefaultStyles::checkboxChecked },
+                    { SelectorId::CheckboxCheckedHover, DefaultStyles::checkboxCheckedHover },
+                    { SelectorId::CheckboxCheckedDisabled, DefaultStyles::checkboxCheckedDisabled },
+                    { SelectorId::CheckboxHover, DefaultStyles::checkboxHover },
+                    { SelectorId::CheckboxDisabled, DefaultStyles::checkboxDisabled },
+                    { SelectorId::HorizontalGrid, DefaultStyles::horizontalGrid },
+                    { SelectorId::HorizontalGridSlot, DefaultStyles::horizontalGridSlot },
+                    { SelectorId::Label, DefaultStyles::label },
+                    { SelectorId::Plane,  DefaultStyles::plane },
+                    { SelectorId::TabWindow, DefaultStyles::tabWindow },
+                    { SelectorId::TabWindowTab, DefaultStyles::tabWindowTab },
+                    { SelectorId::TextBox, DefaultStyles::textBox },
+                    { SelectorId::TextBoxText, DefaultStyles::textBoxText },
+                    { SelectorId::VerticalGrid, DefaultStyles::verticalGrid },
+                    { SelectorId::VerticalGridSlot, DefaultStyles::verticalGridSlot },
+                    { SelectorId::Window, DefaultStyles::window }
                 }
+            ));
+        }
+
+        const std::shared_ptr<Sheet> & Sheet::getDefault()
+        {
+            static const std::shared_ptr<Sheet> sheet = createDefault();
+            return sheet;
+        }
+
+        const Selector * Sheet::getSelector(const std::string & name) const
+        {
+            // Unknown names cannot have a selector, looking them up must not intern them.
+            SelectorId id;
+            if (!findSelectorId(name, id))
+            {
+                return nullptr;
+            }
+            return getSelector(id);
+        }
+
+        const Selector * Sheet::getSelector(const SelectorId id) const
+        {
+            const size_t index = static_cast<size_t>(id);
+            if (index >= m_selectors.size() || !m_selectors[index].has_value())
+            {
+                return nullptr;
             }
+            return &m_selectors[index].value();
+        }
 
-            if (!m_horizontalAlign.has_value())
+        SelectorSet Sheet::diff(const Sheet & oldSheet, const Sheet & newSheet)
+        {
+            SelectorSet changed;
+
+            const size_t count = std::max(oldSheet.m_selectors.size(), newSheet.m_selectors.size());
+            for (size_t i = 0; i < count; i++)
             {
-                auto horiAlign = selector->getProperty("horizontal-align");
-                if (!horiAlign)
+                const SelectorId id = static_cast<SelectorId>(i);
+                const Selector * oldSelector = oldSheet.getSelector(id);
+                const Selector * newSelector = newSheet.getSelector(id);
+
+                if (!oldSelector && !newSelector)
                 {
-                    horiAlign = selector->getProperty("hori-align");
+                    continue;
                 }
-                if (horiAlign)
+                if (!oldSelector || !newSelector || *oldSelector != *newSelector)
                 {
-                    switch (horiAlign->getDataType())
-                    {
-                    case Property::DataType::HorizontalAlign:
-                    {
-                        m_horizontalAlign = horiAlign->getHorizontalAlign();
-                    }
-                    break;
-                    default: break;
-                    }
+                    changed.insert(id);
                 }
             }
+
+            return changed;
         }
 
+        Sheet::Sheet(const std::initializer_list<SelectorNameValue> & selectors) :
+            m_selectors(static_cast<size_t>(SelectorId::Count))
+        {
+            for (auto it = selectors.begin(); it != selectors.end(); it++)
+            {
+                // Selectors share their properties with the source selector until modified.
+                getOrAddSelector(it->id) = it->selector;
+            }
+        }
 
-        // Rect style implementations.
-        RectStyle::RectStyle(Control * control, RectStyle * parent) :
-            AlignStyle(parent),
-            m_parent(parent)
+        Selector & Sheet::getOrAddSelector(const SelectorId id)
         {
-            if (control)
+            const size_t index = static_cast<size_t>(id);
+            if (index >= m_selectors.size())
             {
-                onResizeChange.connectAnonymously([control]()
-                {
-                    control->resize();
-                });
+                m_selectors.resize(index + 1);
+            }
+
+            auto & selector = m_selectors[index];
+            if (!selector.has_value())
+            {
+                selector = Selector();
             }
+            return selector.value();
         }
-        
-        Property::Overflow RectStyle::getOverflow() const
+
+
+        // Block style implementations.
+        static void removeChildStyle(std::vector<BlockStyle *> & childs, BlockStyle * child)
         {
-            return m_overflow.has_value() ? m_overflow.value() : (m_parent ? m_parent->getOverflow() : Property::Overflow::Hidden);
+            auto it = std::find(childs.begin(), childs.end(), child);
+            if (it != childs.end())
+            {
+                *it = childs.back();
+                childs.pop_back();
+            }
         }
-        Vector4f RectStyle::getMargin() const
+
+        BlockStyle::Resolved::Resolved() :
+            backgroundColor(0.0f, 0.0f, 0.0f, 0.0f),
+            borderColor(0.0f, 0.0f, 0.0f, 0.0f),
+            borderStyle(Property::BorderStyle::None),
+            borderWidth(0.0f),
+            fontBackgroundColor(0.0f, 0.0f, 0.0f, 0.0f),
+            fontColor(0.0f, 0.0f, 0.0f, 0.0f),
+            fontFamily(&g_emptyString),
+            fontSize(0),
+            horizontalAlign(Property::HorizontalAlign::Left),
+            margin(0.0f, 0.0f, 0.0f, 0.0f),
+            overflow(Property::Overflow::Hidden),
+            padding(0.0f, 0.0f, 0.0f, 0.0f),
+            position(0.0f, 0.0f),
+            size(0.0f, 0.0f),
+            transitionDuration(0.0f),
+            verticalAlign(Property::VerticalAlign::Top)
+        { }
+
+        BlockStyle::BlockStyle() :
+            m_parentStyle(nullptr),
+            m_resolvedGeneration(0)
+        { }
+
+        BlockStyle::BlockStyle(const BlockStyle & style) :
+            m_block(style.m_block),
+            m_resolved(style.m_resolved),
+            m_parentStyle(nullptr),
+            m_resolvedGeneration(0)
         {
-            return m_margin.has_value() ? m_margin.value() : (m_parent ? m_parent->getMargin() : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
+            setParentStyle(style.m_parentStyle);
         }
-        Vector2f RectStyle::getMarginLow() const
+
+        BlockStyle::~BlockStyle()
         {
-            return m_margin.has_value() ? Vector2f{ m_margin.value().x, m_margin.value().y } : (m_parent ? m_parent->getMarginLow() : Vector2f{ 0.0f, 0.0f });
+            if (m_parentStyle)
+            {
+                removeChildStyle(m_parentStyle->m_childStyles, this);
+            }
+
+            // Childs fall back to the default values.
+            auto childs = std::move(m_childStyles);
+            for (auto child : childs)
+            {
+                child->m_parentStyle = nullptr;
+                child->updateResolved();
+            }
         }
-        Vector2f RectStyle::getMarginHigh() const
+
+        BlockStyle & BlockStyle::operator = (const BlockStyle & style)
         {
-            return m_margin.has_value() ? Vector2f{ m_margin.value().z, m_margin.value().w } : (m_parent ? m_parent->getMarginHigh() : Vector2f{ 0.0f, 0.0f });
+            // Assigned once per base class, as a virtual base.
+            m_block = style.m_block;
+            setParentStyle(style.m_parentStyle);
+            updateResolved();
+            return *this;
         }
-        const Vector2f RectStyle::getPosition() const
+
+        void BlockStyle::updateEmptyProperties(const Selector * selector)
         {
-            return m_position.has_value() ? m_position.value() : (m_parent ? m_parent->getPosition() : Vector2f{ 0.0f, 0.0f });
+            assignSheetBlock(m_block, selector);
+            updateResolved();
         }
-        const Size RectStyle::getSize() const
+
+        void BlockStyle::resetSheetProperties()
         {
-            return m_size.has_value() ? m_size.value() : (m_parent ? m_parent->getSize() : Size{ 0.0f, 0.0f });
+            resetSheetBlock(m_block);
+            updateResolved();
         }
 
-        void RectStyle::setMargin(const Vector4f & margin)
+        void BlockStyle::releaseAnimatedValues()
         {
-            if (!m_margin.has_value())
+            if (!m_block || !m_block->animationRest)
             {
-                m_margin = { 0.0f, 0.0f, 0.0f, 0.0f };
+                return;
             }
 
-            if (m_margin.value() != margin)
+            if (!m_block->localProperties && m_block->hasEqualProperties(*m_block->animationRest, m_block->animatedProperties))
             {
-                m_margin = margin;
-                onResizeChange();
+                auto source = m_block->animationSource;
+                m_block = source;
+                updateResolved();
+                return;
             }
+
+            // Animated to other values, the copy is kept.
+            m_block->animationSource.reset();
+            m_block->animationRest.reset();
+            m_block->animatedProperties = 0;
         }
-        void RectStyle::setMargin(const Vector2f & margin)
+
+
+        float * BlockStyle::getAnimatedComponent(const PropertyId id, const size_t component)
         {
-            if (!m_margin.has_value())
+            float * values[4];
+            if (!m_block || component >= getBlockComponents(*m_block, id, values))
             {
-                m_margin = { 0.0f, 0.0f, 0.0f, 0.0f };
+                return nullptr;
             }
 
-            if (m_margin.value() != Vector4f{ margin.x, margin.y, margin.x, margin.y })
+            // The block may be shared again, e.g. by a copy of this style, values are only written to a block of its own.
+            getBlockComponents(detachBlock(m_block), id, values);
+            return values[component];
+        }
+
+        template<typename T>
+        static void resolveProperty(T & resolved, const std::optional<T> & property)
+        {
+            if (property.has_value())
             {
-                m_margin = { margin.x, margin.y, margin.x, margin.y };
-                onResizeChange();
+                resolved = property.value();
             }
         }
-        void RectStyle::setMargin(const float margin)
+
+        void BlockStyle::updateResolved()
         {
-            if (!m_margin.has_value())
+            m_resolved = m_parentStyle ? m_parentStyle->m_resolved : Resolved();
+            if (m_block)
+            {
+                const Block & block = *m_block;
+                resolveProperty(m_resolved.backgroundColor, block.backgroundColor);
+                if (block.backgroundGradient.has_value())
+                {
+                    m_resolved.backgroundGradient = block.backgroundGradient;
+                }
+                resolveProperty(m_resolved.borderColor, block.borderColor);
+                resolveProperty(m_resolved.borderStyle, block.borderStyle);
+                resolveProperty(m_resolved.borderWidth, block.borderWidth);
+                resolveProperty(m_resolved.fontBackgroundColor, block.fontBackgroundColor);
+                resolveProperty(m_resolved.fontColor, block.fontColor);
+                resolveProperty(m_resolved.fontFamily, block.fontFamily);
+                resolveProperty(m_resolved.fontSize, block.fontSize);
+                resolveProperty(m_resolved.horizontalAlign, block.horizontalAlign);
+                resolveProperty(m_resolved.margin, block.margin);
+                resolveProperty(m_resolved.overflow, block.overflow);
+                resolveProperty(m_resolved.padding, block.padding);
+                resolveProperty(m_resolved.position, block.position);
+                resolveProperty(m_resolved.size, block.size);
+                resolveProperty(m_resolved.transitionDuration, block.transitionDuration);
+                resolveProperty(m_resolved.verticalAlign, block.verticalAlign);
+            }
+            m_resolvedGeneration++;
+
+            for (auto child : m_childStyles)
             {
-                m_margin = { 0.0f, 0.0f, 0.0f, 0.0f };
+                child->updateResolved();
             }
+        }
+
+        uint64_t BlockStyle::getResolvedGeneration() const
+        {
+            return m_resolvedGeneration;
+        }
 
-            if (m_margin.value() != Vector4f{ margin, margin, margin, margin })
+        void BlockStyle::setParentStyle(BlockStyle * parent)
+        {
+            if (parent != m_parentStyle)
             {
-                m_margin = { margin, margin, margin, margin };
-                onResizeChange();
+                if (m_parentStyle)
+                {
+                    removeChildStyle(m_parentStyle->m_childStyles, this);
+                }
+                m_parentStyle = parent;
+                if (m_parentStyle)
+                {
+                    m_parentStyle->m_childStyles.push_back(this);
+                }
             }
-            
+            updateResolved();
         }
-        void RectStyle::setMarginLow(const Vector2f & marginLow)
+
+
+        // Parent style implementations.
+        ParentStyle::ParentStyle(Control * control, ParentStyle * parent) :
+            m_control(control)
+        {
+            setParentStyle(parent);
+        }
+
+        Vector4f ParentStyle::getPadding() const
+        {
+            return m_resolved.padding;
+        }
+        Vector2f ParentStyle::getPaddingLow() const
+        {
+            const Vector4f padding = getPadding();
+            return { padding.x, padding.y };
+        }
+        Vector2f ParentStyle::getPaddingHigh() const
         {
-            if (!m_margin.has_value())
+            const Vector4f padding = getPadding();
+            return { padding.z, padding.w };
+        }
+
+        void ParentStyle::setPadding(const Vector4f & padding)
+        {
+            if (setBlockProperty(m_block, &Block::padding, padding, PropertyId::Padding))
             {
-                m_margin = { 0.0f, 0.0f, 0.0f, 0.0f };
+                updateResolved();
+                resizeControl(m_control);
             }
+        }
+        void ParentStyle::setPadding(const Vector2f & padding)
+        {
+            setPadding(Vector4f{ padding.x, padding.y, padding.x, padding.y });
+        }
+        void ParentStyle::setPadding(const float & padding)
+        {
+            setPadding(Vector4f{ padding, padding, padding, padding });
+        }
+        void ParentStyle::setPaddingLow(const Vector2f & paddingLow)
+        {
+            auto current = findProperty(m_block, &Block::padding);
+            Vector4f padding = current ? *current : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
+            padding.x = paddingLow.x;
+            padding.y = paddingLow.y;
+            setPadding(padding);
+        }
+        void ParentStyle::setPaddingHigh(const Vector2f & paddingHigh)
+        {
+            auto current = findProperty(m_block, &Block::padding);
+            Vector4f padding = current ? *current : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
+            padding.z = paddingHigh.x;
+            padding.w = paddingHigh.y;
+            setPadding(padding);
+        }
 
-            if (marginLow.x != m_margin.value().x || marginLow.y != m_margin.value().y)
+        size_t ParentStyle::getAnimatedValues(const PropertyId id, float * values[4])
+        {
+            switch (id)
             {
-                m_margin.value().x = marginLow.x;
-                m_margin.value().y = marginLow.y;
-                onResizeChange();
+            case PropertyId::Padding: return getComponents(prepareAnimatedValue(m_block, &Block::padding, getPadding(), PropertyId::Padding), values);
+            default: break;
             }
+            return 0;
         }
-        void RectStyle::setMarginHigh(const Vector2f & marginHigh)
+
+        bool ParentStyle::hasEqualLayout(const ParentStyle & style) const
+        {
+            return getPadding() == style.getPadding();
+        }
+
+
+        // Align style implementations.
+        AlignStyle::AlignStyle(AlignStyle * parent)
         {
-            if (!m_margin.has_value())
+            setParentStyle(parent);
+        }
+
+        Property::HorizontalAlign AlignStyle::getHorizontalAlign() const
+        {
+            return m_resolved.horizontalAlign;
+        }
+        Property::VerticalAlign AlignStyle::getVerticalAlign() const
+        {
+            return m_resolved.verticalAlign;
+        }
+
+        void AlignStyle::setHorizontalAlign(const Property::HorizontalAlign horizontalAlign)
+        {
+            if (setBlockProperty(m_block, &Block::horizontalAlign, horizontalAlign, PropertyId::HorizontalAlign))
             {
-                m_margin = { 0.0f, 0.0f, 0.0f, 0.0f };
+                updateResolved();
             }
+        }
+        void AlignStyle::setVerticalAlign(const Property::VerticalAlign verticalAlign)
+        {
+            if (setBlockProperty(m_block, &Block::verticalAlign, verticalAlign, PropertyId::VerticalAlign))
+            {
+                updateResolved();
+            }
+        }
+
+
+        // Rect style implementations.
+        RectStyle::RectStyle(Control * control, RectStyle * parent) :
+            AlignStyle(parent),
+            m_control(control)
+        { }
+
+        Property::Overflow RectStyle::getOverflow() const
+        {
+            return m_resolved.overflow;
+        }
+        Vector4f RectStyle::getMargin() const
+        {
+            return m_resolved.margin;
+        }
+        Vector2f RectStyle::getMarginLow() const
+        {
+            const Vector4f margin = getMargin();
+            return { margin.x, margin.y };
+        }
+        Vector2f RectStyle::getMarginHigh() const
+        {
+            const Vector4f margin = getMargin();
+            return { margin.z, margin.w };
+        }
+        const Vector2f RectStyle::getPosition() const
+        {
+            return m_resolved.position;
+        }
+        const Size RectStyle::getSize() const
+        {
+            return m_resolved.size;
+        }
 
-            if (marginHigh.x != m_margin.value().z || marginHigh.y != m_margin.value().w)
+        void RectStyle::setMargin(const Vector4f & margin)
+        {
+            if (setBlockProperty(m_block, &Block::margin, margin, PropertyId::Margin))
             {
-                m_margin.value().z = marginHigh.x;
-                m_margin.value().w = marginHigh.y;
-                onResizeChange();
-            }          
+                updateResolved();
+                resizeControl(m_control);
+            }
+        }
+        void RectStyle::setMargin(const Vector2f & margin)
+        {
+            setMargin(Vector4f{ margin.x, margin.y, margin.x, margin.y });
+        }
+        void RectStyle::setMargin(const float margin)
+        {
+            setMargin(Vector4f{ margin, margin, margin, margin });
+        }
+        void RectStyle::setMarginLow(const Vector2f & marginLow)
+        {
+            auto current = findProperty(m_block, &Block::margin);
+            Vector4f margin = current ? *current : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
+            margin.x = marginLow.x;
+            margin.y = marginLow.y;
+            setMargin(margin);
+        }
+        void RectStyle::setMarginHigh(const Vector2f & marginHigh)
+        {
+            auto current = findProperty(m_block, &Block::margin);
+            Vector4f margin = current ? *current : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f };
+            margin.z = marginHigh.x;
+            margin.w = marginHigh.y;
+            setMargin(margin);
         }
         void RectStyle::setOverflow(const Property::Overflow overflow)
         {
-            if (overflow != m_overflow)
+            if (setBlockProperty(m_block, &Block::overflow, overflow, PropertyId::Overflow))
             {
-                m_overflow = overflow;
-                onResizeChange();
+                updateResolved();
+                resizeControl(m_control);
             }
         }
         void RectStyle::setPosition(const Vector2f & position)
         {
-            if (position != m_position)
+            if (setBlockProperty(m_block, &Block::position, position, PropertyId::Position))
             {
-                m_position = position;
-                onResizeChange();
+                updateResolved();
+                resizeControl(m_control);
             }
         }
         void RectStyle::setSize(const Size & size)
         {
-            if (size != m_size)
+            if (setBlockProperty(m_block, &Block::size, size, PropertyId::Size))
             {
-                m_size = size;
-                onResizeChange();
+                updateResolved();
+                resizeControl(m_control);
             }
         }
 
-        void RectStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        size_t RectStyle::getAnimatedValues(const PropertyId id, float * values[4])
         {
-            if (!selector)
+            switch (id)
             {
-                return;
-            }
-
-            AlignStyle::updateEmptyProperties(selector);
-
-            if (!m_margin.has_value())
-            {
-                auto margin = selector->getProperty("margin");
-                if (margin)
-                {
-                    switch (margin->getDataType())
-                    {
-                    case Property::DataType::Float:
-                    {
-                        auto val = margin->getFloat();
-                        m_margin = { val, val, val, val };
-                    }
-                    break;
-                    case Property::DataType::Vector2f:
-                    {
-                        m_margin = { margin->getVector2f(), margin->getVector2f() };
-                    }
-                    break;
-                    case Property::DataType::Vector4f:
-                    {
-                        m_margin = margin->getVector4f();
-                    }
-                    break;
-                    default: break;
-                    }
-                }
-            }
-
-            if (!m_overflow.has_value())
+            case PropertyId::Margin: return getComponents(prepareAnimatedValue(m_block, &Block::margin, getMargin(), PropertyId::Margin), values);
+            case PropertyId::Position: return getComponents(prepareAnimatedValue(m_block, &Block::position, getPosition(), PropertyId::Position), values);
+            case PropertyId::Size:
             {
-                auto overflow = selector->getProperty("overflow");
-                if (overflow && overflow->getDataType() == Property::DataType::Overflow)
-                {
-                    m_overflow = overflow->getOverflow();
-                }
+                Vector2f & size = prepareAnimatedValue(m_block, &Block::size, getSize(), PropertyId::Size);
+                return getComponents(size, values);
             }
-
-            if (!m_position.has_value())
-            {
-                auto position = selector->getProperty("position");
-                if (position && position->getDataType() == Property::DataType::Vector2f)
-                {
-                    m_position = position->getVector2f();
-                }
+            default: break;
             }
+            return 0;
+        }
 
-            if (!m_size.has_value())
-            {
-                auto size = selector->getProperty("size");
-                if (size)
-                {
-                    switch (size->getDataType())
-                    {
-                        case Property::DataType::Size:
-                        {
-                            m_size = size->getSize();
-                        }
-                        break;
-                        case Property::DataType::Vector2f:
-                        {
-                            m_size = size->getVector2f();
-                        }
-                        break;
-                        default: break;
-                    }
-                }
-            }
+        bool RectStyle::hasEqualLayout(const RectStyle & style) const
+        {
+            const Size size = getSize();
+            const Size styleSize = style.getSize();
+            return size == styleSize && size.fit.x == styleSize.fit.x && size.fit.y == styleSize.fit.y &&
+                getPosition() == style.getPosition() &&
+                getMargin() == style.getMargin() &&
+                getOverflow() == style.getOverflow() &&
+                getHorizontalAlign() == style.getHorizontalAlign() &&
+                getVerticalAlign() == style.getVerticalAlign();
         }
 
         Bounds2f RectStyle::calcStyledBounds(const RectStyle & style, const Bounds2f & canvasBounds, const float scale)
@@ -1127,294 +1845,194 @@ namespace Guise
             return bounds;
         }
 
-
         // Border style implementations.
-        BorderStyle::BorderStyle(BorderStyle * parent) :
-            m_parent(parent)
-        { }
+        BorderStyle::BorderStyle(BorderStyle * parent)
+        {
+            setParentStyle(parent);
+        }
 
         const Vector4f BorderStyle::getBorderColor() const
         {
-            return m_borderColor.has_value() ? m_borderColor.value() : (m_parent ? m_parent->getBorderColor() : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
+            return m_resolved.borderColor;
         }
         Property::BorderStyle BorderStyle::getBorderStyle() const
         {
-            return m_borderStyle.has_value() ? m_borderStyle.value() : (m_parent ? m_parent->getBorderStyle() : Property::BorderStyle::None);
+            return m_resolved.borderStyle;
         }
         float BorderStyle::getBorderWidth() const
         {
-            return m_borderWidth.has_value() ? m_borderWidth.value() : (m_parent ? m_parent->getBorderWidth() : 0.0f);
+            return m_resolved.borderWidth;
         }
 
         void BorderStyle::setBorderColor(const Vector4f & color)
         {
-            m_borderColor = color;
+            if (setBlockProperty(m_block, &Block::borderColor, color, PropertyId::BorderColor))
+            {
+                updateResolved();
+            }
         }
         void BorderStyle::setBorderStyle(const Property::BorderStyle style)
         {
-            m_borderStyle = style;
+            if (setBlockProperty(m_block, &Block::borderStyle, style, PropertyId::BorderStyle))
+            {
+                updateResolved();
+            }
         }
         void BorderStyle::setBorderWidth(const float width)
         {
-            m_borderWidth = width;
-        }
-
-        void BorderStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
-        {
-            if (!selector)
+            if (setBlockProperty(m_block, &Block::borderWidth, width, PropertyId::BorderWidth))
             {
-                return;
+                updateResolved();
             }
+        }
 
-            if (!m_borderColor.has_value())
-            {
-                auto borderColor = selector->getProperty("border-color");
-                if (borderColor && borderColor->getDataType() == Property::DataType::Vector4f)
-                {
-                    m_borderColor = borderColor->getVector4f();
-                }
-            }
-            if (!m_borderStyle.has_value())
+        size_t BorderStyle::getAnimatedValues(const PropertyId id, float * values[4])
+        {
+            switch (id)
             {
-                auto borderStyle = selector->getProperty("border-style");
-                if (borderStyle && borderStyle->getDataType() == Property::DataType::BorderStyle)
-                {
-                    m_borderStyle = borderStyle->getBorderStyle();
-                }
+            case PropertyId::BorderColor: return getComponents(prepareAnimatedValue(m_block, &Block::borderColor, getBorderColor(), PropertyId::BorderColor), values);
+            case PropertyId::BorderWidth: return getComponents(prepareAnimatedValue(m_block, &Block::borderWidth, getBorderWidth(), PropertyId::BorderWidth), values);
+            default: break;
             }
-            if (!m_borderWidth.has_value())
-            {
-                auto borderWidth = selector->getProperty("border-width");
-                if (borderWidth && borderWidth->getDataType() == Property::DataType::Float)
-                {
-                    m_borderWidth = borderWidth->getFloat();
-                }
-            }          
+            return 0;
         }
 
 
         // Paint rect style
         PaintRectStyle::PaintRectStyle(Control * control, PaintRectStyle * parent) :
             RectStyle(control, parent),
-            BorderStyle(parent),
-            m_parent(parent)
+            BorderStyle(parent)
         { }
 
         const Vector4f PaintRectStyle::getBackgroundColor() const
         {
-            return m_backgroundColor.has_value() ? m_backgroundColor.value() : (m_parent ? m_parent->getBackgroundColor() : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
+            return m_resolved.backgroundColor;
         }
 
-        void PaintRectStyle::setBackgroundColor(const Vector4f & color)
+        const std::optional<LinearGradient> & PaintRectStyle::getBackgroundGradient() const
         {
-            m_backgroundColor = color;
+            return m_resolved.backgroundGradient;
         }
 
-        void PaintRectStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        float PaintRectStyle::getTransitionDuration() const
         {
-            if (!selector)
+            return m_resolved.transitionDuration;
+        }
+
+        void PaintRectStyle::setBackgroundColor(const Vector4f & color)
+        {
+            if (setBlockProperty(m_block, &Block::backgroundColor, color, PropertyId::BackgroundColor))
             {
-                return;
+                updateResolved();
             }
+        }
 
-            Style::RectStyle::updateEmptyProperties(selector);
-            Style::BorderStyle::updateEmptyProperties(selector);
-
-            if (!m_backgroundColor.has_value())
+        void PaintRectStyle::setBackgroundGradient(const LinearGradient & gradient)
+        {
+            if (setBlockProperty(m_block, &Block::backgroundGradient, gradient, PropertyId::BackgroundGradient))
             {
-                auto bgColor = selector->getProperty("background-color");
-                if (bgColor)
-                {
-                    switch (bgColor->getDataType())
-                    {
-                        case Property::DataType::Float:
-                        {
-                            auto val = bgColor->getFloat();
-                            m_backgroundColor = { val, val, val, 1.0f };
-                        }
-                        break;
-                        case Property::DataType::Vector3f:
-                        {
-                            m_backgroundColor = { bgColor->getVector3f(), 1.0f };
-                        }
-                        break;
-                        case Property::DataType::Vector4f:
-                        {
-                            m_backgroundColor = bgColor->getVector4f();
-                        }
-                        break;
-                        default: break;
-                    }
-                }
+                updateResolved();
             }
         }
 
+        void PaintRectStyle::setTransitionDuration(const float seconds)
+        {
+            if (setBlockProperty(m_block, &Block::transitionDuration, seconds, PropertyId::TransitionDuration))
+            {
+                updateResolved();
+            }
+        }
 
-        // Font style implementations.
-        FontStyle::FontStyle(Control * control, FontStyle * parent) :
-            m_parent(parent)
+        size_t PaintRectStyle::getAnimatedValues(const PropertyId id, float * values[4])
         {
-            if (control)
+            if (id == PropertyId::BackgroundColor)
             {
-                onResizeChange.connectAnonymously([control]()
-                {
-                    control->resize();
-                });
+                return getComponents(prepareAnimatedValue(m_block, &Block::backgroundColor, getBackgroundColor(), PropertyId::BackgroundColor), values);
             }
+
+            const size_t count = RectStyle::getAnimatedValues(id, values);
+            return count ? count : BorderStyle::getAnimatedValues(id, values);
         }
 
+
+        // Font style implementations.
+        FontStyle::FontStyle(Control * control, FontStyle * parent) :
+            RectStyle(control, parent)
+        { }
+
         const Vector4f FontStyle::getFontBackgroundColor() const
         {
-            return m_fontBackgroundColor.has_value() ? m_fontBackgroundColor.value() : (m_parent ? m_parent->getFontBackgroundColor() : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
+            return m_resolved.fontBackgroundColor;
         }
         const Vector4f FontStyle::getFontColor() const
         {
-            return m_fontColor.has_value() ? m_fontColor.value() : (m_parent ? m_parent->getFontColor() : Vector4f{ 0.0f, 0.0f, 0.0f, 0.0f });
+            return m_resolved.fontColor;
         }
-        const std::string FontStyle::getFontFamily() const
+        const std::string & FontStyle::getFontFamily() const
         {
-            return m_fontFamily.has_value() ? m_fontFamily.value() : (m_parent ? m_parent->getFontFamily() : "");
+            return *m_resolved.fontFamily;
         }
         const int32_t FontStyle::getFontSize() const
         {
-            return m_fontSize.has_value() ? m_fontSize.value() : (m_parent ? m_parent->getFontSize() : 0);
-        }  
+            return m_resolved.fontSize;
+        }
 
         void FontStyle::setFontBackgroundColor(const Vector4f & color)
         {
-            m_fontBackgroundColor = color;
+            if (setBlockProperty(m_block, &Block::fontBackgroundColor, color, PropertyId::FontBackgroundColor))
+            {
+                updateResolved();
+            }
         }
         void FontStyle::setFontColor(const Vector4f & color)
         {
-            m_fontColor = color;
+            if (setBlockProperty(m_block, &Block::fontColor, color, PropertyId::FontColor))
+            {
+                updateResolved();
+            }
         }
         void FontStyle::setFontFamily(const std::string & family)
         {
-            m_fontFamily = family;
+            if (setBlockProperty(m_block, &Block::fontFamily, internString(family), PropertyId::FontFamily))
+            {
+                updateResolved();
+            }
         }
         void FontStyle::setFontSize(const int32_t size)
         {
-            if (size != m_fontSize)
+            if (setBlockProperty(m_block, &Block::fontSize, size, PropertyId::FontSize))
             {
-                m_fontSize = size;
-                onResizeChange();
+                updateResolved();
+                resizeControl(m_control);
             }
         }
 
-        void FontStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        size_t FontStyle::getAnimatedValues(const PropertyId id, float * values[4])
         {
-            if (!selector)
-            {
-                return;
-            }
-
-            RectStyle::updateEmptyProperties(selector);
-
-            if (!m_fontBackgroundColor.has_value())
-            {
-                auto fontBgColor = selector->getProperty("font-background-color");
-                if (fontBgColor)
-                {
-                    switch (fontBgColor->getDataType())
-                    {
-                    case Property::DataType::Integer:
-                    {
-                        float val = static_cast<float>(fontBgColor->getInteger());
-                        m_fontBackgroundColor = { val, val, val, 1.0f };
-                    }
-                    break;
-                    case Property::DataType::Float:
-                    {
-                        float val = static_cast<float>(fontBgColor->getFloat());
-                        m_fontBackgroundColor = { val, val, val, 1.0f };
-                    }
-                    case Property::DataType::Vector3f:
-                    {
-                        m_fontBackgroundColor = { fontBgColor->getVector3f(), 1.0f };
-                    }
-                    break;
-                    case Property::DataType::Vector4f:
-                    {
-                        m_fontBackgroundColor = fontBgColor->getVector4f();
-                    }
-                    break;
-                    default: break;
-                    }
-                }
-            }
-
-            if (!m_fontColor.has_value())
-            {
-                auto fontColor = selector->getProperty("font-color");
-                if (fontColor)
-                {
-                    switch (fontColor->getDataType())
-                    {
-                    case Property::DataType::Integer:
-                    {
-                        float val = static_cast<float>(fontColor->getInteger());
-                        m_fontColor = { val, val, val, 1.0f };
-                    }
-                    break;
-                    case Property::DataType::Float:
-                    {
-                        float val = static_cast<float>(fontColor->getFloat());
-                        m_fontColor = { val, val, val, 1.0f };
-                    }
-                    case Property::DataType::Vector3f:
-                    {
-                        m_fontColor = { fontColor->getVector3f(), 1.0f };
-                    }
-                    break;
-                    case Property::DataType::Vector4f:
-                    {
-                        m_fontColor = fontColor->getVector4f();
-                    }
-                    break;
-                    default: break;
-                    }
-                }
-            }
-
-            if (!m_fontFamily.has_value())
-            {
-                auto fontFamily = selector->getProperty("font-family");
-                if (fontFamily && fontFamily->getDataType() == Property::DataType::String)
-                {
-                    m_fontFamily = fontFamily->getString();
-                }
-            }
-
-            if (!m_fontSize.has_value())
+            switch (id)
             {
-                auto fontSize = selector->getProperty("font-size");
-                if (fontSize && fontSize->getDataType() == Property::DataType::Integer)
-                {
-                    m_fontSize = fontSize->getInteger();
-                }
-            }
-
-            if (!m_overflow.has_value())
-            {
-                auto overflow = selector->getProperty("overflow");
-                if (overflow && overflow->getDataType() == Property::DataType::Overflow)
-                {
-                    m_overflow = overflow->getOverflow();
-                }
+            case PropertyId::FontBackgroundColor: return getComponents(prepareAnimatedValue(m_block, &Block::fontBackgroundColor, getFontBackgroundColor(), PropertyId::FontBackgroundColor), values);
+            case PropertyId::FontColor: return getComponents(prepareAnimatedValue(m_block, &Block::fontColor, getFontColor(), PropertyId::FontColor), values);
+            default: break;
             }
+            return RectStyle::getAnimatedValues(id, values);
         }
 
-
         // Parent rect style.
         ParentRectStyle::ParentRectStyle(Control * control, ParentRectStyle * parent) :
             Style::RectStyle(control, parent),
             Style::ParentStyle(control, parent)
         { }
 
-        void ParentRectStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        size_t ParentRectStyle::getAnimatedValues(const PropertyId id, float * values[4])
         {
-            Style::RectStyle::updateEmptyProperties(selector);
-            Style::ParentStyle::updateEmptyProperties(selector);
+            const size_t count = Style::RectStyle::getAnimatedValues(id, values);
+            return count ? count : Style::ParentStyle::getAnimatedValues(id, values);
+        }
+
+        bool ParentRectStyle::hasEqualLayout(const ParentRectStyle & style) const
+        {
+            return Style::RectStyle::hasEqualLayout(style) && Style::ParentStyle::hasEqualLayout(style);
         }
 
 
@@ -1424,12 +2042,16 @@ namespace Guise
             Style::ParentStyle(control, parent)
         { }
 
-        void ParentPaintRectStyle::updateEmptyProperties(const std::shared_ptr<Selector> & selector)
+        size_t ParentPaintRectStyle::getAnimatedValues(const PropertyId id, float * values[4])
         {
-            Style::PaintRectStyle::updateEmptyProperties(selector);
-            Style::ParentStyle::updateEmptyProperties(selector);
+            const size_t count = Style::PaintRectStyle::getAnimatedValues(id, values);
+            return count ? count : Style::ParentStyle::getAnimatedValues(id, values);
         }
 
+        bool ParentPaintRectStyle::hasEqualLayout(const ParentPaintRectStyle & style) const
+        {
+            return Style::PaintRectStyle::hasEqualLayout(style) && Style::ParentStyle::hasEqualLayout(style);
+        }
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,613 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/style.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#if defined(GUISE_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+* Binary style sheet layout, all fields are 32 bit and native endian:
+*
+*   BinaryHeader
+*   BinaryString[stringCount]       Offset and length into the string data.
+*   BinarySelector[selectorCount]   Selector name and its range of properties.
+*   BinaryProperty[propertyCount]   Property name, data type and packed value.
+*   char[]                          String data, not null terminated.
+*
+* Identifiers of unknown names are interned at runtime and may differ between processes,
+* so selector and property names are stored once in the string table and interned at load.
+* Built-in identifiers are stored alongside their names and used as is if the identifier counts of
+* the header match this build, a sheet of built-in names is loaded without interning any of them.
+*/
+
+namespace Guise
+{
+
+    namespace Style
+    {
+
+        static const char g_binaryMagic[4] = { 'G', 'S', 'S', 'B' };
+        static const uint32_t g_binaryVersion = 2; ///< Increment when reordering PropertyId or SelectorId.
+        static const uint32_t g_noBuiltInId = UINT32_MAX;
+        static const PropertyId g_uninternedId = static_cast<PropertyId>(UINT16_MAX);
+
+        struct BinaryHeader
+        {
+            char        magic[4];
+            uint32_t    version;
+            uint32_t    propertyIdCount;    ///< PropertyId::Count of the writer.
+            uint32_t    selectorIdCount;    ///< SelectorId::Count of the writer.
+            uint32_t    stringCount;
+            uint32_t    selectorCount;
+            uint32_t    propertyCount;
+            uint32_t    stringDataSize;
+        };
+
+        struct BinaryString
+        {
+            uint32_t    offset;
+            uint32_t    length;
+        };
+
+        struct BinarySelector
+        {
+            uint32_t    name;
+            uint32_t    builtInId;      ///< SelectorId if below SelectorId::Count, else g_noBuiltInId.
+            uint32_t    firstProperty;
+            uint32_t    propertyCount;
+        };
+
+        struct BinaryProperty
+        {
+            uint32_t    name;
+            uint32_t    builtInId;      ///< PropertyId if below PropertyId::Count, else g_noBuiltInId.
+            uint32_t    dataType;
+            uint32_t    integers[2];    ///< Boolean, enumerations, Integer, String index and Size fits.
+            float       floats[9];      ///< Float, vectors, Size and LinearGradient angle followed by its colors.
+        };
+
+        template<typename T>
+        static T readRecord(const uint8_t * data, const size_t index)
+        {
+            // Embedded data is not necessarily aligned, copy instead of casting.
+            T record;
+            std::memcpy(&record, data + (index * sizeof(T)), sizeof(T));
+            return record;
+        }
+
+        template<typename T>
+        static void writeRecord(std::vector<uint8_t> & data, const T & record)
+        {
+            const size_t offset = data.size();
+            data.resize(offset + sizeof(T));
+            std::memcpy(data.data() + offset, &record, sizeof(T));
+        }
+
+        static void packVector(float * floats, const Vector2f & vector)
+        {
+            floats[0] = vector.x;
+            floats[1] = vector.y;
+        }
+        static void packVector(float * floats, const Vector3f & vector)
+        {
+            floats[0] = vector.x;
+            floats[1] = vector.y;
+            floats[2] = vector.z;
+        }
+        static void packVector(float * floats, const Vector4f & vector)
+        {
+            floats[0] = vector.x;
+            floats[1] = vector.y;
+            floats[2] = vector.z;
+            floats[3] = vector.w;
+        }
+
+        static bool setError(std::string * error, const std::string & message)
+        {
+            if (error)
+            {
+                *error = message;
+            }
+            return false;
+        }
+
+        template<typename Id>
+        static uint32_t getBuiltInId(const Id id)
+        {
+            return id < Id::Count ? static_cast<uint32_t>(id) : g_noBuiltInId;
+        }
+
+        class SheetBinaryWriter
+        {
+
+        public:
+
+            std::vector<uint8_t> write(const Selectors & selectors)
+            {
+                std::vector<BinarySelector> binarySelectors;
+                std::vector<BinaryProperty> binaryProperties;
+
+                for (size_t i = 0; i < selectors.size(); i++)
+                {
+                    if (!selectors[i].has_value())
+                    {
+                        continue;
+                    }
+
+                    auto & properties = selectors[i]->getProperties();
+                    BinarySelector binarySelector = {};
+                    binarySelector.name = addString(getSelectorName(static_cast<SelectorId>(i)));
+                    binarySelector.builtInId = getBuiltInId(static_cast<SelectorId>(i));
+                    binarySelector.firstProperty = static_cast<uint32_t>(binaryProperties.size());
+                    binarySelector.propertyCount = static_cast<uint32_t>(properties.size());
+                    binarySelectors.push_back(binarySelector);
+
+                    for (auto & property : properties)
+                    {
+                        binaryProperties.push_back(packProperty(property.first, property.second));
+                    }
+                }
+
+                BinaryHeader header = {};
+                std::memcpy(header.magic, g_binaryMagic, sizeof(header.magic));
+                header.version = g_binaryVersion;
+                header.propertyIdCount = static_cast<uint32_t>(PropertyId::Count);
+                header.selectorIdCount = static_cast<uint32_t>(SelectorId::Count);
+                header.stringCount = static_cast<uint32_t>(m_strings.size());
+                header.selectorCount = static_cast<uint32_t>(binarySelectors.size());
+                header.propertyCount = static_cast<uint32_t>(binaryProperties.size());
+                header.stringDataSize = static_cast<uint32_t>(m_stringData.size());
+
+                std::vector<uint8_t> data;
+                data.reserve(sizeof(BinaryHeader) + (m_strings.size() * sizeof(BinaryString)) +
+                    (binarySelectors.size() * sizeof(BinarySelector)) + (binaryProperties.size() * sizeof(BinaryProperty)) +
+                    m_stringData.size());
+
+                writeRecord(data, header);
+                for (auto & string : m_strings)
+                {
+                    writeRecord(data, string);
+                }
+                for (auto & selector : binarySelectors)
+                {
+                    writeRecord(data, selector);
+                }
+                for (auto & property : binaryProperties)
+                {
+                    writeRecord(data, property);
+                }
+                data.insert(data.end(), m_stringData.begin(), m_stringData.end());
+                return data;
+            }
+
+        private:
+
+            uint32_t addString(const std::string & string)
+            {
+                auto it = m_stringIndices.find(string);
+                if (it != m_stringIndices.end())
+                {
+                    return it->second;
+                }
+
+                const uint32_t index = static_cast<uint32_t>(m_strings.size());
+                m_strings.push_back({ static_cast<uint32_t>(m_stringData.size()), static_cast<uint32_t>(string.size()) });
+                m_stringData.insert(m_stringData.end(), string.begin(), string.end());
+                m_stringIndices.insert({ string, index });
+                return index;
+            }
+
+            BinaryProperty packProperty(const PropertyId id, const Property & property)
+            {
+                BinaryProperty binary = {};
+                binary.name = addString(getPropertyName(id));
+                binary.builtInId = getBuiltInId(id);
+                binary.dataType = static_cast<uint32_t>(property.getDataType());
+
+                switch (property.getDataType())
+                {
+                case Property::DataType::Boolean: binary.integers[0] = property.getBool() ? 1 : 0; break;
+                case Property::DataType::BorderStyle: binary.integers[0] = static_cast<uint32_t>(property.getBorderStyle()); break;
+                case Property::DataType::Float: binary.floats[0] = property.getFloat(); break;
+                case Property::DataType::Integer: binary.integers[0] = static_cast<uint32_t>(property.getInteger()); break;
+                case Property::DataType::LinearGradient:
+                {
+                    auto & gradient = property.getLinearGradient();
+                    binary.floats[0] = gradient.getAngle();
+                    packVector(binary.floats + 1, gradient.getColorA());
+                    packVector(binary.floats + 5, gradient.getColorB());
+                }
+                break;
+                case Property::DataType::Overflow: binary.integers[0] = static_cast<uint32_t>(property.getOverflow()); break;
+                case Property::DataType::Size:
+                {
+                    auto & size = property.getSize();
+                    packVector(binary.floats, size);
+                    binary.integers[0] = static_cast<uint32_t>(size.fit.x);
+                    binary.integers[1] = static_cast<uint32_t>(size.fit.y);
+                }
+                break;
+                case Property::DataType::String: binary.integers[0] = addString(property.getString()); break;
+                case Property::DataType::Vector2f: packVector(binary.floats, property.getVector2f()); break;
+                case Property::DataType::Vector3f: packVector(binary.floats, property.getVector3f()); break;
+                case Property::DataType::Vector4f: packVector(binary.floats, property.getVector4f()); break;
+                case Property::DataType::HorizontalAlign: binary.integers[0] = static_cast<uint32_t>(property.getHorizontalAlign()); break;
+                case Property::DataType::VerticalAlign: binary.integers[0] = static_cast<uint32_t>(property.getVerticalAlign()); break;
+                default: break;
+                }
+
+                return binary;
+            }
+
+            std::vector<BinaryString> m_strings;
+            std::vector<char> m_stringData;
+            std::unordered_map<std::string, uint32_t> m_stringIndices;
+
+        };
+
+        class SheetBinaryReader
+        {
+
+        public:
+
+            SheetBinaryReader(const uint8_t * data, const size_t size) :
+                m_data(data),
+                m_size(size),
+                m_header{},
+                m_builtInIds(false),
+                m_stringData(nullptr)
+            { }
+
+            bool read(Sheet & sheet, std::string * error)
+            {
+                if (m_size < sizeof(BinaryHeader))
+                {
+                    return setError(error, "binary style sheet is truncated");
+                }
+                m_header = readRecord<BinaryHeader>(m_data, 0);
+                if (std::memcmp(m_header.magic, g_binaryMagic, sizeof(g_binaryMagic)) != 0)
+                {
+                    return setError(error, "not a binary style sheet");
+                }
+                if (m_header.version != g_binaryVersion)
+                {
+                    return setError(error, "unsupported binary style sheet version " + std::to_string(m_header.version));
+                }
+                m_builtInIds =
+                    m_header.propertyIdCount == static_cast<uint32_t>(PropertyId::Count) &&
+                    m_header.selectorIdCount == static_cast<uint32_t>(SelectorId::Count);
+
+                // Counts are 32 bit, the total size cannot overflow 64 bit arithmetic.
+                const uint64_t stringsOffset = sizeof(BinaryHeader);
+                const uint64_t selectorsOffset = stringsOffset + (uint64_t(m_header.stringCount) * sizeof(BinaryString));
+                const uint64_t propertiesOffset = selectorsOffset + (uint64_t(m_header.selectorCount) * sizeof(BinarySelector));
+                const uint64_t stringDataOffset = propertiesOffset + (uint64_t(m_header.propertyCount) * sizeof(BinaryProperty));
+                if (stringDataOffset + m_header.stringDataSize > m_size)
+                {
+                    return setError(error, "binary style sheet is truncated");
+                }
+
+                const uint8_t * strings = m_data + stringsOffset;
+                const uint8_t * selectors = m_data + selectorsOffset;
+                const uint8_t * properties = m_data + propertiesOffset;
+                m_stringData = m_data + stringDataOffset;
+
+                // Intern every name once, selectors and properties refer to them by index.
+                m_strings.reserve(m_header.stringCount);
+                for (uint32_t i = 0; i < m_header.stringCount; i++)
+                {
+                    auto string = readRecord<BinaryString>(strings, i);
+                    if (size_t(string.offset) + string.length > m_header.stringDataSize)
+                    {
+                        return setError(error, "binary style sheet string " + std::to_string(i) + " is out of range");
+                    }
+                    m_strings.push_back(string);
+                }
+                m_propertyIds.resize(m_strings.size(), g_uninternedId);
+
+                for (uint32_t i = 0; i < m_header.selectorCount; i++)
+                {
+                    auto binarySelector = readRecord<BinarySelector>(selectors, i);
+                    if (binarySelector.name >= m_strings.size() ||
+                        size_t(binarySelector.firstProperty) + binarySelector.propertyCount > m_header.propertyCount)
+                    {
+                        return setError(error, "binary style sheet selector " + std::to_string(i) + " is out of range");
+                    }
+
+                    auto & targetProperties = sheet.getOrAddSelector(getSelectorId(binarySelector)).getProperties();
+                    if (!targetProperties.empty())
+                    {
+                        return setError(error, "binary style sheet selector " + std::to_string(i) + " is duplicated");
+                    }
+                    targetProperties.reserve(binarySelector.propertyCount);
+
+                    for (uint32_t j = 0; j < binarySelector.propertyCount; j++)
+                    {
+                        auto binaryProperty = readRecord<BinaryProperty>(properties, binarySelector.firstProperty + j);
+                        if (binaryProperty.name >= m_strings.size())
+                        {
+                            return setError(error, "binary style sheet property " + std::to_string(j) + " is out of range");
+                        }
+
+                        std::optional<Property> property = unpackProperty(binaryProperty);
+                        if (!property)
+                        {
+                            return setError(error, "binary style sheet property " + std::to_string(j) + " has an invalid value");
+                        }
+                        targetProperties.emplace_back(getPropertyId(binaryProperty), *property);
+                    }
+
+                    // Identifiers of this process order the properties differently than in the writing process, sort them once.
+                    std::sort(targetProperties.begin(), targetProperties.end(),
+                        [](const Properties::value_type & a, const Properties::value_type & b)
+                    {
+                        return a.first < b.first;
+                    });
+                    if (std::adjacent_find(targetProperties.begin(), targetProperties.end(),
+                        [](const Properties::value_type & a, const Properties::value_type & b)
+                    {
+                        return a.first == b.first;
+                    }) != targetProperties.end())
+                    {
+                        return setError(error, "binary style sheet selector " + std::to_string(i) + " has duplicated properties");
+                    }
+                }
+
+                return true;
+            }
+
+        private:
+
+            SelectorId getSelectorId(const BinarySelector & binary) const
+            {
+                if (m_builtInIds && binary.builtInId < static_cast<uint32_t>(SelectorId::Count))
+                {
+                    return static_cast<SelectorId>(binary.builtInId);
+                }
+                return internSelectorId(getString(binary.name));
+            }
+
+            // Property names repeat across selectors, intern each string of the table at most once.
+            PropertyId getPropertyId(const BinaryProperty & binary)
+            {
+                if (m_builtInIds && binary.builtInId < static_cast<uint32_t>(PropertyId::Count))
+                {
+                    return static_cast<PropertyId>(binary.builtInId);
+                }
+
+                auto & id = m_propertyIds[binary.name];
+                if (id == g_uninternedId)
+                {
+                    id = internPropertyId(getString(binary.name));
+                }
+                return id;
+            }
+
+            std::string getString(const uint32_t index) const
+            {
+                auto & string = m_strings[index];
+                return std::string(reinterpret_cast<const char *>(m_stringData) + string.offset, string.length);
+            }
+
+            std::optional<Property> unpackProperty(const BinaryProperty & binary) const
+            {
+                const float * f = binary.floats;
+                const uint32_t value = binary.integers[0];
+
+                switch (static_cast<Property::DataType>(binary.dataType))
+                {
+                case Property::DataType::Boolean: return Property(value != 0);
+                case Property::DataType::BorderStyle: return Property(static_cast<Property::BorderStyle>(value));
+                case Property::DataType::Float: return Property(f[0]);
+                case Property::DataType::Integer: return Property(static_cast<int>(value));
+                case Property::DataType::LinearGradient:
+                    return Property(LinearGradient(f[0], { f[1], f[2], f[3], f[4] }, { f[5], f[6], f[7], f[8] }));
+                case Property::DataType::Overflow: return Property(static_cast<Property::Overflow>(value));
+                case Property::DataType::Size:
+                {
+                    Size size(f[0], f[1]);
+                    size.fit = { static_cast<Size::Fit>(binary.integers[0]), static_cast<Size::Fit>(binary.integers[1]) };
+                    return Property(size);
+                }
+                case Property::DataType::String:
+                    if (value >= m_strings.size())
+                    {
+                        return std::nullopt;
+                    }
+                    return Property(getString(value));
+                case Property::DataType::Vector2f: return Property(Vector2f(f[0], f[1]));
+                case Property::DataType::Vector3f: return Property(Vector3f(f[0], f[1], f[2]));
+                case Property::DataType::Vector4f: return Property(Vector4f(f[0], f[1], f[2], f[3]));
+                case Property::DataType::HorizontalAlign: return Property(static_cast<Property::HorizontalAlign>(value));
+                case Property::DataType::VerticalAlign: return Property(static_cast<Property::VerticalAlign>(value));
+                default: break;
+                }
+                return std::nullopt;
+            }
+
+            const uint8_t *             m_data;
+            size_t                      m_size;
+            BinaryHeader                m_header;
+            bool                        m_builtInIds;  ///< Identifier counts match, built-in identifiers are used as is.
+            const uint8_t *             m_stringData;
+            std::vector<BinaryString>   m_strings;
+            std::vector<PropertyId>     m_propertyIds; ///< g_uninternedId until interned.
+
+        };
+
+        // Read-only mapping of a whole file, unmapped on destruction.
+        class MappedFile
+        {
+
+        public:
+
+            MappedFile(const std::string & filename) :
+                m_data(nullptr),
+                m_size(0)
+            {
+            #if defined(GUISE_PLATFORM_WINDOWS)
+                m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                m_mapping = NULL;
+                if (m_file == INVALID_HANDLE_VALUE)
+                {
+                    return;
+                }
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+                {
+                    return;
+                }
+                m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (m_mapping == NULL)
+                {
+                    return;
+                }
+                m_data = static_cast<const uint8_t *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                m_size = m_data ? static_cast<size_t>(size.QuadPart) : 0;
+            #elif defined(GUISE_PLATFORM_LINUX)
+                const int file = open(filename.c_str(), O_RDONLY);
+                if (file < 0)
+                {
+                    return;
+                }
+                struct stat status;
+                if (fstat(file, &status) == 0 && status.st_size > 0)
+                {
+                    void * data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+                    if (data != MAP_FAILED)
+                    {
+                        m_data = static_cast<const uint8_t *>(data);
+                        m_size = static_cast<size_t>(status.st_size);
+                    }
+                }
+                close(file);
+            #endif
+            }
+
+            ~MappedFile()
+            {
+            #if defined(GUISE_PLATFORM_WINDOWS)
+                if (m_data)
+                {
+                    UnmapViewOfFile(m_data);
+                }
+                if (m_mapping != NULL)
+                {
+                    CloseHandle(m_mapping);
+                }
+                if (m_file != INVALID_HANDLE_VALUE)
+                {
+                    CloseHandle(m_file);
+                }
+            #elif defined(GUISE_PLATFORM_LINUX)
+                if (m_data)
+                {
+                    munmap(const_cast<uint8_t *>(m_data), m_size);
+                }
+            #endif
+            }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile & operator = (const MappedFile &) = delete;
+
+            const uint8_t * getData() const
+            {
+                return m_data;
+            }
+
+            size_t getSize() const
+            {
+                return m_size;
+            }
+
+        private:
+
+        #if defined(GUISE_PLATFORM_WINDOWS)
+            HANDLE          m_file;
+            HANDLE          m_mapping;
+        #endif
+            const uint8_t * m_data;
+            size_t          m_size;
+
+        };
+
+
+        std::shared_ptr<Sheet> Sheet::loadBinary(const std::string & filename, std::string * error)
+        {
+            MappedFile file(filename);
+            if (!file.getData())
+            {
+                setError(error, "failed to map \"" + filename + "\"");
+                return nullptr;
+            }
+            return loadBinary(file.getData(), file.getSize(), error);
+        }
+
+        std::shared_ptr<Sheet> Sheet::loadBinary(const void * data, const size_t size, std::string * error)
+        {
+            auto sheet = std::shared_ptr<Sheet>(new Sheet());
+            SheetBinaryReader reader(static_cast<const uint8_t *>(data), size);
+            if (!reader.read(*sheet, error))
+            {
+                return nullptr;
+            }
+            return sheet;
+        }
+
+        std::vector<uint8_t> Sheet::saveBinary() const
+        {
+            SheetBinaryWriter writer;
+            return writer.write(m_selectors);
+        }
+
+        bool Sheet::saveBinary(const std::string & filename, std::string * error) const
+        {
+            auto data = saveBinary();
+
+            std::ofstream file(filename, std::ofstream::binary | std::ofstream::trunc);
+            if (!file.is_open())
+            {
+                return setError(error, "failed to open \"" + filename + "\"");
+            }
+            file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file.good())
+            {
+                return setError(error, "failed to write \"" + filename + "\"");
+            }
+            return true;
+        }
+
+    }
+
+}
@@ -0,0 +1,647 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/style.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+/*
+* Style sheet syntax:
+*
+*   // Line comment, block comments are also supported.
+*   button, checkbox:hover {
+*       background-color: 0.25 0.25 0.25 1.0;   // 1-4 numbers: Float, Vector2f, Vector3f or Vector4f.
+*       border-color: #0d0d0dff;                // #rgb, #rrggbb or #rrggbbaa: Vector4f.
+*       border-style: solid;                    // Keywords of border-style, overflow and the align properties.
+*       size: fit-parent 20;                    // Numbers or fit-parent, fit-content, fit-content-and-parent.
+*       font-family: "DejaVu Sans";             // Quoted or unquoted text: String.
+*       font-size: 12;                          // font-size is an Integer.
+*       background-gradient: 90 #fff #000;      // Optional angle in degrees and two colors: LinearGradient.
+*   }
+*
+* Repeated selectors and properties are merged, later values win.
+* Property names and selectors with pseudo-states, such as button:hover, must be known.
+* Other selector names are custom selectors, interned once the whole text is parsed.
+*/
+
+namespace Guise
+{
+
+    namespace Style
+    {
+
+        class SheetParser
+        {
+
+        public:
+
+            SheetParser(const std::string & text) :
+                m_text(text),
+                m_position(0),
+                m_line(1)
+            { }
+
+            bool parse(Sheet & sheet)
+            {
+                // Rules are merged after parsing all of them, names of texts with errors are never interned.
+                std::vector<std::pair<std::vector<std::string>, Selector> > rules;
+                while (skipWhitespace())
+                {
+                    std::vector<std::string> names;
+                    if (!parseSelectors(names))
+                    {
+                        return false;
+                    }
+
+                    Selector selector;
+                    if (!parseBlock(selector))
+                    {
+                        return false;
+                    }
+                    rules.push_back({ names, selector });
+                }
+                if (!m_error.empty())
+                {
+                    return false;
+                }
+
+                for (auto & rule : rules)
+                {
+                    for (auto & name : rule.first)
+                    {
+                        auto & target = sheet.getOrAddSelector(internSelectorId(name));
+                        for (auto & property : rule.second.getProperties())
+                        {
+                            target.setProperty(property.first, property.second);
+                        }
+                    }
+                }
+                return true;
+            }
+
+            const std::string & getError() const
+            {
+                return m_error;
+            }
+
+        private:
+
+            bool fail(const std::string & message)
+            {
+                // Keep the first error, an unterminated comment also ends the text for the callers.
+                if (m_error.empty())
+                {
+                    m_error = "line " + std::to_string(m_line) + ": " + message;
+                }
+                return false;
+            }
+
+            char peek() const
+            {
+                return m_position < m_text.size() ? m_text[m_position] : '\0';
+            }
+
+            char next()
+            {
+                const char c = m_text[m_position++];
+                if (c == '\n')
+                {
+                    m_line++;
+                }
+                return c;
+            }
+
+            // Skip whitespace and comments, returns false at the end of the text or of an unterminated comment.
+            bool skipWhitespace()
+            {
+                while (m_position < m_text.size())
+                {
+                    const char c = peek();
+                    if (std::isspace(static_cast<unsigned char>(c)))
+                    {
+                        next();
+                    }
+                    else if (c == '/' && m_position + 1 < m_text.size() && m_text[m_position + 1] == '/')
+                    {
+                        while (m_position < m_text.size() && peek() != '\n')
+                        {
+                            next();
+                        }
+                    }
+                    else if (c == '/' && m_position + 1 < m_text.size() && m_text[m_position + 1] == '*')
+                    {
+                        const size_t line = m_line;
+                        next();
+                        next();
+                        while (m_position < m_text.size() && !(peek() == '*' && m_position + 1 < m_text.size() && m_text[m_position + 1] == '/'))
+                        {
+                            next();
+                        }
+                        if (m_position >= m_text.size())
+                        {
+                            // Report the line the comment starts at.
+                            m_line = line;
+                            return fail("unterminated comment");
+                        }
+                        next();
+                        next();
+                    }
+                    else
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            static bool isNameCharacter(const char c)
+            {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == ':';
+            }
+
+            std::string parseName()
+            {
+                const size_t start = m_position;
+                while (isNameCharacter(peek()))
+                {
+                    next();
+                }
+                return m_text.substr(start, m_position - start);
+            }
+
+            // Custom selector names are identifiers, names with pseudo-states must be known selectors.
+            static bool isValidSelectorName(const std::string & name)
+            {
+                SelectorId id;
+                if (name.find(':') != std::string::npos)
+                {
+                    return findSelectorId(name, id);
+                }
+                return std::isalpha(static_cast<unsigned char>(name[0])) != 0;
+            }
+
+            bool parseSelectors(std::vector<std::string> & names)
+            {
+                while (true)
+                {
+                    skipWhitespace();
+                    const std::string name = parseName();
+                    if (name.empty())
+                    {
+                        return fail("expected selector name");
+                    }
+                    if (!isValidSelectorName(name))
+                    {
+                        return fail("unknown selector \"" + name + "\"");
+                    }
+                    names.push_back(name);
+
+                    skipWhitespace();
+                    if (peek() == '{')
+                    {
+                        next();
+                        return true;
+                    }
+                    if (peek() != ',')
+                    {
+                        return fail("expected ',' or '{' after selector \"" + name + "\"");
+                    }
+                    next();
+                }
+            }
+
+            bool parseBlock(Selector & selector)
+            {
+                while (true)
+                {
+                    if (!skipWhitespace())
+                    {
+                        return fail("unexpected end of text, expected '}'");
+                    }
+                    if (peek() == '}')
+                    {
+                        next();
+                        return true;
+                    }
+
+                    // Property name, allowing ':' only as separator.
+                    const size_t start = m_position;
+                    while (isNameCharacter(peek()) && peek() != ':')
+                    {
+                        next();
+                    }
+                    const std::string name = m_text.substr(start, m_position - start);
+                    if (name.empty())
+                    {
+                        return fail("expected property name");
+                    }
+                    PropertyId id;
+                    if (!findPropertyId(name, id))
+                    {
+                        return fail("unknown property \"" + name + "\"");
+                    }
+
+                    skipWhitespace();
+                    if (peek() != ':')
+                    {
+                        return fail("expected ':' after property \"" + name + "\"");
+                    }
+                    next();
+
+                    std::vector<std::string> values;
+                    std::vector<bool> quoted;
+                    if (!parseValues(values, quoted))
+                    {
+                        return false;
+                    }
+
+                    Property property(false);
+                    if (!toProperty(id, values, quoted, property))
+                    {
+                        return false;
+                    }
+                    selector.setProperty(id, property);
+                }
+            }
+
+            bool parseValues(std::vector<std::string> & values, std::vector<bool> & quoted)
+            {
+                while (true)
+                {
+                    if (!skipWhitespace())
+                    {
+                        return fail("unexpected end of text, expected ';'");
+                    }
+
+                    const char c = peek();
+                    if (c == ';')
+                    {
+                        next();
+                        break;
+                    }
+                    if (c == '}')
+                    {
+                        break;
+                    }
+
+                    if (c == '"' || c == '\'')
+                    {
+                        next();
+                        std::string value;
+                        while (m_position < m_text.size() && peek() != c && peek() != '\n')
+                        {
+                            value.push_back(next());
+                        }
+                        if (peek() != c)
+                        {
+                            return fail("unterminated string");
+                        }
+                        next();
+                        values.push_back(value);
+                        quoted.push_back(true);
+                        continue;
+                    }
+
+                    const size_t start = m_position;
+                    while (m_position < m_text.size() && !std::isspace(static_cast<unsigned char>(peek())) &&
+                           peek() != ';' && peek() != '}' && peek() != '"' && peek() != '\'')
+                    {
+                        next();
+                    }
+                    values.push_back(m_text.substr(start, m_position - start));
+                    quoted.push_back(false);
+                }
+
+                if (values.empty())
+                {
+                    return fail("expected property value");
+                }
+                return true;
+            }
+
+            static bool toFloat(const std::string & string, float & value)
+            {
+                char * end = nullptr;
+                value = std::strtof(string.c_str(), &end);
+                return end != string.c_str() && *end == '\0';
+            }
+
+            static bool toColor(const std::string & string, Vector4f & color)
+            {
+                if (string.empty() || string[0] != '#')
+                {
+                    return false;
+                }
+
+                const std::string hex = string.substr(1);
+                for (auto c : hex)
+                {
+                    if (!std::isxdigit(static_cast<unsigned char>(c)))
+                    {
+                        return false;
+                    }
+                }
+
+                const size_t digits = hex.size() == 3 ? 1 : 2;
+                if (hex.size() != 3 && hex.size() != 6 && hex.size() != 8)
+                {
+                    return false;
+                }
+
+                float components[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+                for (size_t i = 0; i < hex.size() / digits; i++)
+                {
+                    unsigned long value = std::strtoul(hex.substr(i * digits, digits).c_str(), nullptr, 16);
+                    components[i] = digits == 1 ? static_cast<float>(value * 17) / 255.0f : static_cast<float>(value) / 255.0f;
+                }
+                color = { components[0], components[1], components[2], components[3] };
+                return true;
+            }
+
+            static bool toFit(const std::string & string, Size::Fit & fit)
+            {
+                if (string == "fit-parent")
+                {
+                    fit = Size::FitParent;
+                }
+                else if (string == "fit-content")
+                {
+                    fit = Size::FitContent;
+                }
+                else if (string == "fit-content-and-parent")
+                {
+                    fit = Size::FitContentAndParent;
+                }
+                else
+                {
+                    return false;
+                }
+                return true;
+            }
+
+            bool toKeyword(const PropertyId id, const std::string & value, Property & property)
+            {
+                switch (id)
+                {
+                    case PropertyId::BorderStyle:
+                    {
+                        if (value == "none") { property = Property::BorderStyle::None; return true; }
+                        if (value == "solid") { property = Property::BorderStyle::Solid; return true; }
+                    }
+                    break;
+                    case PropertyId::Overflow:
+                    {
+                        if (value == "hidden") { property = Property::Overflow::Hidden; return true; }
+                        if (value == "visible") { property = Property::Overflow::Visible; return true; }
+                    }
+                    break;
+                    case PropertyId::HorizontalAlign:
+                    {
+                        if (value == "left") { property = Property::HorizontalAlign::Left; return true; }
+                        if (value == "center") { property = Property::HorizontalAlign::Center; return true; }
+                        if (value == "right") { property = Property::HorizontalAlign::Right; return true; }
+                    }
+                    break;
+                    case PropertyId::VerticalAlign:
+                    {
+                        if (value == "top") { property = Property::VerticalAlign::Top; return true; }
+                        if (value == "center") { property = Property::VerticalAlign::Center; return true; }
+                        if (value == "bottom") { property = Property::VerticalAlign::Bottom; return true; }
+                    }
+                    break;
+                    default: return false;
+                }
+                return fail("invalid value \"" + value + "\" of property \"" + getPropertyName(id) + "\"");
+            }
+
+            bool toLinearGradient(const std::vector<std::string> & values, Property & property)
+            {
+                const std::string & name = getPropertyName(PropertyId::BackgroundGradient);
+                if (values.size() != 2 && values.size() != 3)
+                {
+                    return fail("expected optional angle and two colors of property \"" + name + "\"");
+                }
+
+                float angle = 0.0f;
+                if (values.size() == 3 && !toFloat(values[0], angle))
+                {
+                    return fail("invalid angle \"" + values[0] + "\" of property \"" + name + "\"");
+                }
+
+                Vector4f colors[2];
+                for (size_t i = 0; i < 2; i++)
+                {
+                    const std::string & value = values[values.size() - 2 + i];
+                    if (!toColor(value, colors[i]))
+                    {
+                        return fail("invalid color \"" + value + "\" of property \"" + name + "\"");
+                    }
+                }
+
+                property = LinearGradient(angle, colors[0], colors[1]);
+                return true;
+            }
+
+            bool toProperty(const PropertyId id, const std::vector<std::string> & values, const std::vector<bool> & quoted, Property & property)
+            {
+                const std::string & name = getPropertyName(id);
+
+                if (quoted[0] || id == PropertyId::FontFamily)
+                {
+                    std::string text = values[0];
+                    for (size_t i = 1; i < values.size(); i++)
+                    {
+                        text += " " + values[i];
+                    }
+                    property = text;
+                    return true;
+                }
+
+                if (id == PropertyId::BackgroundGradient)
+                {
+                    return toLinearGradient(values, property);
+                }
+
+                if (values.size() == 1)
+                {
+                    const std::string & value = values[0];
+                    Vector4f color;
+                    float number = 0.0f;
+
+                    if (id == PropertyId::FontSize)
+                    {
+                        if (!toFloat(value, number))
+                        {
+                            return fail("expected integer value of property \"" + name + "\"");
+                        }
+                        property = static_cast<int>(number);
+                        return true;
+                    }
+                    if (toColor(value, color))
+                    {
+                        property = color;
+                        return true;
+                    }
+                    if (toFloat(value, number))
+                    {
+                        property = number;
+                        return true;
+                    }
+                    if (value == "true" || value == "false")
+                    {
+                        property = value == "true";
+                        return true;
+                    }
+                    if (toKeyword(id, value, property))
+                    {
+                        return true;
+                    }
+                    if (!m_error.empty())
+                    {
+                        return false;
+                    }
+                    if (id == PropertyId::Size)
+                    {
+                        Size::Fit fit;
+                        if (toFit(value, fit))
+                        {
+                            property.setSize(Size(fit, fit));
+                            return true;
+                        }
+                    }
+                    if (static_cast<size_t>(id) < static_cast<size_t>(PropertyId::Count))
+                    {
+                        return fail("invalid value \"" + value + "\" of property \"" + name + "\"");
+                    }
+                    property = value;
+                    return true;
+                }
+
+                if (id == PropertyId::Size && values.size() == 2)
+                {
+                    float numbers[2];
+                    Size::Fit fits[2];
+                    bool isNumber[2];
+                    for (size_t i = 0; i < 2; i++)
+                    {
+                        isNumber[i] = toFloat(values[i], numbers[i]);
+                        if (!isNumber[i] && !toFit(values[i], fits[i]))
+                        {
+                            return fail("invalid value \"" + values[i] + "\" of property \"" + name + "\"");
+                        }
+                    }
+
+                    if (isNumber[0] && isNumber[1])
+                    {
+                        property = Vector2f{ numbers[0], numbers[1] };
+                    }
+                    else if (isNumber[0])
+                    {
+                        property.setSize(Size(numbers[0], fits[1]));
+                    }
+                    else if (isNumber[1])
+                    {
+                        property.setSize(Size(fits[0], numbers[1]));
+                    }
+                    else
+                    {
+                        property.setSize(Size(fits[0], fits[1]));
+                    }
+                    return true;
+                }
+
+                if (values.size() > 4)
+                {
+                    return fail("too many values of property \"" + name + "\"");
+                }
+
+                float numbers[4];
+                for (size_t i = 0; i < values.size(); i++)
+                {
+                    if (!toFloat(values[i], numbers[i]))
+                    {
+                        return fail("invalid value \"" + values[i] + "\" of property \"" + name + "\"");
+                    }
+                }
+
+                switch (values.size())
+                {
+                    case 2: property = Vector2f{ numbers[0], numbers[1] }; break;
+                    case 3: property = Vector3f{ numbers[0], numbers[1], numbers[2] }; break;
+                    default: property = Vector4f{ numbers[0], numbers[1], numbers[2], numbers[3] }; break;
+                }
+                return true;
+            }
+
+            const std::string & m_text;
+            size_t              m_position;
+            size_t              m_line;
+            std::string         m_error;
+
+        };
+
+
+        std::shared_ptr<Sheet> Sheet::parse(const std::string & text, std::string * error, const Sheet * base)
+        {
+            auto sheet = std::shared_ptr<Sheet>(new Sheet());
+            if (base)
+            {
+                sheet->m_selectors = base->m_selectors;
+            }
+
+            SheetParser parser(text);
+            if (!parser.parse(*sheet))
+            {
+                if (error)
+                {
+                    *error = parser.getError();
+                }
+                return nullptr;
+            }
+            return sheet;
+        }
+
+        std::shared_ptr<Sheet> Sheet::load(const std::string & filename, std::string * error, const Sheet * base)
+        {
+            std::ifstream file(filename, std::ifstream::binary);
+            if (!file.is_open())
+            {
+                if (error)
+                {
+                    *error = "failed to open \"" + filename + "\"";
+                }
+                return nullptr;
+            }
+
+            std::stringstream stream;
+            stream << file.rdbuf();
+            return parse(stream.str(), error, base);
+        }
+
+    }
+
+}
@@ -0,0 +1,254 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/utility/bitmap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// AVX2 functions are compiled for AVX2 regardless of the compiler flags and selected at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GUISE_BITMAP_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GUISE_BITMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Guise
+{
+
+    namespace Bitmap
+    {
+
+    #if defined(GUISE_BITMAP_AVX2)
+        static bool hasAvx2()
+        {
+            static const bool supported = []()
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") != 0;
+            }();
+            return supported;
+        }
+
+        // Returns the number of processed bytes, a multiple of 32.
+        __attribute__((target("avx2")))
+        static size_t maxRowAvx2(uint8_t * destination, const uint8_t * source, const size_t count)
+        {
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                const __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+                const __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_max_epu8(dst, src));
+            }
+            return i;
+        }
+    #endif
+
+        void maxRow(uint8_t * destination, const uint8_t * source, const size_t count)
+        {
+            size_t i = 0;
+
+        #if defined(GUISE_BITMAP_AVX2)
+            if (count >= 32 && hasAvx2())
+            {
+                i = maxRowAvx2(destination, source, count);
+            }
+        #endif
+
+        #if defined(GUISE_BITMAP_SSE2)
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+                const __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_max_epu8(dst, src));
+            }
+        #endif
+
+            maxRowScalar(destination + i, source + i, count - i);
+        }
+
+        void expandAlphaToRgba(uint8_t * destination, const uint8_t * source, const size_t count)
+        {
+            size_t i = 0;
+
+        #if defined(GUISE_BITMAP_SSE2)
+            // Interleave 0xFF bytes with alpha values, twice, to get FF FF FF A per pixel.
+            const __m128i white = _mm_set1_epi8(static_cast<char>(0xFF));
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+                const __m128i low = _mm_unpacklo_epi8(white, alpha);
+                const __m128i high = _mm_unpackhi_epi8(white, alpha);
+
+                __m128i * output = reinterpret_cast<__m128i *>(destination + (i * 4));
+                _mm_storeu_si128(output + 0, _mm_unpacklo_epi16(white, low));
+                _mm_storeu_si128(output + 1, _mm_unpackhi_epi16(white, low));
+                _mm_storeu_si128(output + 2, _mm_unpacklo_epi16(white, high));
+                _mm_storeu_si128(output + 3, _mm_unpackhi_epi16(white, high));
+            }
+        #endif
+
+            expandAlphaToRgbaScalar(destination + (i * 4), source + i, count - i);
+        }
+
+        static const float g_distanceInfinity = 1e20f;
+
+        // One dimensional squared euclidean distance transform, Felzenszwalb and Huttenlocher.
+        static void distanceTransform1d(float * data, const size_t count, const size_t stride,
+                                        std::vector<float> & values, std::vector<int32_t> & hulls, std::vector<float> & ranges)
+        {
+            values.resize(count);
+            hulls.resize(count);
+            ranges.resize(count + 1);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = data[i * stride];
+            }
+
+            auto intersection = [&values](const int32_t q, const int32_t p)
+            {
+                return ((values[q] + static_cast<float>(q * q)) - (values[p] + static_cast<float>(p * p))) / static_cast<float>(2 * (q - p));
+            };
+
+            int32_t k = 0;
+            hulls[0] = 0;
+            ranges[0] = -std::numeric_limits<float>::infinity();
+            ranges[1] = std::numeric_limits<float>::infinity();
+
+            for (int32_t q = 1; q < static_cast<int32_t>(count); q++)
+            {
+                float s = intersection(q, hulls[k]);
+                while (s <= ranges[k])
+                {
+                    k--;
+                    s = intersection(q, hulls[k]);
+                }
+
+                k++;
+                hulls[k] = q;
+                ranges[k] = s;
+                ranges[k + 1] = std::numeric_limits<float>::infinity();
+            }
+
+            k = 0;
+            for (int32_t q = 0; q < static_cast<int32_t>(count); q++)
+            {
+                while (ranges[k + 1] < static_cast<float>(q))
+                {
+                    k++;
+                }
+
+                const float distance = static_cast<float>(q - hulls[k]);
+                data[q * stride] = (distance * distance) + values[hulls[k]];
+            }
+        }
+
+        static void distanceTransform2d(std::vector<float> & grid, const size_t width, const size_t height)
+        {
+            std::vector<float> values;
+            std::vector<int32_t> hulls;
+            std::vector<float> ranges;
+
+            for (size_t x = 0; x < width; x++)
+            {
+                distanceTransform1d(grid.data() + x, height, width, values, hulls, ranges);
+            }
+            for (size_t y = 0; y < height; y++)
+            {
+                distanceTransform1d(grid.data() + (y * width), width, 1, values, hulls, ranges);
+            }
+        }
+
+        void createDistanceField(uint8_t * destination, const uint8_t * source,
+                                 const size_t width, const size_t height, const size_t pitch, const size_t spread)
+        {
+            const size_t outWidth = width + (2 * spread);
+            const size_t outHeight = height + (2 * spread);
+            const size_t outCount = outWidth * outHeight;
+            const float infinity = g_distanceInfinity;
+
+            // Distance to nearest inside pixel, and distance to nearest outside pixel.
+            std::vector<float> outside(outCount, infinity);
+            std::vector<float> inside(outCount, 0.0f);
+            for (size_t y = 0; y < height; y++)
+            {
+                const uint8_t * row = source + (y * pitch);
+                for (size_t x = 0; x < width; x++)
+                {
+                    if (row[x] >= 128)
+                    {
+                        const size_t index = ((y + spread) * outWidth) + x + spread;
+                        outside[index] = 0.0f;
+                        inside[index] = infinity;
+                    }
+                }
+            }
+
+            distanceTransform2d(outside, outWidth, outHeight);
+            distanceTransform2d(inside, outWidth, outHeight);
+
+            const float scale = 127.0f / static_cast<float>(spread ? spread : 1);
+            for (size_t i = 0; i < outCount; i++)
+            {
+                // Pixel centers are half a pixel off the edge between inside and outside.
+                const float distance = inside[i] > 0.0f ?
+                    std::sqrt(inside[i]) - 0.5f :
+                    -(std::sqrt(outside[i]) - 0.5f);
+
+                const float value = 128.0f + (distance * scale);
+                destination[i] = static_cast<uint8_t>(std::min(std::max(value, 0.0f), 255.0f));
+            }
+        }
+
+        void maxRowScalar(uint8_t * destination, const uint8_t * source, const size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                destination[i] = std::max(destination[i], source[i]);
+            }
+        }
+
+        void expandAlphaToRgbaScalar(uint8_t * destination, const uint8_t * source, const size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                uint8_t * pixel = destination + (i * 4);
+                pixel[0] = 255;
+                pixel[1] = 255;
+                pixel[2] = 255;
+                pixel[3] = source[i];
+            }
+        }
+
+    }
+
+}
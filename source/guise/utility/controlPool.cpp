@@ -0,0 +1,156 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/utility/controlPool.hpp"
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace Guise
+{
+
+    namespace
+    {
+
+        static const size_t SizeClassCount = ControlPool::MaxSlotSize / ControlPool::SlotGranularity;
+        static const size_t MinChunkSlots = 16;
+        static const size_t MaxChunkSlots = 1024;
+
+        struct FreeSlot
+        {
+            FreeSlot * next;
+        };
+
+        struct SizeClass
+        {
+            SizeClass() :
+                freeSlots(nullptr),
+                nextChunkSlots(MinChunkSlots)
+            { }
+
+            FreeSlot *  freeSlots;
+            size_t      nextChunkSlots;
+        };
+
+        struct Pool
+        {
+            Pool() :
+                chunkCount(0),
+                chunkBytes(0),
+                usedSlots(0)
+            { }
+
+            std::mutex              mutex;
+            SizeClass               sizeClasses[SizeClassCount];
+            size_t                  chunkCount;
+            size_t                  chunkBytes;
+            size_t                  usedSlots;
+        };
+
+        // Never destroyed, controls may outlive static destruction.
+        static Pool & getPool()
+        {
+            static Pool * pool = new Pool;
+            return *pool;
+        }
+
+        static size_t getSizeClass(const size_t size)
+        {
+            return (size - 1) / ControlPool::SlotGranularity;
+        }
+
+        static void allocateChunk(Pool & pool, SizeClass & sizeClass, const size_t slotSize)
+        {
+            const size_t slotCount = sizeClass.nextChunkSlots;
+            char * chunk = static_cast<char *>(::operator new(slotSize * slotCount, std::align_val_t(ControlPool::SlotGranularity)));
+            pool.chunkCount++;
+            pool.chunkBytes += slotSize * slotCount;
+            sizeClass.nextChunkSlots = std::min(slotCount * 2, MaxChunkSlots);
+
+            // Link slots in address order, consecutive allocations are adjacent in memory.
+            for (size_t i = slotCount; i > 0; i--)
+            {
+                FreeSlot * slot = reinterpret_cast<FreeSlot *>(chunk + ((i - 1) * slotSize));
+                slot->next = sizeClass.freeSlots;
+                sizeClass.freeSlots = slot;
+            }
+        }
+
+    }
+
+    // Control pool implementations.
+    void * ControlPool::allocate(const size_t size)
+    {
+        if (!size || size > MaxSlotSize)
+        {
+            return ::operator new(size);
+        }
+
+        auto & pool = getPool();
+        const size_t index = getSizeClass(size);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        auto & sizeClass = pool.sizeClasses[index];
+        if (!sizeClass.freeSlots)
+        {
+            allocateChunk(pool, sizeClass, (index + 1) * SlotGranularity);
+        }
+
+        FreeSlot * slot = sizeClass.freeSlots;
+        sizeClass.freeSlots = slot->next;
+        pool.usedSlots++;
+        return slot;
+    }
+
+    void ControlPool::deallocate(void * pointer, const size_t size)
+    {
+        if (!pointer)
+        {
+            return;
+        }
+        if (!size || size > MaxSlotSize)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        auto & pool = getPool();
+        auto & sizeClass = pool.sizeClasses[getSizeClass(size)];
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        FreeSlot * slot = static_cast<FreeSlot *>(pointer);
+        slot->next = sizeClass.freeSlots;
+        sizeClass.freeSlots = slot;
+        pool.usedSlots--;
+    }
+
+    ControlPool::Statistics ControlPool::getStatistics()
+    {
+        auto & pool = getPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        return { pool.chunkCount, pool.chunkBytes, pool.usedSlots };
+    }
+
+}
@@ -0,0 +1,119 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/utility/taskQueue.hpp"
+
+namespace Guise
+{
+
+    TaskQueue::Node::Node() :
+        next(nullptr)
+    { }
+
+    TaskQueue::TaskQueue() :
+        m_head(&m_stub),
+        m_tail(&m_stub)
+    { }
+
+    TaskQueue::~TaskQueue()
+    {
+        while (Node * node = popNode())
+        {
+            delete node;
+        }
+    }
+
+    void TaskQueue::push(Task && task)
+    {
+        Node * node = new Node;
+        node->task = std::move(task);
+        pushNode(node);
+    }
+
+    size_t TaskQueue::execute()
+    {
+        size_t count = 0;
+        while (Node * node = popNode())
+        {
+            node->task();
+            delete node;
+            count++;
+        }
+        return count;
+    }
+
+    bool TaskQueue::isEmpty() const
+    {
+        return m_tail == &m_stub && !m_stub.next.load(std::memory_order_acquire);
+    }
+
+    void TaskQueue::pushNode(Node * node)
+    {
+        // Nodes are linked after being published as head, popNode waits for the link of the last node.
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node * previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    TaskQueue::Node * TaskQueue::popNode()
+    {
+        Node * tail = m_tail;
+        Node * next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &m_stub)
+        {
+            if (!next)
+            {
+                return nullptr;
+            }
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+
+        // Tail is the last node, or a producer has not linked its node yet.
+        if (tail != m_head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        // Push the stub behind the last node, so it can be popped.
+        pushNode(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,226 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "guise/utility/threadPool.hpp"
+#include <algorithm>
+
+namespace Guise
+{
+
+    ThreadPool & ThreadPool::getDefault()
+    {
+        // Leaked, tasks may be pushed by threads outliving static destruction.
+        static ThreadPool * pool = new ThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return *pool;
+    }
+
+    ThreadPool::ThreadPool(const size_t workerCount) :
+        m_queueCount(std::max(workerCount, size_t(1))),
+        m_queues(new Queue[m_queueCount]),
+        m_nextQueue(0),
+        m_pendingTasks(0),
+        m_stopping(false)
+    {
+        m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; i++)
+        {
+            m_workers.push_back(std::thread([this, i]()
+            {
+                work(i);
+            }));
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wakeCondition.notify_all();
+
+        for (auto & worker : m_workers)
+        {
+            worker.join();
+        }
+
+        // Tasks pushed to a pool without workers.
+        Task task;
+        while (popTask(0, task))
+        {
+            task();
+        }
+    }
+
+    size_t ThreadPool::getWorkerCount() const
+    {
+        return m_workers.size();
+    }
+
+    void ThreadPool::push(Task && task)
+    {
+        pushTask(std::move(task));
+        wakeWorkers(1);
+    }
+
+    void ThreadPool::run(const size_t count, const size_t grainSize, RangeFunction rangeFunction, const void * function)
+    {
+        const size_t grain = std::max(grainSize, size_t(1));
+        if (m_workers.empty() || count <= grain)
+        {
+            rangeFunction(function, 0, count);
+            return;
+        }
+
+        struct Batch
+        {
+            std::atomic<size_t> remaining;
+            RangeFunction       rangeFunction;
+            const void *        function;
+        };
+
+        // The first range is executed by the calling thread, the others are pushed to the workers.
+        const size_t rangeCount = (count + grain - 1) / grain;
+        Batch batch;
+        batch.remaining = rangeCount - 1;
+        batch.rangeFunction = rangeFunction;
+        batch.function = function;
+
+        for (size_t from = grain; from < count; from += grain)
+        {
+            const size_t to = std::min(from + grain, count);
+            pushTask([&batch, from, to]()
+            {
+                batch.rangeFunction(batch.function, from, to);
+                batch.remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        wakeWorkers(rangeCount - 1);
+
+        rangeFunction(function, 0, grain);
+
+        // Help out until the last range is finished, possibly executing tasks of other batches.
+        Task task;
+        while (batch.remaining.load(std::memory_order_acquire))
+        {
+            if (popTask(0, task))
+            {
+                task();
+                task.reset();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void ThreadPool::pushTask(Task && task)
+    {
+        Queue & queue = m_queues[m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queueCount];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+        m_pendingTasks.fetch_add(1, std::memory_order_release);
+    }
+
+    void ThreadPool::wakeWorkers(const size_t count)
+    {
+        // Sleeping workers check for pending tasks while holding the sleep mutex, no wake up is lost.
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+
+        if (count == 1)
+        {
+            m_wakeCondition.notify_one();
+        }
+        else if (count > 1)
+        {
+            m_wakeCondition.notify_all();
+        }
+    }
+
+    void ThreadPool::work(const size_t index)
+    {
+        Task task;
+        while (true)
+        {
+            if (popTask(index, task))
+            {
+                task();
+                task.reset();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wakeCondition.wait(lock, [this]()
+            {
+                return m_stopping || m_pendingTasks.load(std::memory_order_acquire);
+            });
+
+            if (m_stopping && !m_pendingTasks.load(std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::popTask(const size_t index, Task & task)
+    {
+        if (!m_pendingTasks.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        {
+            Queue & queue = m_queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                m_pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < m_queueCount; i++)
+        {
+            Queue & queue = m_queues[(index + i) % m_queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                m_pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+}
@@ -0,0 +1,157 @@
+#include "test.hpp"
+#include "guise/animation.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/button.hpp"
+
+using namespace Guise;
+
+TEST(Animation, FrameClock)
+{
+    FrameClock clock;
+    EXPECT_EQ(clock.getFrame(), uint64_t(0));
+
+    clock.tick(0.5);
+    clock.tick(0.75);
+    EXPECT_DOUBLE_EQ(clock.getTime(), 0.75);
+    EXPECT_DOUBLE_EQ(clock.getDeltaTime(), 0.25);
+    EXPECT_EQ(clock.getFrame(), uint64_t(2));
+
+    // Time never runs backwards.
+    clock.tick(0.5);
+    EXPECT_DOUBLE_EQ(clock.getTime(), 0.75);
+    EXPECT_DOUBLE_EQ(clock.getDeltaTime(), 0.0);
+}
+
+TEST(Animation, Tweens)
+{
+    auto button = Button::create();
+    Animator animator;
+
+    float value1 = 0.0f;
+    float value2 = 10.0f;
+    animator.animate(*button, value1, 1.0f, 1.0, Easing::Linear);
+    animator.animate(*button, value2, 20.0f, 2.0, Easing::Linear);
+    EXPECT_TRUE(animator.isActive());
+    EXPECT_EQ(animator.getTweenCount(), size_t(2));
+    EXPECT_FLOAT_EQ(animator.getTarget(value1), 1.0f);
+
+    EXPECT_TRUE(animator.update(0.5));
+    EXPECT_FLOAT_EQ(value1, 0.5f);
+    EXPECT_FLOAT_EQ(value2, 12.5f);
+
+    // Finished tweens are set to their target and removed.
+    EXPECT_TRUE(animator.update(1.0));
+    EXPECT_FLOAT_EQ(value1, 1.0f);
+    EXPECT_EQ(animator.getTweenCount(), size_t(1));
+    EXPECT_FLOAT_EQ(animator.getTarget(value1), 1.0f);
+
+    // Replacing a tween starts from the current value.
+    animator.animate(*button, value2, 0.0f, 1.0, Easing::Linear);
+    EXPECT_EQ(animator.getTweenCount(), size_t(1));
+    animator.update(1.5);
+    EXPECT_FLOAT_EQ(value2, 7.5f);
+
+    animator.cancel(button.get());
+    EXPECT_FALSE(animator.isActive());
+    EXPECT_FALSE(animator.update(3.0));
+    EXPECT_FLOAT_EQ(value2, 7.5f);
+}
+
+TEST(Animation, StyleProperty)
+{
+    auto button = Button::create();
+    Animator animator;
+
+    EXPECT_TRUE(animator.animate(*button, static_cast<Style::PaintRectStyle &>(*button), Style::PropertyId::BackgroundColor,
+                                 Vector4f{ 1.0f, 1.0f, 1.0f, 1.0f }, 1.0, Easing::Linear));
+    EXPECT_EQ(animator.getTweenCount(), size_t(4));
+    EXPECT_FALSE(animator.animate(*button, static_cast<Style::PaintRectStyle &>(*button), Style::PropertyId::BackgroundColor,
+                                  1.0f, 1.0, Easing::Linear));
+    EXPECT_FALSE(animator.animate(*button, static_cast<Style::PaintRectStyle &>(*button), Style::PropertyId::Overflow,
+                                  1.0f, 1.0, Easing::Linear));
+
+    animator.update(1.0);
+    EXPECT_EQ(button->getBackgroundColor(), Vector4f(1.0f, 1.0f, 1.0f, 1.0f));
+
+    // Values animated to new targets keep their copy of the block.
+    const size_t blockCount = Style::getBlockStatistics().count;
+    EXPECT_TRUE(animator.animate(*button, static_cast<Style::PaintRectStyle &>(*button), Style::PropertyId::BorderWidth,
+                                 2.0f, 1.0, Easing::Linear));
+    animator.update(2.0);
+    EXPECT_EQ(button->getBorderWidth(), 2.0f);
+    EXPECT_EQ(Style::getBlockStatistics().count, blockCount);
+}
+
+TEST(Animation, StyleBlockReplaced)
+{
+    auto button = Button::create();
+    auto & style = static_cast<Style::PaintRectStyle &>(*button);
+    Animator animator;
+    const Vector4f white = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    // Copies share the animated block, tweens keep animating the style they were started for.
+    ASSERT_TRUE(animator.animate(*button, style, Style::PropertyId::BackgroundColor, white, 1.0, Easing::Linear));
+    Style::PaintRectStyle copy = style;
+    const Vector4f copyColor = copy.getBackgroundColor();
+    {
+        Style::PaintRectStyle destroyed = style;
+    }
+    button->setBorderWidth(3.0f);
+    animator.update(1.0);
+    EXPECT_EQ(button->getBackgroundColor(), white);
+    EXPECT_EQ(copy.getBackgroundColor(), copyColor);
+    EXPECT_EQ(button->getBorderWidth(), 3.0f);
+
+    // Emptied properties stop animating.
+    ASSERT_TRUE(animator.animate(*button, style, Style::PropertyId::BorderColor, white, 1.0, Easing::Linear));
+    EXPECT_EQ(animator.getTweenCount(), size_t(4));
+    button->resetSheetProperties();
+    animator.update(1.5);
+    EXPECT_FALSE(animator.isActive());
+    EXPECT_EQ(button->getBorderWidth(), 3.0f);
+}
+
+TEST(Animation, StyleTransition)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button = Button::create();
+    button->setSize({ 100.0f, 30.0f });
+    plane->add(button);
+    button->setBounds({ { 0.0f, 0.0f }, { 400.0f, 300.0f } });
+
+    auto & animator = canvas->getAnimator();
+    const Vector4f normalColor = button->getBackgroundColor();
+    const Vector4f hoverColor = button->getStyleHover().getBackgroundColor();
+    ASSERT_NE(normalColor, hoverColor);
+    ASSERT_GT(button->getStyleHover().getTransitionDuration(), 0.0f);
+
+    // Switching state starts from the previous color.
+    const size_t blockCount = Style::getBlockStatistics().count;
+    const Vector2f inside = button->getBounds().position + Vector2f(5.0f, 5.0f);
+    button->handleInputEvent(Input::Event(Input::EventType::MouseMove, inside));
+    EXPECT_EQ(&button->getCurrentStyle(), &button->getStyleHover());
+    EXPECT_EQ(button->getStyleHover().getBackgroundColor(), normalColor);
+    EXPECT_TRUE(animator.isActive());
+    EXPECT_TRUE(canvas->needsRender());
+
+    animator.update(button->getStyleHover().getTransitionDuration() * 0.5);
+    const Vector4f halfColor = button->getStyleHover().getBackgroundColor();
+    EXPECT_NE(halfColor, normalColor);
+    EXPECT_NE(halfColor, hoverColor);
+
+    animator.update(1.0);
+    EXPECT_FALSE(animator.isActive());
+    EXPECT_EQ(button->getStyleHover().getBackgroundColor(), hoverColor);
+
+    // Finished transitions share the block of the selector again.
+    EXPECT_EQ(Style::getBlockStatistics().count, blockCount);
+
+    // Removed controls stop animating.
+    const Vector2f outside = button->getBounds().position + button->getBounds().size + Vector2f(5.0f, 5.0f);
+    button->handleInputEvent(Input::Event(Input::EventType::MouseMove, outside));
+    EXPECT_TRUE(animator.isActive());
+    plane->remove(button);
+    EXPECT_FALSE(animator.isActive());
+}
@@ -0,0 +1,80 @@
+#include "test.hpp"
+#include "guise/utility/bitmap.hpp"
+#include <vector>
+
+using namespace Guise;
+
+TEST(Bitmap, MaxRow)
+{
+    // Odd sizes exercise both the vectorized body and the scalar tail.
+    for (size_t count : { 0, 1, 15, 16, 17, 31, 32, 33, 100, 257 })
+    {
+        std::vector<uint8_t> source(count);
+        std::vector<uint8_t> destination(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            source[i] = static_cast<uint8_t>((i * 37) & 0xFF);
+            destination[i] = static_cast<uint8_t>((i * 91 + 13) & 0xFF);
+        }
+
+        std::vector<uint8_t> expected = destination;
+        Bitmap::maxRowScalar(expected.data(), source.data(), count);
+        Bitmap::maxRow(destination.data(), source.data(), count);
+        EXPECT_EQ(destination, expected);
+    }
+}
+
+TEST(Bitmap, ExpandAlphaToRgba)
+{
+    for (size_t count : { 0, 1, 15, 16, 17, 33, 100 })
+    {
+        std::vector<uint8_t> source(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            source[i] = static_cast<uint8_t>((i * 53 + 7) & 0xFF);
+        }
+
+        std::vector<uint8_t> expected(count * 4, 0);
+        std::vector<uint8_t> destination(count * 4, 0);
+        Bitmap::expandAlphaToRgbaScalar(expected.data(), source.data(), count);
+        Bitmap::expandAlphaToRgba(destination.data(), source.data(), count);
+        EXPECT_EQ(destination, expected);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(destination[i * 4 + 0], 255);
+            EXPECT_EQ(destination[i * 4 + 3], source[i]);
+        }
+    }
+}
+
+TEST(Bitmap, DistanceField)
+{
+    // Filled 8x8 square in a 16x16 bitmap.
+    const size_t size = 16;
+    const size_t spread = 4;
+    std::vector<uint8_t> source(size * size, 0);
+    for (size_t y = 4; y < 12; y++)
+    {
+        for (size_t x = 4; x < 12; x++)
+        {
+            source[y * size + x] = 255;
+        }
+    }
+
+    const size_t outSize = size + (2 * spread);
+    std::vector<uint8_t> field(outSize * outSize, 0);
+    Bitmap::createDistanceField(field.data(), source.data(), size, size, size, spread);
+
+    auto at = [&](const size_t x, const size_t y)
+    {
+        return field[(y + spread) * outSize + x + spread];
+    };
+
+    EXPECT_GT(at(8, 8), 230);   // Center, 3.5 pixels inside.
+    EXPECT_GE(at(4, 8), 128);   // Inside edge.
+    EXPECT_LT(at(3, 8), 128);   // Outside edge.
+    EXPECT_EQ(field[0], 0);     // Corner of padding, further outside than spread.
+    EXPECT_LT(at(2, 8), at(3, 8));
+    EXPECT_GT(at(5, 8), at(4, 8));
+}
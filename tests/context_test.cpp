@@ -0,0 +1,37 @@
+// Compiled separately, platform headers of app windows clash with names of other tests using namespace Guise.
+#include "test.hpp"
+#include "guise/context.hpp"
+#include "guise/canvas.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <future>
+
+TEST(Context, AddAppWindowFromLoopThread)
+{
+#if defined(GUISE_PLATFORM_LINUX)
+    // Requires a display, skipped on headless machines.
+    if (!std::getenv("DISPLAY"))
+    {
+        GTEST_SKIP();
+    }
+#endif
+
+    auto context = Guise::Context::create(Guise::Context::Threading::SingleThread);
+    auto appWindow = context->addAppWindow(L"Loop", { 64, 64 });
+    ASSERT_TRUE(appWindow);
+
+    // Window tasks run on the loop thread, calling into the context from there must not wait for the loop.
+    std::promise<std::shared_ptr<Guise::AppWindow> > added;
+    auto addedFuture = added.get_future();
+    appWindow->getCanvas()->getTaskQueue()->push([&]()
+    {
+        context->setMaxFrameTime(appWindow, std::chrono::milliseconds(5));
+        added.set_value(context->addAppWindow(L"Opened", { 64, 64 }));
+    });
+
+    ASSERT_EQ(addedFuture.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_TRUE(addedFuture.get());
+
+    context->stop();
+    EXPECT_FALSE(context->addAppWindow(L"Stopped", { 64, 64 }));
+}
@@ -0,0 +1,323 @@
+#include "test.hpp"
+#include "nullRenderer.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/button.hpp"
+#include "guise/control/verticalGrid.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace Guise;
+
+TEST(Control, VisitChilds)
+{
+    auto grid = VerticalGrid::create();
+    std::vector<std::shared_ptr<Button> > buttons;
+    for (size_t i = 0; i < 5; i++)
+    {
+        buttons.push_back(Button::create());
+        grid->add(buttons.back());
+    }
+
+    std::vector<size_t> indices;
+    grid->visitChilds([&](Control & child, size_t index)
+    {
+        EXPECT_EQ(&child, buttons[index].get());
+        indices.push_back(index);
+    });
+    EXPECT_EQ(indices, std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+
+    // Ranges are clamped, returning false stops the visit.
+    indices.clear();
+    grid->visitChilds(3, 10, [&](const Control &, size_t index) { indices.push_back(index); });
+    EXPECT_EQ(indices, std::vector<size_t>({ 3, 4 }));
+
+    indices.clear();
+    grid->visitChilds([&](Control &, size_t index)
+    {
+        indices.push_back(index);
+        return index < 1;
+    });
+    EXPECT_EQ(indices, std::vector<size_t>({ 0, 1 }));
+
+    // Single child containers visit nothing when empty.
+    auto button = Button::create();
+    size_t count = 0;
+    button->visitChilds([&count](Control &, size_t) { count++; });
+    EXPECT_EQ(count, size_t(0));
+    EXPECT_TRUE(button->getChilds().empty());
+    button->add(Button::create());
+    static_cast<const Button &>(*button).visitChilds([&count](const Control &, size_t) { count++; });
+    EXPECT_EQ(count, size_t(1));
+}
+
+TEST(Control, Pool)
+{
+    const auto before = ControlPool::getStatistics();
+    std::vector<std::shared_ptr<Control> > controls;
+    for (size_t i = 0; i < 100; i++)
+    {
+        controls.push_back(Button::create());
+    }
+    EXPECT_EQ(controls[1]->getType(), ControlType::Button);
+
+#if !defined(GUISE_DISABLE_CONTROL_POOL)
+    // Control and reference count share a slot, chunks hold many controls.
+    auto statistics = ControlPool::getStatistics();
+    EXPECT_EQ(statistics.usedSlots, before.usedSlots + 100);
+    EXPECT_LE(statistics.chunkCount, before.chunkCount + 4);
+
+    // Released slots are reused.
+    controls.clear();
+    EXPECT_EQ(ControlPool::getStatistics().usedSlots, before.usedSlots);
+    controls.push_back(Button::create());
+    EXPECT_EQ(ControlPool::getStatistics().chunkBytes, statistics.chunkBytes);
+#endif
+
+    void * large = ControlPool::allocate(ControlPool::MaxSlotSize + 1);
+    ControlPool::deallocate(large, ControlPool::MaxSlotSize + 1);
+}
+
+TEST(Control, HitTest)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button1 = Button::create();
+    auto button2 = Button::create();
+    plane->add(button1);
+    plane->add(button2);
+    button1->setBounds({ { 10.0f, 10.0f }, { 50.0f, 20.0f } });
+    button2->setBounds({ { 100.0f, 10.0f }, { 50.0f, 20.0f } });
+
+    const Vector2f point1(20.0f, 20.0f);
+    const Vector2f point2(120.0f, 20.0f);
+    EXPECT_EQ(canvas->queryControlHit(point1), button1.get());
+    EXPECT_EQ(canvas->queryControlHit(point2), button2.get());
+    EXPECT_EQ(canvas->queryControlHit({ 200.0f, 200.0f }), plane.get());
+    EXPECT_EQ(canvas->queryControlHit({ 500.0f, 500.0f }), nullptr);
+
+    // Controls without input are skipped, hitting the control below.
+    button1->disableInput();
+    EXPECT_EQ(canvas->queryControlHit(point1), plane.get());
+    button1->enableInput();
+    button1->disable();
+    EXPECT_EQ(canvas->queryControlHit(point1), plane.get());
+    button1->enable();
+    EXPECT_EQ(canvas->queryControlHit(point1), button1.get());
+
+    // The most recently added control of a level is hit first.
+    auto button3 = Button::create();
+    plane->add(button3);
+    button3->setBounds({ { 0.0f, 0.0f }, { 200.0f, 100.0f } });
+    EXPECT_EQ(canvas->queryControlHit(point1), button3.get());
+
+    // Removed and moved controls.
+    plane->remove(button3);
+    plane->remove(button1);
+    EXPECT_EQ(canvas->queryControlHit(point1), plane.get());
+    EXPECT_EQ(canvas->queryControlHit(point2), button2.get());
+    button2->setBounds({ { 1000.0f, 1000.0f }, { 10.0f, 10.0f } });
+    EXPECT_EQ(canvas->queryControlHit(point2), plane.get());
+}
+
+TEST(Control, RenderCulling)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto visible = Button::create();
+    auto hidden = Button::create();
+    auto hiddenChild = Button::create();
+    plane->add(visible);
+    plane->add(hidden);
+    hidden->add(hiddenChild);
+    visible->setBounds({ { 10.0f, 10.0f }, { 50.0f, 20.0f } });
+    hidden->setBounds({ { 1000.0f, 10.0f }, { 50.0f, 20.0f } });
+
+    EXPECT_EQ(plane->getSubtreeSize(), size_t(4));
+    EXPECT_EQ(hidden->getSubtreeSize(), size_t(2));
+    EXPECT_FLOAT_EQ(plane->getSubtreeBounds().size.x, 1050.0f);
+
+    NullRenderer renderer;
+    canvas->render(renderer);
+    EXPECT_EQ(canvas->getRenderStatistics().drawnControls, size_t(2));
+    EXPECT_EQ(canvas->getRenderStatistics().culledControls, size_t(2));
+    EXPECT_EQ(renderer.rectCount, size_t(1));
+
+    // Moving a subtree into the canvas updates the cached bounds of its ancestors.
+    hidden->setBounds({ { 100.0f, 10.0f }, { 50.0f, 20.0f } });
+    EXPECT_FLOAT_EQ(plane->getSubtreeBounds().size.x, 400.0f);
+    canvas->render(renderer);
+    EXPECT_EQ(canvas->getRenderStatistics().drawnControls, size_t(4));
+    EXPECT_EQ(canvas->getRenderStatistics().culledControls, size_t(0));
+
+    hidden->remove(hiddenChild);
+    EXPECT_EQ(plane->getSubtreeSize(), size_t(3));
+}
+
+TEST(Control, RenderDamage)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button1 = Button::create();
+    auto button2 = Button::create();
+    plane->add(button1);
+    plane->add(button2);
+    button1->setBounds({ { 10.0f, 10.0f }, { 50.0f, 20.0f } });
+    button2->setBounds({ { 200.0f, 200.0f }, { 50.0f, 20.0f } });
+
+    // Undefined back buffers are redrawn completely.
+    NullRenderer renderer;
+    canvas->render(renderer);
+    EXPECT_TRUE(renderer.scissors.empty());
+    EXPECT_EQ(canvas->getRenderStatistics().drawnControls, size_t(3));
+
+    // The previous frame is kept, only the damaged control is redrawn.
+    renderer.bufferAge = 1;
+    button1->redraw();
+    canvas->render(renderer);
+    ASSERT_EQ(renderer.scissors.size(), size_t(1));
+    EXPECT_EQ(renderer.scissors.back(), button1->getBounds());
+    EXPECT_EQ(canvas->getRenderStatistics().drawnControls, size_t(2));
+    EXPECT_EQ(canvas->getRenderStatistics().culledControls, size_t(1));
+
+    // Older frames also miss the damage of the frames rendered since.
+    renderer.bufferAge = 2;
+    button2->redraw();
+    canvas->render(renderer);
+    ASSERT_EQ(renderer.scissors.size(), size_t(2));
+    EXPECT_EQ(renderer.scissors.back(), Bounds2f(10.0f, 10.0f, 240.0f, 210.0f));
+    EXPECT_EQ(canvas->getRenderStatistics().drawnControls, size_t(3));
+
+    // Removed controls damage their bounds.
+    renderer.bufferAge = 1;
+    plane->remove(button2);
+    canvas->render(renderer);
+    ASSERT_EQ(renderer.scissors.size(), size_t(3));
+    EXPECT_EQ(renderer.scissors.back(), Bounds2f(200.0f, 200.0f, 50.0f, 20.0f));
+
+    // Frames older than the kept damage are redrawn completely.
+    renderer.bufferAge = 5;
+    button1->redraw();
+    canvas->render(renderer);
+    EXPECT_EQ(renderer.scissors.size(), size_t(3));
+    EXPECT_EQ(canvas->getRenderStatistics().drawnControls, size_t(2));
+}
+
+namespace
+{
+    class PreparedButton : public Button
+    {
+
+    public:
+
+        PreparedButton() :
+            prepareThread(),
+            prepareTime(0),
+            prepared(false),
+            updated(false),
+            preparedBeforeUpdate(false),
+            updateOrder(nullptr)
+        { }
+
+        void requestUpdate()
+        {
+            update();
+        }
+
+        std::thread::id prepareThread;
+        std::chrono::milliseconds prepareTime;
+        bool prepared;
+        bool updated;
+        bool preparedBeforeUpdate;
+        std::vector<const PreparedButton *> * updateOrder;
+
+    private:
+
+        virtual void onPrepareUpdate()
+        {
+            prepareThread = std::this_thread::get_id();
+            prepared = true;
+            std::this_thread::sleep_for(prepareTime);
+        }
+
+        virtual void onUpdate()
+        {
+            updated = true;
+            preparedBeforeUpdate = prepared;
+            if (updateOrder)
+            {
+                updateOrder->push_back(this);
+            }
+        }
+
+    };
+}
+
+TEST(Control, ParallelUpdate)
+{
+    ThreadPool pool(3);
+    auto canvas = Canvas::create({ 400, 300 });
+    canvas->setThreadPool(&pool);
+    EXPECT_EQ(canvas->getThreadPool(), &pool);
+
+    auto plane = Plane::create();
+    canvas->add(plane);
+    std::vector<std::shared_ptr<PreparedButton> > buttons;
+    std::vector<const PreparedButton *> updateOrder;
+    for (size_t i = 0; i < 64; i++)
+    {
+        buttons.push_back(std::make_shared<PreparedButton>());
+        plane->add(buttons.back());
+        buttons.back()->prepareTime = std::chrono::milliseconds(1);
+        buttons.back()->updateOrder = &updateOrder;
+    }
+
+    // Requested in reverse, updates follow the request order rather than addresses.
+    std::vector<const PreparedButton *> requestOrder;
+    for (auto it = buttons.rbegin(); it != buttons.rend(); ++it)
+    {
+        (*it)->requestUpdate();
+        (*it)->requestUpdate();
+        requestOrder.push_back(it->get());
+    }
+
+    // Every control is prepared before being updated on the calling thread.
+    canvas->update();
+    EXPECT_EQ(updateOrder, requestOrder);
+    size_t workerPrepared = 0;
+    for (auto & button : buttons)
+    {
+        EXPECT_TRUE(button->updated);
+        EXPECT_TRUE(button->preparedBeforeUpdate);
+        workerPrepared += button->prepareThread != std::this_thread::get_id() ? 1 : 0;
+    }
+    EXPECT_GT(workerPrepared, size_t(0));
+
+    // Without a pool, controls are prepared by the updating thread.
+    canvas->setThreadPool(nullptr);
+    buttons[0]->requestUpdate();
+    buttons[0]->prepareThread = std::thread::id();
+    canvas->update();
+    EXPECT_EQ(buttons[0]->prepareThread, std::this_thread::get_id());
+}
+
+TEST(Control, RemoveUnselectable)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button = std::make_shared<PreparedButton>();
+    plane->add(button);
+    button->setBounds({ { 1000.0f, 1000.0f }, { 10.0f, 10.0f } });
+    EXPECT_EQ(canvas->queryControlHit({ 1005.0f, 1005.0f }), nullptr);
+
+    // Removed controls outside of the canvas are neither updated nor referenced anymore.
+    button->requestUpdate();
+    canvas->setActiveControl(button.get());
+    plane->remove(button);
+    EXPECT_EQ(canvas->getActiveControl(), nullptr);
+    canvas->update();
+    EXPECT_FALSE(button->updated);
+}
@@ -0,0 +1,318 @@
+#include "test.hpp"
+#include "nullRenderer.hpp"
+#include "guise/font.hpp"
+#include "guise/fontIndex.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/label.hpp"
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+using namespace Guise;
+
+static std::shared_ptr<Font> getTestFont()
+{
+    static const std::string path = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+    if (!std::ifstream(path).good())
+    {
+        return nullptr;
+    }
+    return FontLibrary::get(path);
+}
+
+static const std::wstring g_layoutText =
+    L"The quick brown fox jumps over the lazy dog.\n"
+    L"\n"
+    L"Pack my box with five dozen liquor jugs, supercalifragilisticexpialidocious.";
+
+static void expectEqualLines(const TextLayout & layout1, const TextLayout & layout2)
+{
+    auto & lines1 = layout1.getLines();
+    auto & lines2 = layout2.getLines();
+    ASSERT_EQ(lines1.size(), lines2.size());
+    for (size_t i = 0; i < lines1.size(); i++)
+    {
+        EXPECT_EQ(lines1[i].from, lines2[i].from);
+        EXPECT_EQ(lines1[i].to, lines2[i].to);
+        EXPECT_EQ(lines1[i].width, lines2[i].width);
+    }
+}
+
+TEST(TextLayout, Wrap)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    TextLayout layout(font);
+    ASSERT_TRUE(layout.create(g_layoutText, 12, 96, std::numeric_limits<int32_t>::max()));
+    ASSERT_EQ(layout.getLines().size(), size_t(3));
+    EXPECT_GT(layout.getLineHeight(), 0);
+
+    ASSERT_FALSE(layout.setWidth(std::numeric_limits<int32_t>::max()));
+    ASSERT_TRUE(layout.setWidth(120));
+    for (auto & line : layout.getLines())
+    {
+        EXPECT_TRUE(line.width <= 120 || line.minWidth == std::numeric_limits<int32_t>::min());
+    }
+    EXPECT_GT(layout.getLines().size(), size_t(3));
+}
+
+TEST(TextLayout, IncrementalRelayout)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    TextLayout incremental(font);
+    ASSERT_TRUE(incremental.create(g_layoutText, 12, 96, 300));
+
+    for (int32_t width : { 250, 200, 201, 120, 60, 5, 0, 61, 400, 1000, 33, 300 })
+    {
+        incremental.setWidth(width);
+
+        TextLayout fresh(font);
+        ASSERT_TRUE(fresh.create(g_layoutText, 12, 96, width));
+        expectEqualLines(incremental, fresh);
+    }
+}
+
+TEST(TextLayout, Intersect)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    TextLayout layout(font);
+    ASSERT_TRUE(layout.create(g_layoutText, 12, 96, 150));
+
+    const float halfLine = static_cast<float>(layout.getLineHeight()) * 0.5f;
+    for (size_t i = 0; i < g_layoutText.size(); i++)
+    {
+        // Caret positions of line starts and inner characters map back to their index.
+        const size_t lineIndex = layout.findLine(i);
+        auto & line = layout.getLines()[lineIndex];
+        if (i >= line.to)
+        {
+            continue;
+        }
+
+        const Vector2f position = layout.indexToPosition(i);
+        EXPECT_EQ(layout.intersect({ position.x + 0.1f, position.y + halfLine }), i);
+    }
+
+    Vector2<size_t> size;
+    EXPECT_NE(layout.createBitmapRgba(size), nullptr);
+    EXPECT_EQ(size.y, layout.getLines().size() * static_cast<size_t>(layout.getLineHeight()));
+}
+
+TEST(FontSequence, DistanceField)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    FontSequence sequence(font);
+    ASSERT_TRUE(sequence.createDistanceFieldSequence(L"Hello"));
+
+    Vector2<size_t> size;
+    const uint8_t * bitmap = sequence.createBitmapRgba(size);
+    ASSERT_NE(bitmap, nullptr);
+    EXPECT_GT(size.x, size_t(0));
+    EXPECT_GT(size.y, size_t(0));
+
+    // Distance field sequences are independent of size, bitmap sequences follow it.
+    ASSERT_TRUE(sequence.createSequence(L"Hello", 12, 96));
+    const int32_t width12 = sequence.getHorizontalBounds(4).position;
+    ASSERT_TRUE(sequence.createSequence(L"Hello", 24, 96));
+    const int32_t width24 = sequence.getHorizontalBounds(4).position;
+    EXPECT_GT(width24, width12);
+
+    EXPECT_FLOAT_EQ(FontSequence::getDistanceFieldScale(36, 96), 1.0f);
+}
+
+TEST(FontIndex, ScanAndCache)
+{
+    namespace fs = std::filesystem;
+    const fs::path fontPath = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+    if (!fs::exists(fontPath))
+    {
+        GTEST_SKIP();
+    }
+
+    const fs::path directory = fs::temp_directory_path() / "guise_font_index_test";
+    fs::remove_all(directory);
+    fs::create_directories(directory / "fonts");
+    fs::copy_file(fontPath, directory / "fonts" / "DejaVuSans.ttf");
+    const std::string cachePath = (directory / "cache" / "fontIndex.cache").string();
+
+    std::string family;
+    std::string style;
+    ASSERT_TRUE(FontIndex::readNames(fontPath.string(), family, style));
+    EXPECT_EQ(family, "DejaVu Sans");
+    EXPECT_EQ(style, "Book");
+
+    {
+        FontIndex index({ (directory / "fonts").string() }, cachePath);
+        index.load();
+        EXPECT_FALSE(index.isCached());
+        ASSERT_EQ(index.getEntries().size(), size_t(1));
+        EXPECT_EQ(index.find("DejaVu Sans"), (directory / "fonts" / "DejaVuSans.ttf").string());
+        EXPECT_EQ(index.find("dejavu sans book"), (directory / "fonts" / "DejaVuSans.ttf").string());
+        EXPECT_EQ(index.find("Arial"), (directory / "fonts" / "DejaVuSans.ttf").string());
+        EXPECT_EQ(index.find("DejaVu Sans Bold"), "");
+        EXPECT_EQ(index.find("Missing Family"), "");
+    }
+    {
+        FontIndex index({ (directory / "fonts").string() }, cachePath);
+        index.load();
+        EXPECT_TRUE(index.isCached());
+        EXPECT_EQ(index.find("DejaVu Sans"), (directory / "fonts" / "DejaVuSans.ttf").string());
+    }
+
+    // Adding a font invalidates the cache.
+    fs::copy_file(fontPath, directory / "fonts" / "DejaVuSansCopy.ttf");
+    fs::last_write_time(directory / "fonts", fs::last_write_time(directory / "fonts") + std::chrono::seconds(1));
+    {
+        FontIndex index({ (directory / "fonts").string() }, cachePath);
+        index.load();
+        EXPECT_FALSE(index.isCached());
+        EXPECT_EQ(index.getEntries().size(), size_t(2));
+    }
+
+    fs::remove_all(directory);
+}
+
+TEST(TextRun, SharedTextures)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    auto textRun = TextRunCache::get(font, L"Shared", 12, 96);
+    ASSERT_TRUE(textRun && textRun->isValid());
+
+    // Renderers of a resource group share one texture, other renderers upload their own.
+    NullRenderer renderer1;
+    NullRenderer renderer2(renderer1.getResourceGroup());
+    NullRenderer renderer3;
+    auto texture = textRun->getTexture(renderer1);
+    ASSERT_NE(texture, nullptr);
+    EXPECT_EQ(textRun->getTexture(renderer2), texture);
+    EXPECT_NE(textRun->getTexture(renderer3), texture);
+    EXPECT_EQ(renderer1.textureCount + renderer2.textureCount, size_t(1));
+    EXPECT_EQ(renderer3.textureCount, size_t(1));
+}
+
+TEST(TextRun, ReusedRendererAddress)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    auto textRun = TextRunCache::get(font, L"Reused", 12, 96);
+    ASSERT_TRUE(textRun && textRun->isValid());
+
+    // A renderer constructed at the address of a destroyed renderer uploads its own texture.
+    std::optional<NullRenderer> renderer;
+    renderer.emplace();
+    auto texture = textRun->getTexture(*renderer);
+    ASSERT_NE(texture, nullptr);
+    renderer.reset();
+    renderer.emplace();
+    EXPECT_NE(textRun->getTexture(*renderer), texture);
+    EXPECT_EQ(renderer->textureCount, size_t(1));
+}
+
+TEST(TextRunCache, HitsAndEviction)
+{
+    auto font = getTestFont();
+    if (!font)
+    {
+        GTEST_SKIP();
+    }
+
+    TextRunCache::purge();
+    TextRunCache::resetStatistics();
+    const size_t runs = TextRunCache::getStatistics().runs;
+
+    // Equal text, font, size and dpi share a run.
+    auto run1 = TextRunCache::get(font, L"Cached", 12, 96);
+    auto run2 = TextRunCache::get(font, L"Cached", 12, 96);
+    auto run3 = TextRunCache::get(font, L"Cached", 14, 96);
+    EXPECT_EQ(run1, run2);
+    EXPECT_NE(run1, run3);
+
+    auto statistics = TextRunCache::getStatistics();
+    EXPECT_EQ(statistics.hits, size_t(1));
+    EXPECT_EQ(statistics.misses, size_t(2));
+    EXPECT_EQ(statistics.runs, runs + 2);
+
+    // Released runs are evicted, getting them again creates a new run.
+    run1.reset();
+    run2.reset();
+    EXPECT_EQ(TextRunCache::getStatistics().runs, runs + 1);
+    run1 = TextRunCache::get(font, L"Cached", 12, 96);
+    EXPECT_EQ(TextRunCache::getStatistics().misses, size_t(3));
+
+    run1.reset();
+    run3.reset();
+    EXPECT_EQ(TextRunCache::purge(), size_t(2));
+    EXPECT_EQ(TextRunCache::getStatistics().runs, runs);
+
+    TextRunCache::resetStatistics();
+    statistics = TextRunCache::getStatistics();
+    EXPECT_EQ(statistics.hits, size_t(0));
+    EXPECT_EQ(statistics.misses, size_t(0));
+}
+
+TEST(Label, ParallelPrepare)
+{
+    if (!getTestFont())
+    {
+        GTEST_SKIP();
+    }
+
+    ThreadPool pool(3);
+    auto canvas = Canvas::create({ 800, 600 });
+    canvas->setThreadPool(&pool);
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    std::vector<std::shared_ptr<Label> > labels;
+    for (size_t i = 0; i < 32; i++)
+    {
+        labels.push_back(Label::create(L"Prepared " + std::to_wstring(i)));
+        plane->add(labels.back());
+    }
+    canvas->update();
+
+    NullRenderer renderer;
+    canvas->render(renderer);
+    ASSERT_EQ(renderer.textureCount, labels.size());
+
+    // Texts are shaped by the pool, replaced textures are destroyed by the updating thread.
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        labels[i]->setText(L"Replaced " + std::to_wstring(i));
+    }
+    canvas->update();
+    EXPECT_EQ(renderer.textureLog->destroyThreads.size(), labels.size());
+    for (auto & thread : renderer.textureLog->destroyThreads)
+    {
+        EXPECT_EQ(thread, std::this_thread::get_id());
+    }
+    EXPECT_GT(labels[0]->getBounds().size.x, 0.0f);
+}
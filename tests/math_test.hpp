@@ -221,4 +221,8 @@ TEST(Bounds, Transform)
         }*/
 
     }
-}
\ No newline at end of file
+    {
+        Bounds2i32 bounds = { { 50, 100 },{ 100, 100 } };
+        EXPECT_EQ(bounds.outerJoin({ { 0, 150 }, { 100, 200 } }), Bounds2i32({ 0, 100 }, { 150, 250 }));
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef GUISE_TEST_NULLRENDERER_HPP
+#define GUISE_TEST_NULLRENDERER_HPP
+
+#include "guise/renderer.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Guise;
+
+/**
+* Threads which destroyed textures of a null renderer.
+*/
+struct NullTextureLog
+{
+    std::mutex                      mutex;
+    std::vector<std::thread::id>    destroyThreads;
+};
+
+class NullTexture : public Texture
+{
+
+public:
+
+    explicit NullTexture(const std::shared_ptr<NullTextureLog> & log = nullptr) :
+        m_log(log)
+    { }
+
+    ~NullTexture()
+    {
+        if (m_log)
+        {
+            std::lock_guard<std::mutex> lock(m_log->mutex);
+            m_log->destroyThreads.push_back(std::this_thread::get_id());
+        }
+    }
+
+    void load(const uint8_t *, const PixelFormat pixelFormat, const Vector2ui32 & dimensions)
+    {
+        m_pixelFormat = pixelFormat;
+        m_dimensions = dimensions;
+    }
+    void unload() { }
+    void bind(const size_t) const { }
+    void unbind() const { }
+    PixelFormat getPixelFormat() const { return m_pixelFormat; }
+    Vector2ui32 getDimensions() const { return m_dimensions; }
+
+private:
+
+    std::shared_ptr<NullTextureLog> m_log;
+    PixelFormat m_pixelFormat = PixelFormat::RGBA8;
+    Vector2ui32 m_dimensions;
+
+};
+
+/**
+* Renderer counting draw calls and texture uploads, without any output.
+*/
+class NullRenderer : public Renderer
+{
+
+public:
+
+    explicit NullRenderer(const uint64_t resourceGroup = 0) :
+        textureLog(std::make_shared<NullTextureLog>()),
+        m_resourceGroup(resourceGroup ? resourceGroup : RendererInterface::getResourceGroup())
+    { }
+
+    float getScale() const { return 1.0f; }
+    void setLevel(const size_t) { }
+    void drawRect(const Bounds2f &, const Style::PaintRectStyle &) { rectCount++; }
+    void drawQuad(const Bounds2f &, const Vector4f &) { }
+    void drawQuad(const Bounds2f &, const Style::LinearGradient &) { }
+    void drawQuad(const Bounds2f &, const std::shared_ptr<Texture> &, const Vector4f &) { }
+    void drawDistanceFieldQuad(const Bounds2f &, const std::shared_ptr<Texture> &, const Vector4f &) { }
+    void drawBorder(const Bounds2f &, const float, const Vector4f &) { }
+    void drawLine(const Vector2f &, const Vector2f &, const float, const Vector4f &) { }
+    void pushMask(const Bounds2i32 &) { }
+    void popMask() { }
+    std::shared_ptr<Texture> createTexture() { textureCount++; return std::make_shared<NullTexture>(textureLog); }
+    uint64_t getResourceGroup() const { return m_resourceGroup; }
+    const Vector4f & getClearColor() { return m_clearColor; }
+    void setClearColor(const Vector4f & color) { m_clearColor = color; }
+    void setViewportSize(const Vector2ui32 &, const Vector2ui32 &) { }
+    void setScale(const float) { }
+    void clearColor() { }
+    void clearDepth() { }
+    void present() { }
+    uint32_t getBufferAge() { return bufferAge; }
+    void setScissor(const Bounds2f & bounds) { scissors.push_back(bounds); }
+    void resetScissor() { }
+
+    size_t rectCount = 0;
+    size_t textureCount = 0;
+    std::shared_ptr<NullTextureLog> textureLog;
+    uint32_t bufferAge = 0;
+    std::vector<Bounds2f> scissors;
+
+private:
+
+    uint64_t        m_resourceGroup;
+    Vector4f        m_clearColor;
+
+};
+
+#endif
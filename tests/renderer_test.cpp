@@ -0,0 +1,51 @@
+// Compiled separately, platform headers of app windows clash with names of other tests using namespace Guise.
+#include "test.hpp"
+#include "guise/appWindow.hpp"
+#include "guise/renderer.hpp"
+#include <cstdlib>
+
+#if !defined(GUISE_DISABLE_OPENGL)
+    #include <GL/gl.h>
+#endif
+
+#if !defined(GUISE_DISABLE_OPENGL)
+
+TEST(OpenGLRenderer, SharedResources)
+{
+#if defined(GUISE_PLATFORM_LINUX)
+    // Requires a display, skipped on headless machines.
+    if (!std::getenv("DISPLAY"))
+    {
+        GTEST_SKIP();
+    }
+#endif
+
+    auto appWindow1 = Guise::AppWindow::create(L"Shared 1", { 64, 64 });
+    auto appWindow2 = Guise::AppWindow::create(L"Shared 2", { 64, 64 });
+    auto appWindow3 = Guise::AppWindow::create(L"Unshared", { 64, 64 });
+    auto renderer1 = Guise::Renderer::createDefault(appWindow1);
+    auto renderer2 = Guise::Renderer::createDefault(appWindow2, renderer1);
+    auto renderer3 = Guise::Renderer::createDefault(appWindow3);
+    ASSERT_TRUE(renderer1 && renderer2 && renderer3);
+
+    EXPECT_EQ(renderer1->getResourceGroup(), renderer2->getResourceGroup());
+    EXPECT_NE(renderer1->getResourceGroup(), renderer3->getResourceGroup());
+
+    // Textures uploaded by one context are complete when bound by another context of the group.
+    const uint8_t pixels[4 * 4 * 4] = {};
+    renderer1->makeCurrent();
+    auto texture = renderer1->createTexture();
+    texture->load(pixels, Guise::Texture::PixelFormat::RGBA8, { 4, 4 });
+
+    renderer2->makeCurrent();
+    texture->bind(0);
+    GLint width = 0;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    EXPECT_EQ(width, 4);
+    texture->unbind();
+
+    renderer1->makeCurrent();
+    texture.reset();
+}
+
+#endif
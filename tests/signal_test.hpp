@@ -0,0 +1,247 @@
+#include "test.hpp"
+#include "guise/signal.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/label.hpp"
+#include <thread>
+
+using namespace Guise;
+
+TEST(Signal, Delegate)
+{
+    int value = 0;
+    Delegate<int(int)> small([&value](int add) { value += add; return value; });
+    EXPECT_TRUE(small.isInline());
+    EXPECT_EQ(small(2), 2);
+
+    std::array<int, 32> large = {};
+    large[0] = 5;
+    Delegate<int(int)> heap([large](int add) { return large[0] + add; });
+    EXPECT_FALSE(heap.isInline());
+
+    Delegate<int(int)> moved(std::move(heap));
+    EXPECT_FALSE(static_cast<bool>(heap));
+    EXPECT_EQ(moved(1), 6);
+
+    moved = std::move(small);
+    EXPECT_EQ(moved(3), 5);
+    moved.reset();
+    EXPECT_FALSE(static_cast<bool>(moved));
+}
+
+TEST(Signal, Connections)
+{
+    Signal<int> signal;
+    int sum = 0;
+    int calls = 0;
+
+    auto connection = signal.connect([&sum](int value) { sum += value; });
+    signal.connectAnonymously([&calls]() { calls++; });
+    EXPECT_EQ(signal.getConnectionCount(), size_t(1));
+    EXPECT_EQ(signal.getAnonymousConnectionCount(), size_t(1));
+
+    signal(3);
+    EXPECT_EQ(sum, 3);
+    EXPECT_EQ(calls, 1);
+
+    EXPECT_TRUE(connection.isConnected());
+    connection.disconnect();
+    EXPECT_FALSE(connection.isConnected());
+    signal(3);
+    EXPECT_EQ(sum, 3);
+    EXPECT_EQ(calls, 2);
+
+    // Disconnected slots are reused, old handles stay disconnected.
+    auto newConnection = signal.connect([&sum](int value) { sum -= value; });
+    EXPECT_FALSE(connection.isConnected());
+    EXPECT_TRUE(newConnection.isConnected());
+    connection.disconnect();
+    signal(1);
+    EXPECT_EQ(sum, 2);
+
+    signal.disconnectAll();
+    EXPECT_EQ(signal.getConnectionCount(), size_t(0));
+    EXPECT_EQ(signal.getAnonymousConnectionCount(), size_t(1));
+}
+
+TEST(Signal, DisconnectWhileCalling)
+{
+    Signal<> signal;
+    int calls = 0;
+    Connection connection;
+    connection = signal.connect([&]()
+    {
+        calls++;
+        connection.disconnect();
+        signal.connect([&calls]() { calls += 10; });
+    });
+
+    // Connections made while calling are called by the next call.
+    signal();
+    EXPECT_EQ(calls, 1);
+    signal();
+    EXPECT_EQ(calls, 11);
+    EXPECT_EQ(signal.getConnectionCount(), size_t(1));
+}
+
+TEST(Signal, Dependencies)
+{
+    Signal<int> signal;
+    auto dependency = std::make_shared<int>(0);
+    int calls = 0;
+
+    auto connection = signal.connect({ dependency }, [&calls](int) { calls++; });
+    signal(1);
+    EXPECT_EQ(calls, 1);
+
+    dependency.reset();
+    signal(1);
+    EXPECT_EQ(calls, 1);
+    EXPECT_FALSE(connection.isConnected());
+    EXPECT_EQ(signal.getConnectionCount(), size_t(0));
+
+    std::vector<std::weak_ptr<void> > dependencies(SignalSlotsBase::MaxDependencies + 1, std::make_shared<int>(0));
+    EXPECT_THROW(signal.connect(dependencies, [](int) {}), std::invalid_argument);
+}
+
+TEST(Signal, DestroyedSignal)
+{
+    Connection connection;
+    {
+        Signal<> signal;
+        connection = signal.connect([]() {});
+        EXPECT_TRUE(connection.isConnected());
+    }
+    EXPECT_FALSE(connection.isConnected());
+    connection.disconnect();
+}
+
+TEST(Signal, ScopedConnection)
+{
+    Signal<> signal;
+    int calls = 0;
+    {
+        ScopedConnection connection = signal.connect([&calls]() { calls++; });
+        signal();
+        EXPECT_EQ(signal.getConnectionCount(), size_t(1));
+
+        ScopedConnection movedConnection(std::move(connection));
+        EXPECT_FALSE(connection.isConnected());
+        EXPECT_TRUE(movedConnection.isConnected());
+    }
+    signal();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(signal.getConnectionCount(), size_t(0));
+
+    ScopedConnection connection = signal.connect([&calls]() { calls++; });
+    connection = signal.connect([&calls]() { calls += 10; });
+    signal();
+    EXPECT_EQ(calls, 11);
+    EXPECT_EQ(signal.getConnectionCount(), size_t(1));
+}
+
+TEST(Signal, LabelCanvasChange)
+{
+    auto canvasA = Canvas::create({ 400, 300 });
+    auto canvasB = Canvas::create({ 400, 300 });
+    auto planeA = Plane::create();
+    auto planeB = Plane::create();
+    canvasA->add(planeA);
+    canvasB->add(planeB);
+
+    // Moving a label between canvases keeps a single dpi connection.
+    auto label = Label::create(L"Label");
+    for (size_t i = 0; i < 8; i++)
+    {
+        planeA->add(label);
+        planeA->remove(label);
+        planeB->add(label);
+        planeB->remove(label);
+    }
+    planeA->add(label);
+    EXPECT_EQ(canvasA->onDpiChange.getTotalConnectionCount(), size_t(1));
+    EXPECT_EQ(canvasB->onDpiChange.getTotalConnectionCount(), size_t(0));
+
+    canvasA->setDpi(144);
+    planeA->remove(label);
+    label.reset();
+    EXPECT_EQ(canvasA->onDpiChange.getTotalConnectionCount(), size_t(0));
+    canvasA->setDpi(96);
+}
+
+TEST(Signal, TaskQueue)
+{
+    TaskQueue queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.execute(), size_t(0));
+
+    // Producers push while the consumer executes.
+    const size_t threadCount = 4;
+    const size_t taskCount = 10000;
+    std::atomic<bool> producing(true);
+    size_t sum = 0;
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        producers.emplace_back([&queue, &sum]()
+        {
+            for (size_t j = 0; j < taskCount; j++)
+            {
+                queue.push([&sum]() { sum++; });
+            }
+        });
+    }
+
+    std::thread consumer([&queue, &producing]()
+    {
+        while (producing)
+        {
+            queue.execute();
+        }
+    });
+    for (auto & producer : producers)
+    {
+        producer.join();
+    }
+    producing = false;
+    consumer.join();
+
+    queue.execute();
+    EXPECT_EQ(sum, threadCount * taskCount);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(Signal, QueuedConnection)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    Signal<int, const std::wstring &> signal;
+    int sum = 0;
+    std::wstring text;
+    auto connection = signal.connectQueued(canvas->getTaskQueue(), [&](int value, const std::wstring & string)
+    {
+        sum += value;
+        text = string;
+    });
+
+    std::thread worker([&signal]()
+    {
+        for (int i = 1; i <= 100; i++)
+        {
+            signal(i, std::to_wstring(i));
+        }
+    });
+    worker.join();
+    EXPECT_EQ(sum, 0);
+
+    canvas->update();
+    EXPECT_EQ(sum, 5050);
+    EXPECT_EQ(text, L"100");
+
+    // Pending tasks of disconnected and expired connections are skipped.
+    auto dependency = std::make_shared<int>(0);
+    signal.connectQueued(canvas->getTaskQueue(), { dependency }, [&sum]() { sum = -1; });
+    signal(1, L"");
+    connection.disconnect();
+    dependency.reset();
+    canvas->update();
+    EXPECT_EQ(sum, 5050);
+}
@@ -0,0 +1,557 @@
+#include "test.hpp"
+#include "guise/style.hpp"
+#include "guise/sheetWatcher.hpp"
+#include "guise/canvas.hpp"
+#include "guise/control/button.hpp"
+#include "guise/control/checkbox.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+using namespace Guise;
+
+TEST(Style, InternIds)
+{
+    EXPECT_EQ(Style::internPropertyId("background-color"), Style::PropertyId::BackgroundColor);
+    EXPECT_EQ(Style::internPropertyId("vert-align"), Style::PropertyId::VerticalAlign);
+    EXPECT_EQ(Style::getPropertyName(Style::PropertyId::FontFamily), "font-family");
+    EXPECT_EQ(Style::internSelectorId("checkbox:checkedHover"), Style::SelectorId::CheckboxCheckedHover);
+
+    // Unknown names are interned once, above the built-in identifiers.
+    auto custom = Style::internSelectorId("style-test-custom");
+    EXPECT_GE(static_cast<size_t>(custom), static_cast<size_t>(Style::SelectorId::Count));
+    EXPECT_EQ(Style::internSelectorId("style-test-custom"), custom);
+    EXPECT_EQ(Style::getSelectorName(custom), "style-test-custom");
+}
+
+TEST(Style, SelectorLookup)
+{
+    Style::Selector selector(
+        {
+            { "size", { Vector2f{ 1.0f, 2.0f } } },
+            { "padding", { 3.0f } },
+            { "background-color", { Vector4f{ 0.0f, 0.0f, 0.0f, 1.0f } } },
+            { "padding", { 4.0f } },
+            { "style-test-property", { 5 } }
+        }
+    );
+
+    auto & properties = selector.getProperties();
+    ASSERT_EQ(properties.size(), size_t(4));
+    for (size_t i = 1; i < properties.size(); i++)
+    {
+        EXPECT_LT(properties[i - 1].first, properties[i].first);
+    }
+
+    ASSERT_TRUE(selector.getProperty(Style::PropertyId::Padding));
+    EXPECT_EQ(selector.getProperty("padding")->getFloat(), 4.0f);
+    ASSERT_TRUE(selector.getProperty("style-test-property"));
+    EXPECT_EQ(selector.getProperty("style-test-property")->getInteger(), 5);
+    EXPECT_FALSE(selector.getProperty(Style::PropertyId::Margin));
+
+    auto sheet = Style::Sheet::create({ { "style-test-selector", selector }, { Style::SelectorId::Label, selector } });
+    EXPECT_TRUE(sheet->getSelector("style-test-selector"));
+    EXPECT_TRUE(sheet->getSelector(Style::SelectorId::Label));
+    EXPECT_FALSE(sheet->getSelector(Style::SelectorId::Button));
+    EXPECT_FALSE(sheet->getSelector("style-test-missing"));
+
+    // Looking up unknown names does not intern them.
+    Style::SelectorId selectorId;
+    Style::PropertyId propertyId;
+    EXPECT_FALSE(selector.getProperty("style-test-missing-property"));
+    EXPECT_FALSE(Style::findSelectorId("style-test-missing", selectorId));
+    EXPECT_FALSE(Style::findPropertyId("style-test-missing-property", propertyId));
+}
+
+TEST(Style, SelectorCopyOnWrite)
+{
+    Style::Selector selector(
+        {
+            { "size", { Style::Size{ Style::Size::FitParent, 20.0f } } },
+            { "font-family", { std::string("Arial") } }
+        }
+    );
+
+    Style::Selector copy = selector;
+    const Style::Selector & constSelector = selector;
+    const Style::Selector & constCopy = copy;
+    EXPECT_EQ(&constCopy.getProperties(), &constSelector.getProperties());
+
+    copy.setProperty(Style::PropertyId::FontFamily, { std::string("DejaVu Sans") });
+    EXPECT_EQ(selector.getProperty(Style::PropertyId::FontFamily)->getString(), "Arial");
+    EXPECT_EQ(copy.getProperty(Style::PropertyId::FontFamily)->getString(), "DejaVu Sans");
+
+    auto size = copy.getProperty(Style::PropertyId::Size);
+    ASSERT_TRUE(size);
+    EXPECT_EQ(size->getDataType(), Style::Property::DataType::Size);
+    EXPECT_EQ(size->getSize().fit.x, Style::Size::FitParent);
+    EXPECT_EQ(size->getSize().y, 20.0f);
+
+    // Equal strings are interned once.
+    Style::Property a(std::string("interned")), b(std::string("interned"));
+    EXPECT_EQ(&a.getString(), &b.getString());
+}
+
+TEST(Style, ParentInheritance)
+{
+    Style::PaintRectStyle parent;
+    Style::PaintRectStyle child(nullptr, &parent);
+
+    parent.setBackgroundColor({ 1.0f, 0.0f, 0.0f, 1.0f });
+    EXPECT_EQ(child.getBackgroundColor(), Vector4f(1.0f, 0.0f, 0.0f, 1.0f));
+
+    // Changing the parent is picked up by the child.
+    parent.setBackgroundColor({ 0.0f, 1.0f, 0.0f, 1.0f });
+    EXPECT_EQ(child.getBackgroundColor(), Vector4f(0.0f, 1.0f, 0.0f, 1.0f));
+
+    child.setBackgroundColor({ 0.0f, 0.0f, 1.0f, 1.0f });
+    EXPECT_EQ(child.getBackgroundColor(), Vector4f(0.0f, 0.0f, 1.0f, 1.0f));
+    EXPECT_EQ(parent.getBackgroundColor(), Vector4f(0.0f, 1.0f, 0.0f, 1.0f));
+
+    Style::Selector selector({ { "border-width", { 2.0f } } });
+    const uint64_t generation = child.getResolvedGeneration();
+    parent.updateEmptyProperties(&selector);
+    EXPECT_EQ(child.getBorderWidth(), 2.0f);
+    EXPECT_NE(child.getResolvedGeneration(), generation);
+
+    // Resolved values are rebuilt through every level, copies inherit from the same parent.
+    Style::PaintRectStyle grandchild(nullptr, &child);
+    Style::PaintRectStyle copy = child;
+    parent.resetSheetProperties();
+    EXPECT_EQ(grandchild.getBorderWidth(), 0.0f);
+    EXPECT_EQ(copy.getBorderWidth(), 0.0f);
+    parent.setBorderWidth(4.0f);
+    EXPECT_EQ(grandchild.getBorderWidth(), 4.0f);
+    EXPECT_EQ(copy.getBorderWidth(), 4.0f);
+    EXPECT_EQ(grandchild.getBackgroundColor(), Vector4f(0.0f, 0.0f, 1.0f, 1.0f));
+
+    // Assigned styles inherit from the parent of the source, childs use the default values once their parent is destroyed.
+    {
+        Style::PaintRectStyle scopedParent;
+        scopedParent.setBorderWidth(5.0f);
+        Style::PaintRectStyle orphan(nullptr, &scopedParent);
+        child = orphan;
+        EXPECT_EQ(grandchild.getBorderWidth(), 5.0f);
+    }
+    EXPECT_EQ(child.getBorderWidth(), 0.0f);
+    EXPECT_EQ(grandchild.getBorderWidth(), 0.0f);
+}
+
+TEST(Style, ParseSheet)
+{
+    const std::string text =
+        "/* Theme. */\n"
+        "button, checkbox:hover {\n"
+        "    background-color: 0.5 0.25 0 1; // Vector4f\n"
+        "    border-color: #ff0000;\n"
+        "    border-style: solid;\n"
+        "    padding: 3;\n"
+        "}\n"
+        "label { font-family: DejaVu Sans; font-size: 14; size: fit-parent 20 }\n"
+        "button { padding: 4 5; }\n";
+
+    std::string error;
+    auto sheet = Style::Sheet::parse(text, &error);
+    ASSERT_TRUE(sheet) << error;
+
+    auto button = sheet->getSelector(Style::SelectorId::Button);
+    ASSERT_TRUE(button);
+    EXPECT_EQ(button->getProperty("background-color")->getVector4f(), Vector4f(0.5f, 0.25f, 0.0f, 1.0f));
+    EXPECT_EQ(button->getProperty("border-color")->getVector4f(), Vector4f(1.0f, 0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(button->getProperty("border-style")->getBorderStyle(), Style::Property::BorderStyle::Solid);
+    EXPECT_EQ(button->getProperty("padding")->getVector2f(), Vector2f(4.0f, 5.0f));
+    ASSERT_TRUE(sheet->getSelector(Style::SelectorId::CheckboxHover));
+    EXPECT_EQ(sheet->getSelector(Style::SelectorId::CheckboxHover)->getProperty("padding")->getFloat(), 3.0f);
+
+    auto label = sheet->getSelector(Style::SelectorId::Label);
+    ASSERT_TRUE(label);
+    EXPECT_EQ(label->getProperty("font-family")->getString(), "DejaVu Sans");
+    EXPECT_EQ(label->getProperty("font-size")->getInteger(), 14);
+    EXPECT_EQ(label->getProperty("size")->getSize().fit.x, Style::Size::FitParent);
+    EXPECT_EQ(label->getProperty("size")->getSize().y, 20.0f);
+
+    EXPECT_FALSE(Style::Sheet::parse("button { padding: 3;", &error));
+    EXPECT_FALSE(Style::Sheet::parse("button {\n border-style: dotted; }", &error));
+    EXPECT_EQ(error.find("line 2"), size_t(0));
+    EXPECT_FALSE(Style::Sheet::parse("button { padding: 3; }\n/* Unterminated\n", &error));
+    EXPECT_EQ(error, "line 2: unterminated comment");
+    EXPECT_FALSE(Style::Sheet::parse("button { padding: 3 /* unterminated; }", &error));
+
+    // Unknown names are errors and are not interned, custom selectors are interned once the text is parsed.
+    Style::SelectorId selectorId;
+    Style::PropertyId propertyId;
+    EXPECT_FALSE(Style::Sheet::parse("style-test-parsed { style-test-typo: 1; }", &error));
+    EXPECT_EQ(error, "line 1: unknown property \"style-test-typo\"");
+    EXPECT_FALSE(Style::findPropertyId("style-test-typo", propertyId));
+    EXPECT_FALSE(Style::findSelectorId("style-test-parsed", selectorId));
+    EXPECT_FALSE(Style::Sheet::parse("button:hoover { padding: 1; }", &error));
+    EXPECT_EQ(error, "line 1: unknown selector \"button:hoover\"");
+    EXPECT_FALSE(Style::findSelectorId("button:hoover", selectorId));
+    EXPECT_FALSE(Style::Sheet::parse("-button { padding: 1; }", &error));
+    ASSERT_TRUE(Style::Sheet::parse("style-test-parsed { padding: 1; }", &error)) << error;
+    EXPECT_TRUE(Style::findSelectorId("style-test-parsed", selectorId));
+
+    // Merge over a base sheet.
+    auto defaultSheet = Style::Sheet::createDefault();
+    auto merged = Style::Sheet::parse("button { padding: 8; }", nullptr, defaultSheet.get());
+    ASSERT_TRUE(merged);
+    EXPECT_EQ(merged->getSelector(Style::SelectorId::Button)->getProperty("padding")->getFloat(), 8.0f);
+    EXPECT_TRUE(merged->getSelector(Style::SelectorId::Button)->getProperty("border-style"));
+    EXPECT_EQ(defaultSheet->getSelector(Style::SelectorId::Button)->getProperty("padding")->getFloat(), 3.0f);
+
+    auto changed = Style::Sheet::diff(*defaultSheet, *merged);
+    EXPECT_TRUE(changed.contains(Style::SelectorId::Button));
+    EXPECT_FALSE(changed.contains(Style::SelectorId::Label));
+    EXPECT_TRUE(Style::Sheet::diff(*defaultSheet, *Style::Sheet::createDefault()).isEmpty());
+}
+
+TEST(Style, LinearGradient)
+{
+    const Vector4f white = { 1.0f, 1.0f, 1.0f, 1.0f };
+    const Vector4f black = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const Bounds2f bounds = { { 10.0f, 20.0f }, { 100.0f, 50.0f } };
+
+    // Top to bottom.
+    Style::LinearGradient vertical(white, black);
+    EXPECT_EQ(vertical.getColor(bounds, { 10.0f, 20.0f }), white);
+    EXPECT_EQ(vertical.getColor(bounds, { 110.0f, 70.0f }), black);
+    EXPECT_EQ(vertical.getColor(bounds, { 60.0f, 45.0f }), Vector4f(0.5f, 0.5f, 0.5f, 1.0f));
+
+    // Diagonal gradients reach both colors exactly in opposite corners.
+    Style::LinearGradient diagonal(45.0f, white, black);
+    const Vector4f topLeft = diagonal.getColor(bounds, { 10.0f, 20.0f });
+    const Vector4f bottomRight = diagonal.getColor(bounds, { 110.0f, 70.0f });
+    EXPECT_NEAR(topLeft.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(bottomRight.x, 0.0f, 1e-5f);
+
+    std::string error;
+    auto sheet = Style::Sheet::parse("button { background-gradient: 90 #fff #000; }", &error);
+    ASSERT_TRUE(sheet) << error;
+    auto property = sheet->getSelector(Style::SelectorId::Button)->getProperty(Style::PropertyId::BackgroundGradient);
+    ASSERT_TRUE(property);
+    ASSERT_EQ(property->getDataType(), Style::Property::DataType::LinearGradient);
+    EXPECT_EQ(property->getLinearGradient().getAngle(), 90.0f);
+    EXPECT_EQ(property->getLinearGradient().getColorB(), black);
+    EXPECT_FALSE(Style::Sheet::parse("button { background-gradient: #fff; }", &error));
+
+    Style::PaintRectStyle style;
+    EXPECT_FALSE(style.getBackgroundGradient());
+    style.updateEmptyProperties(sheet->getSelector(Style::SelectorId::Button));
+    ASSERT_TRUE(style.getBackgroundGradient());
+    EXPECT_EQ(style.getBackgroundGradient()->getColorA(), white);
+}
+
+TEST(Style, ResetSheetProperties)
+{
+    Style::PaintRectStyle style;
+    style.setBorderWidth(3.0f);
+
+    Style::Selector selector({ { "border-width", { 1.0f } }, { "background-color", { Vector4f{ 1.0f, 0.0f, 0.0f, 1.0f } } } });
+    style.updateEmptyProperties(&selector);
+    EXPECT_EQ(style.getBackgroundColor(), Vector4f(1.0f, 0.0f, 0.0f, 1.0f));
+
+    Style::Selector newSelector({ { "border-width", { 2.0f } }, { "background-color", { Vector4f{ 0.0f, 1.0f, 0.0f, 1.0f } } } });
+    style.resetSheetProperties();
+    style.updateEmptyProperties(&newSelector);
+    EXPECT_EQ(style.getBackgroundColor(), Vector4f(0.0f, 1.0f, 0.0f, 1.0f));
+    EXPECT_EQ(style.getBorderWidth(), 3.0f);
+}
+
+TEST(Style, SharedBlocks)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    std::vector<std::shared_ptr<Button> > buttons;
+    for (size_t i = 0; i < 64; i++)
+    {
+        buttons.push_back(Button::create());
+        plane->add(buttons.back());
+    }
+
+    // Identical buttons share the blocks of their selectors.
+    const size_t sharedCount = Style::getBlockStatistics().count;
+    auto button = Button::create();
+    plane->add(button);
+    EXPECT_EQ(Style::getBlockStatistics().count, sharedCount);
+
+    // Setting a property copies the block of a single style.
+    const Vector4f sheetColor = buttons[0]->getBackgroundColor();
+    button->setBackgroundColor({ 0.0f, 0.0f, 1.0f, 1.0f });
+    EXPECT_EQ(Style::getBlockStatistics().count, sharedCount + 1);
+    EXPECT_EQ(button->getBackgroundColor(), Vector4f(0.0f, 0.0f, 1.0f, 1.0f));
+    EXPECT_EQ(buttons[0]->getBackgroundColor(), sheetColor);
+    EXPECT_EQ(button->getBorderWidth(), buttons[0]->getBorderWidth());
+
+    // Local properties survive restyling.
+    auto sheet = Style::Sheet::parse("button { background-color: 0 1 0 1; border-width: 4; }", nullptr, Style::Sheet::createDefault().get());
+    ASSERT_TRUE(sheet);
+    canvas->setStyleSheet(sheet);
+    EXPECT_EQ(button->getBackgroundColor(), Vector4f(0.0f, 0.0f, 1.0f, 1.0f));
+    EXPECT_EQ(button->getBorderWidth(), 4.0f);
+    EXPECT_EQ(buttons[0]->getBackgroundColor(), Vector4f(0.0f, 1.0f, 0.0f, 1.0f));
+    EXPECT_EQ(buttons[0]->getBorderWidth(), 4.0f);
+
+    // All base classes of a style share its single block.
+    const size_t localCount = Style::getBlockStatistics().count;
+    auto otherButton = Button::create();
+    otherButton->setMargin(2.0f);
+    otherButton->setBorderWidth(3.0f);
+    otherButton->setPadding(4.0f);
+    EXPECT_EQ(Style::getBlockStatistics().count, localCount + 1);
+}
+
+TEST(Style, StyleBatch)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button = Button::create();
+    plane->add(button);
+    button->setBounds({ { 0.0f, 0.0f }, { 400.0f, 300.0f } });
+    const Bounds2f oldBounds = button->getBounds();
+
+    {
+        StyleBatch batch(*button);
+        button->setSize({ 120.0f, 40.0f });
+        button->setMargin(2.0f);
+        {
+            StyleBatch nestedBatch(*canvas);
+            button->setPosition({ 10.0f, 20.0f });
+        }
+        EXPECT_EQ(button->getBounds(), oldBounds);
+    }
+
+    EXPECT_EQ(button->getBounds().position, Vector2f(10.0f, 20.0f));
+    EXPECT_EQ(button->getBounds().size, Vector2f(120.0f, 40.0f));
+}
+
+namespace
+{
+    class ResizeCountingControl : public Control
+    {
+
+    public:
+
+        ResizeCountingControl() :
+            resizeCount(0)
+        { }
+
+        virtual ControlType getType() const
+        {
+            return ControlType::Custom;
+        }
+
+        size_t resizeCount;
+
+    private:
+
+        virtual void onResize()
+        {
+            resizeCount++;
+        }
+
+    };
+}
+
+TEST(Style, StyleBatchResizeOnce)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+
+    std::vector<std::shared_ptr<ResizeCountingControl> > controls;
+    for (size_t i = 0; i < 256; i++)
+    {
+        controls.push_back(std::make_shared<ResizeCountingControl>());
+        plane->add(controls.back());
+        controls.back()->resizeCount = 0;
+    }
+
+    {
+        StyleBatch batch(*canvas);
+        for (size_t repeat = 0; repeat < 3; repeat++)
+        {
+            for (auto & control : controls)
+            {
+                canvas->resizeControl(control.get());
+            }
+        }
+
+        // Removed controls are not resized.
+        plane->remove(controls[7]);
+        controls[7]->resizeCount = 0;
+        for (auto & control : controls)
+        {
+            EXPECT_EQ(control->resizeCount, size_t(0));
+        }
+    }
+
+    for (size_t i = 0; i < controls.size(); i++)
+    {
+        EXPECT_EQ(controls[i]->resizeCount, size_t(i == 7 ? 0 : 1));
+    }
+}
+
+TEST(Style, CanvasRestyle)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button = Button::create();
+    auto userButton = Button::create();
+    userButton->setBackgroundColor({ 0.0f, 0.0f, 1.0f, 1.0f });
+    plane->add(button);
+    plane->add(userButton);
+
+    auto sheet = Style::Sheet::parse("button { background-color: 0 1 0 1; }", nullptr, Style::Sheet::createDefault().get());
+    ASSERT_TRUE(sheet);
+    canvas->setStyleSheet(sheet);
+
+    EXPECT_EQ(button->getBackgroundColor(), Vector4f(0.0f, 1.0f, 0.0f, 1.0f));
+    EXPECT_EQ(userButton->getBackgroundColor(), Vector4f(0.0f, 0.0f, 1.0f, 1.0f));
+
+    canvas->setStyleSheet(nullptr);
+    EXPECT_EQ(button->getBackgroundColor(), Vector4f(0.25f, 0.25f, 0.25f, 1.0f));
+}
+
+TEST(Style, SheetWatcher)
+{
+    const std::string filename = testing::TempDir() + "guise_sheet_watcher_test.gss";
+    {
+        std::ofstream file(filename);
+        file << "button { padding: 1; }";
+    }
+
+    auto waitForSheet = [](Style::SheetWatcher & watcher)
+    {
+        for (int i = 0; i < 500; i++)
+        {
+            auto sheet = watcher.poll();
+            if (sheet)
+            {
+                return sheet;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return std::shared_ptr<Style::Sheet>();
+    };
+
+    auto watcher = Style::SheetWatcher::create(filename);
+    auto sheet = waitForSheet(*watcher);
+    ASSERT_TRUE(sheet);
+    EXPECT_EQ(sheet->getSelector(Style::SelectorId::Button)->getProperty("padding")->getFloat(), 1.0f);
+
+    // Replace the file like editors commonly do.
+    {
+        std::ofstream file(filename + ".tmp");
+        file << "button { padding: 2; }";
+    }
+    std::rename((filename + ".tmp").c_str(), filename.c_str());
+
+    sheet = waitForSheet(*watcher);
+    ASSERT_TRUE(sheet);
+    EXPECT_EQ(sheet->getSelector(Style::SelectorId::Button)->getProperty("padding")->getFloat(), 2.0f);
+    EXPECT_TRUE(watcher->getError().empty());
+
+    std::remove(filename.c_str());
+}
+
+TEST(Style, BinarySheet)
+{
+    auto source = Style::Sheet::parse(
+        "button { size: fit-parent 20; font-family: \"DejaVu Sans\"; }\n"
+        "style-test-binary { padding: 1 2; overflow: visible; }", nullptr, Style::Sheet::getDefault().get());
+    ASSERT_TRUE(source);
+
+    auto data = source->saveBinary();
+    std::string error;
+    auto sheet = Style::Sheet::loadBinary(data.data(), data.size(), &error);
+    ASSERT_TRUE(sheet) << error;
+    EXPECT_TRUE(Style::Sheet::diff(*source, *sheet).isEmpty());
+    EXPECT_EQ(sheet->getSelector("button")->getProperty("font-family")->getString(), "DejaVu Sans");
+    EXPECT_EQ(sheet->getSelector("button")->getProperty("size")->getSize().fit.x, Style::Size::FitParent);
+    EXPECT_EQ(sheet->getSelector("style-test-binary")->getProperty("padding")->getVector2f(), Vector2f(1.0f, 2.0f));
+
+    // Sheets written with other identifier counts are loaded by interning the names.
+    auto foreignData = data;
+    const uint32_t foreignCount = static_cast<uint32_t>(Style::PropertyId::Count) + 1;
+    std::memcpy(foreignData.data() + 8, &foreignCount, sizeof(foreignCount));
+    sheet = Style::Sheet::loadBinary(foreignData.data(), foreignData.size(), &error);
+    ASSERT_TRUE(sheet) << error;
+    EXPECT_TRUE(Style::Sheet::diff(*source, *sheet).isEmpty());
+
+    const std::string filename = testing::TempDir() + "guise_binary_sheet_test.gssb";
+    ASSERT_TRUE(source->saveBinary(filename, &error)) << error;
+    sheet = Style::Sheet::loadBinary(filename, &error);
+    ASSERT_TRUE(sheet) << error;
+    EXPECT_TRUE(Style::Sheet::diff(*source, *sheet).isEmpty());
+    std::remove(filename.c_str());
+
+    EXPECT_FALSE(Style::Sheet::loadBinary(data.data(), data.size() - 1, &error));
+    EXPECT_FALSE(Style::Sheet::loadBinary(filename, &error));
+
+    // Canvases without a sheet share the default sheet.
+    auto canvasA = Canvas::create({ 100, 100 });
+    auto canvasB = Canvas::create({ 100, 100 });
+    EXPECT_EQ(canvasA->getStyleSheet(), canvasB->getStyleSheet());
+    EXPECT_EQ(canvasA->getStyleSheet(), Style::Sheet::getDefault());
+}
+
+TEST(Style, StateStyles)
+{
+    auto canvas = Canvas::create({ 400, 300 });
+    auto plane = Plane::create();
+    canvas->add(plane);
+    auto button = Button::create();
+    button->setSize({ 100.0f, 30.0f });
+    plane->add(button);
+    button->setBounds({ { 0.0f, 0.0f }, { 400.0f, 300.0f } });
+
+    const auto bounds = button->getBounds();
+    EXPECT_EQ(bounds.size, Vector2f(100.0f, 30.0f));
+    const Vector2f inside = bounds.position + Vector2f(5.0f, 5.0f);
+    const Vector2f outside = bounds.position + bounds.size + Vector2f(5.0f, 5.0f);
+
+    // Color only changes keep the layout.
+    button->handleInputEvent(Input::Event(Input::EventType::MouseMove, inside));
+    EXPECT_EQ(button->getState(), Style::State::Hover);
+    EXPECT_EQ(&button->getCurrentStyle(), &button->getStyleHover());
+    EXPECT_EQ(button->getBounds(), bounds);
+
+    button->handleInputEvent(Input::Event(Input::EventType::MouseJustPressed, 0, inside));
+    EXPECT_EQ(&button->getCurrentStyle(), &button->getStyleActive());
+    button->handleInputEvent(Input::Event(Input::EventType::MouseRelease, 0, outside));
+    EXPECT_EQ(button->getState(), Style::State::None);
+    EXPECT_EQ(&button->getCurrentStyle(), static_cast<Style::ParentPaintRectStyle *>(button.get()));
+
+    // State styles are resolved along with the base style, not when switching to them.
+    button->setBorderWidth(7.0f);
+    button->getStyleDisabled().setTransitionDuration(0.0f);
+    const uint64_t disabledGeneration = button->getStyleDisabled().getResolvedGeneration();
+    button->disable();
+    EXPECT_EQ(&button->getCurrentStyle(), &button->getStyleDisabled());
+    EXPECT_EQ(button->getCurrentStyle().getBorderWidth(), 7.0f);
+    EXPECT_EQ(button->getStyleDisabled().getResolvedGeneration(), disabledGeneration);
+    button->enable();
+
+    // Layout changes resize the control.
+    button->getStyleHover().setSize({ 120.0f, 30.0f });
+    button->handleInputEvent(Input::Event(Input::EventType::MouseMove, inside));
+    EXPECT_EQ(button->getBounds().size, Vector2f(120.0f, 30.0f));
+    EXPECT_TRUE(canvas->isDamaged());
+
+    auto checkbox = Checkbox::create();
+    plane->add(checkbox);
+    checkbox->setBounds({ { 0.0f, 100.0f }, { 400.0f, 200.0f } });
+    const Vector2f checkboxInside = checkbox->getBounds().position + Vector2f(1.0f, 1.0f);
+    checkbox->handleInputEvent(Input::Event(Input::EventType::MouseMove, checkboxInside));
+    checkbox->handleInputEvent(Input::Event(Input::EventType::MouseRelease, 0, checkboxInside));
+    EXPECT_EQ(checkbox->getState(), Style::State::Checked | Style::State::Hover);
+    EXPECT_EQ(&checkbox->getCurrentStyle(), &checkbox->getCheckedHoverStyle());
+    checkbox->disable();
+    EXPECT_EQ(&checkbox->getCurrentStyle(), &checkbox->getCheckedDisabledStyle());
+}
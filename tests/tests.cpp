@@ -1,5 +1,12 @@
 #include "test.hpp"
 #include "math_test.hpp"
+#include "bitmap_test.hpp"
+#include "font_test.hpp"
+#include "style_test.hpp"
+#include "animation_test.hpp"
+#include "signal_test.hpp"
+#include "control_test.hpp"
+#include "threadPool_test.hpp"
 
 
 int main(int argc, char ** argv)
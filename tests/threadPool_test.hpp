@@ -0,0 +1,74 @@
+#include "test.hpp"
+#include "guise/utility/threadPool.hpp"
+#include <atomic>
+#include <vector>
+
+using namespace Guise;
+
+TEST(ThreadPool, ParallelFor)
+{
+    for (size_t workerCount = 0; workerCount < 4; workerCount += 3)
+    {
+        ThreadPool pool(workerCount);
+        EXPECT_EQ(pool.getWorkerCount(), workerCount);
+
+        // Every index is called exactly once, for any grain size.
+        for (size_t grainSize = 1; grainSize < 64; grainSize *= 7)
+        {
+            std::vector<std::atomic<int> > calls(1000);
+            pool.parallelFor(calls.size(), [&calls](const size_t index)
+            {
+                calls[index]++;
+            }, grainSize);
+
+            size_t called = 0;
+            for (auto & call : calls)
+            {
+                called += call == 1 ? 1 : 0;
+            }
+            EXPECT_EQ(called, calls.size());
+        }
+
+        // Waiting threads execute tasks, nested loops do not dead lock.
+        std::atomic<size_t> sum(0);
+        pool.parallelFor(16, [&pool, &sum](const size_t outer)
+        {
+            pool.parallelFor(16, [&sum, outer](const size_t inner)
+            {
+                sum += (outer * 16) + inner;
+            });
+        });
+        EXPECT_EQ(sum.load(), size_t(255 * 256 / 2));
+
+        size_t count = 0;
+        pool.parallelFor(0, [&count](const size_t) { count++; });
+        EXPECT_EQ(count, size_t(0));
+    }
+}
+
+TEST(ThreadPool, Push)
+{
+    std::atomic<int> count(0);
+    {
+        ThreadPool pool(2);
+        for (size_t i = 0; i < 100; i++)
+        {
+            pool.push([&count]()
+            {
+                count++;
+            });
+        }
+    }
+
+    // Pending tasks are executed before the pool is destroyed.
+    EXPECT_EQ(count.load(), 100);
+
+    {
+        ThreadPool pool(0);
+        pool.push([&count]()
+        {
+            count++;
+        });
+    }
+    EXPECT_EQ(count.load(), 101);
+}